@@ -0,0 +1,81 @@
+/**
+ * @file bench.h
+ * @brief Shared timing helpers for the benchmark programs.
+ */
+
+#ifndef UT_BENCH_H
+#define UT_BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* Result layouts; programs that call bench_begin() accept --json and --csv. */
+typedef enum {
+    BENCH_TEXT,
+    BENCH_JSON,
+    BENCH_CSV
+} bench_format_t;
+
+static bench_format_t bench_format = BENCH_TEXT;
+static int bench_results = 0;
+
+/* Returns a monotonic reading in nanoseconds. */
+static inline int64_t bench_clock_ns(void) {
+    struct timespec spec;
+    clock_gettime(CLOCK_MONOTONIC, &spec);
+    return (int64_t)spec.tv_sec * 1000000000LL + spec.tv_nsec;
+}
+
+/* Selects the layout from a --text/--json/--csv argument and prints the header. */
+static inline void bench_begin(int argc, char **argv, const char *suite) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            bench_format = BENCH_JSON;
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            bench_format = BENCH_CSV;
+        } else if (strcmp(argv[i], "--text") == 0) {
+            bench_format = BENCH_TEXT;
+        }
+    }
+
+    if (bench_format == BENCH_JSON) {
+        printf("{\n  \"suite\": \"%s\",\n  \"unix_time\": %lld,\n", suite, (long long)time(NULL));
+#if defined(__VERSION__)
+        printf("  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+        printf("  \"results\": [");
+    } else if (bench_format == BENCH_CSV) {
+        printf("name,ns_per_op,ops_per_sec,ops\n");
+    }
+}
+
+/* Prints one benchmark result in the selected layout. */
+static inline void bench_report(const char *name, int64_t elapsed_ns, int64_t ops) {
+    double ns_per_op = (double)elapsed_ns / (double)ops;
+    double ops_per_sec = ns_per_op > 0 ? 1e9 / ns_per_op : 0.0;
+
+    if (bench_format == BENCH_JSON) {
+        printf("%s\n    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"ops_per_sec\": %.0f, \"ops\": %lld}",
+               bench_results > 0 ? "," : "", name, ns_per_op, ops_per_sec, (long long)ops);
+    } else if (bench_format == BENCH_CSV) {
+        printf("%s,%.3f,%.0f,%lld\n", name, ns_per_op, ops_per_sec, (long long)ops);
+    } else {
+        printf("%-40s %10.2f ns/op %14.0f ops/sec\n", name, ns_per_op, ops_per_sec);
+    }
+    bench_results++;
+    fflush(stdout);
+}
+
+/* Closes the JSON document; a no-op for the other layouts. */
+static inline void bench_end(void) {
+    if (bench_format == BENCH_JSON) {
+        printf("\n  ]\n}\n");
+    }
+}
+
+/* Keeps the compiler from discarding a computed value. */
+static volatile int64_t bench_sink;
+
+#endif /* UT_BENCH_H */
@@ -0,0 +1,44 @@
+/**
+ * @file bench_clock.c
+ * @brief Compares the cost of ut_now_with() across clock sources, including
+ *        the shared-memory time page.
+ */
+
+#include "universal_timestamp.h"
+#include "bench.h"
+#include <stdio.h>
+#include <unistd.h>
+
+#define ITERATIONS 5000000
+
+/* Times one clock source over a tight loop of reads. */
+static void run(const char *name, ut_clock_source_t source) {
+    int64_t total = 0;
+    int64_t t0 = bench_clock_ns();
+    for (int64_t i = 0; i < ITERATIONS; i++) {
+        total += ut_now_with(source).nanos;
+    }
+    int64_t t1 = bench_clock_ns();
+    bench_sink = total;
+    bench_report(name, t1 - t0, ITERATIONS);
+}
+
+int main(void) {
+    ut_clock_info_t info;
+    ut_get_clock_info(UT_CLOCK_TSC, &info);
+    printf("tsc backend active: %s\n", info.effective == UT_CLOCK_TSC ? "yes" : "no");
+
+    run("now/precise", UT_CLOCK_PRECISE);
+    run("now/coarse", UT_CLOCK_COARSE);
+    run("now/tsc", UT_CLOCK_TSC);
+
+    char name[64];
+    snprintf(name, sizeof(name), "/uts-bench-clock-%ld", (long)getpid());
+    if (ut_shared_clock_init(name, UT_SHARED_PUBLISHER, UT_SHARED_DEFAULT_INTERVAL_NS) == UT_OK) {
+        run("now/shared", UT_CLOCK_SHARED);
+        ut_shared_clock_shutdown();
+    } else {
+        printf("shared clock unavailable\n");
+    }
+    return 0;
+}
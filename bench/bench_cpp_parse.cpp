@@ -0,0 +1,65 @@
+/**
+ * @file bench_cpp_parse.cpp
+ * @brief Compares throwing uts::Timestamp::parse() against the noexcept
+ *        try_parse() at several input error rates.
+ */
+
+#include "universal_timestamp.hpp"
+#include "bench.h"
+#include <string>
+#include <vector>
+
+static const int ITERATIONS = 2000000;
+static const int POOL = 1000;
+
+/* Builds a pool of inputs where roughly percent_bad out of every hundred are malformed. */
+static std::vector<std::string> make_inputs(int percent_bad) {
+    std::vector<std::string> inputs;
+    inputs.reserve(POOL);
+    for (int i = 0; i < POOL; i++) {
+        bool bad = (i * 37 % 100) < percent_bad;
+        inputs.push_back(bad ? "2024-12-14 03:13:21.123Z" : "2024-12-14T03:13:21.123Z");
+    }
+    return inputs;
+}
+
+/* Times the exception-based API. */
+static void run_throwing(const char* name, const std::vector<std::string>& inputs) {
+    int64_t total = 0;
+    int64_t t0 = bench_clock_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        try {
+            total += uts::Timestamp::parse(inputs[i % POOL]).nanos();
+        } catch (const uts::Error& e) {
+            total += e.code();
+        }
+    }
+    int64_t t1 = bench_clock_ns();
+    bench_sink = total;
+    bench_report(name, t1 - t0, ITERATIONS);
+}
+
+/* Times the result-returning API. */
+static void run_try(const char* name, const std::vector<std::string>& inputs) {
+    int64_t total = 0;
+    int64_t t0 = bench_clock_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        uts::ParseResult r = uts::Timestamp::try_parse(inputs[i % POOL]);
+        total += r ? r.value.nanos() : static_cast<int64_t>(r.error);
+    }
+    int64_t t1 = bench_clock_ns();
+    bench_sink = total;
+    bench_report(name, t1 - t0, ITERATIONS);
+}
+
+int main() {
+    const int rates[] = {0, 2, 10, 50};
+    for (int rate : rates) {
+        std::vector<std::string> inputs = make_inputs(rate);
+        std::string throwing = "parse/throwing " + std::to_string(rate) + "% bad";
+        std::string trying = "parse/try_parse " + std::to_string(rate) + "% bad";
+        run_throwing(throwing.c_str(), inputs);
+        run_try(trying.c_str(), inputs);
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file bench_format.c
+ * @brief Compares ut_format() against the previous snprintf-based formatter
+ *        and the thread-local day cache of ut_format_cached().
+ */
+
+#include "universal_timestamp.h"
+#include "core/ut_internal.h"
+#include "bench.h"
+#include <stdbool.h>
+
+#define ITERATIONS 5000000
+
+/* Formats a timestamp the way ut_format() did before the hand-rolled renderer. */
+static int snprintf_format(ut_timestamp_t ts, char *buf, size_t buf_size, bool include_nanos) {
+    int year, month, day, hour, minute, second, frac_nanos;
+    ut_internal_from_nanos(ts.nanos, &year, &month, &day,
+                           &hour, &minute, &second, &frac_nanos);
+
+    if (include_nanos && frac_nanos > 0) {
+        char frac_buf[10];
+        int frac_temp = frac_nanos;
+        for (int i = 8; i >= 0; i--) {
+            frac_buf[i] = (char)('0' + (frac_temp % 10));
+            frac_temp /= 10;
+        }
+        int digits = 9;
+        while (digits > 1 && frac_buf[digits - 1] == '0') {
+            digits--;
+        }
+        frac_buf[digits] = '\0';
+        return snprintf(buf, buf_size, "%04d-%02d-%02dT%02d:%02d:%02d.%sZ",
+                        year, month, day, hour, minute, second, frac_buf);
+    }
+    return snprintf(buf, buf_size, "%04d-%02d-%02dT%02d:%02d:%02dZ",
+                    year, month, day, hour, minute, second);
+}
+
+/* Times one formatter over a stream of advancing timestamps. */
+static void run(const char *name,
+                int (*fn)(ut_timestamp_t, char *, size_t, bool),
+                int64_t start, int64_t step, bool include_nanos) {
+    char buf[UT_MAX_STRING_LEN];
+    int64_t total = 0;
+    int64_t t0 = bench_clock_ns();
+    for (int64_t i = 0; i < ITERATIONS; i++) {
+        total += fn(ut_from_unix_nanos(start + i * step), buf, sizeof(buf), include_nanos);
+    }
+    int64_t t1 = bench_clock_ns();
+    bench_sink = total;
+    bench_report(name, t1 - t0, ITERATIONS);
+}
+
+int main(void) {
+    const int64_t start = 1734146001123456789LL;
+    const int64_t step = 7919;
+
+    run("format/snprintf (before)", snprintf_format, start, step, true);
+    run("format/ut_format (after)", ut_format, start, step, true);
+    run("format_no_nanos/snprintf (before)", snprintf_format, start, step, false);
+    run("format_no_nanos/ut_format (after)", ut_format, start, step, false);
+    run("format/ut_format_cached (same day)", ut_format_cached, start, step, true);
+    run("format/ut_format_cached (day per call)", ut_format_cached, start, 86400000000123LL, true);
+
+    ut_format_cache_stats_t stats;
+    ut_get_format_cache_stats(&stats);
+    printf("ut_format_cached hits=%llu misses=%llu\n",
+           (unsigned long long)stats.hits, (unsigned long long)stats.misses);
+    return 0;
+}
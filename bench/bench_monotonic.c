@@ -0,0 +1,77 @@
+/**
+ * @file bench_monotonic.c
+ * @brief Scales thread count against the global ut_now_monotonic() counter
+ *        and per-thread ut_monotonic_gen_t generators.
+ */
+
+#include "universal_timestamp.h"
+#include "bench.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define ITERATIONS_PER_THREAD 1000000
+
+typedef struct {
+    int use_generator;
+    int64_t sink;
+} worker_t;
+
+/* Mints timestamps from either the shared counter or a thread-owned generator. */
+static void *worker_main(void *arg) {
+    worker_t *w = (worker_t *)arg;
+    int64_t total = 0;
+
+    if (w->use_generator) {
+        ut_monotonic_gen_t *gen;
+        ut_monotonic_gen_create(0, 0, &gen);
+        for (int i = 0; i < ITERATIONS_PER_THREAD; i++) {
+            total += ut_monotonic_gen_next(gen).nanos;
+        }
+        ut_monotonic_gen_destroy(gen);
+    } else {
+        for (int i = 0; i < ITERATIONS_PER_THREAD; i++) {
+            total += ut_now_monotonic().nanos;
+        }
+    }
+
+    w->sink = total;
+    return NULL;
+}
+
+/* Runs one configuration and reports the aggregate cost per timestamp. */
+static void run(const char *label, int threads, int use_generator) {
+    pthread_t *ids = (pthread_t *)malloc(sizeof(pthread_t) * (size_t)threads);
+    worker_t *workers = (worker_t *)calloc((size_t)threads, sizeof(worker_t));
+
+    int64_t t0 = bench_clock_ns();
+    for (int i = 0; i < threads; i++) {
+        workers[i].use_generator = use_generator;
+        pthread_create(&ids[i], NULL, worker_main, &workers[i]);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+        bench_sink += workers[i].sink;
+    }
+    int64_t t1 = bench_clock_ns();
+
+    char name[64];
+    snprintf(name, sizeof(name), "%s/%d-threads", label, threads);
+    bench_report(name, t1 - t0, (int64_t)threads * ITERATIONS_PER_THREAD);
+
+    free(workers);
+    free(ids);
+}
+
+int main(int argc, char **argv) {
+    long max_threads = argc > 1 ? strtol(argv[1], NULL, 10) : sysconf(_SC_NPROCESSORS_ONLN);
+    if (max_threads < 1) {
+        max_threads = 1;
+    }
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        run("monotonic/global", threads, 0);
+        run("monotonic/per-thread-gen", threads, 1);
+    }
+    return 0;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file bench_parse.c
+ * @brief Compares the accelerated strict parser against the scalar reference.
+ */
+
+#include "universal_timestamp.h"
+#include "core/ut_internal.h"
+#include "bench.h"
+#include <string.h>
+
+#define ITERATIONS 5000000
+
+/* Strict-parses with the scalar reference path only. */
+static ut_error_t scalar_strict(const char *str, ut_timestamp_t *out) {
+    return ut_internal_parse_scalar(str, strlen(str), out, true);
+}
+
+/* Times one parser over a fixed input string. */
+static void run(const char *name, ut_error_t (*fn)(const char *, ut_timestamp_t *), const char *input) {
+    ut_timestamp_t ts;
+    int64_t total = 0;
+    int64_t t0 = bench_clock_ns();
+    for (int64_t i = 0; i < ITERATIONS; i++) {
+        fn(input, &ts);
+        total += ts.nanos;
+    }
+    int64_t t1 = bench_clock_ns();
+    bench_sink = total;
+    bench_report(name, t1 - t0, ITERATIONS);
+}
+
+int main(void) {
+    run("parse_strict/scalar", scalar_strict, "2024-12-14T03:13:21.123456789Z");
+    run("parse_strict/accelerated", ut_parse_strict, "2024-12-14T03:13:21.123456789Z");
+    run("parse_strict_no_frac/scalar", scalar_strict, "2024-12-14T03:13:21Z");
+    run("parse_strict_no_frac/accelerated", ut_parse_strict, "2024-12-14T03:13:21Z");
+    return 0;
+}
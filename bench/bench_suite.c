@@ -0,0 +1,244 @@
+/**
+ * @file bench_suite.c
+ * @brief Regression benchmark covering the clock, render, parse and calendar
+ *        entry points, with JSON or CSV output for tracking results over time.
+ */
+
+#include "universal_timestamp.h"
+#include "bench.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define ITERATIONS 2000000
+#define INPUTS 1024
+#define INPUT_MASK (INPUTS - 1)
+
+/* Distinct inputs spread over one year, with their strict and lenient strings. */
+static int64_t g_nanos[INPUTS];
+static char g_strict[INPUTS][UT_MAX_STRING_LEN];
+static char g_lenient[INPUTS][UT_MAX_STRING_LEN + 6];
+
+/* Fills the inputs from base; a nonzero year rewrites the strings' year field. */
+static void prepare(int64_t base, int year) {
+    const int64_t span = 365LL * 86400 * 1000000000LL / INPUTS;
+
+    for (int i = 0; i < INPUTS; i++) {
+        g_nanos[i] = base + (int64_t)i * span + (int64_t)i * 7919;
+        ut_format(ut_from_unix_nanos(g_nanos[i]), g_strict[i], sizeof(g_strict[i]), true);
+
+        size_t len = strlen(g_strict[i]);
+        memcpy(g_lenient[i], g_strict[i], len - 1);
+        memcpy(g_lenient[i] + len - 1, "+00:00", 7);
+        if (year > 0) {
+            char digits[12];
+            snprintf(digits, sizeof(digits), "%04d", year);
+            memcpy(g_strict[i], digits, 4);
+            memcpy(g_lenient[i], digits, 4);
+        }
+    }
+}
+
+/* Times ut_format() over the prepared inputs. */
+static void run_format(const char *name, bool include_nanos) {
+    char buf[UT_MAX_STRING_LEN];
+    int64_t total = 0;
+    int64_t t0 = bench_clock_ns();
+    for (int64_t i = 0; i < ITERATIONS; i++) {
+        total += ut_format(ut_from_unix_nanos(g_nanos[i & INPUT_MASK]), buf, sizeof(buf), include_nanos);
+    }
+    int64_t t1 = bench_clock_ns();
+    bench_sink = total;
+    bench_report(name, t1 - t0, ITERATIONS);
+}
+
+/* Times a parser over one of the prepared string tables. */
+static void run_parse(const char *name, ut_error_t (*fn)(const char *, ut_timestamp_t *),
+                      const char *inputs, size_t stride) {
+    ut_timestamp_t ts;
+    int64_t total = 0;
+    int64_t t0 = bench_clock_ns();
+    for (int64_t i = 0; i < ITERATIONS; i++) {
+        const char *str = inputs + (size_t)(i & INPUT_MASK) * stride;
+        total += fn(str, &ts) + ts.nanos;
+    }
+    int64_t t1 = bench_clock_ns();
+    bench_sink = total;
+    bench_report(name, t1 - t0, ITERATIONS);
+}
+
+/* ut_parse_flexible() with every form enabled, in the run_parse() signature. */
+static ut_error_t parse_flexible_all(const char *str, ut_timestamp_t *out) {
+    return ut_parse_flexible(str, strlen(str), UT_FLEX_ALL, out, NULL);
+}
+
+/* Times ut_to_iso_week() over the prepared inputs. */
+static void run_iso_week(const char *name) {
+    int year, week, day;
+    int64_t total = 0;
+    int64_t t0 = bench_clock_ns();
+    for (int64_t i = 0; i < ITERATIONS; i++) {
+        ut_to_iso_week(ut_from_unix_nanos(g_nanos[i & INPUT_MASK]), &year, &week, &day);
+        total += year + week + day;
+    }
+    int64_t t1 = bench_clock_ns();
+    bench_sink = total;
+    bench_report(name, t1 - t0, ITERATIONS);
+}
+
+/* Times ut_to_japanese_era() over the prepared inputs. */
+static void run_japanese_era(const char *name) {
+    ut_japanese_era_t era;
+    int year;
+    int64_t total = 0;
+    int64_t t0 = bench_clock_ns();
+    for (int64_t i = 0; i < ITERATIONS; i++) {
+        total += ut_to_japanese_era(ut_from_unix_nanos(g_nanos[i & INPUT_MASK]), &era, &year);
+        total += (int64_t)era + year;
+    }
+    int64_t t1 = bench_clock_ns();
+    bench_sink = total;
+    bench_report(name, t1 - t0, ITERATIONS);
+}
+
+/* Times one of the clock reads. */
+static void run_clock(const char *name, ut_timestamp_t (*fn)(void)) {
+    int64_t total = 0;
+    int64_t t0 = bench_clock_ns();
+    for (int64_t i = 0; i < ITERATIONS; i++) {
+        total += fn().nanos;
+    }
+    int64_t t1 = bench_clock_ns();
+    bench_sink = total;
+    bench_report(name, t1 - t0, ITERATIONS);
+}
+
+/* Times ut_encode_column() and ut_decode_column() on a sorted series with the given mean step. */
+static void run_column(const char *label, int64_t step) {
+    static ut_timestamp_t series[INPUTS];
+    static ut_timestamp_t decoded[INPUTS];
+    static uint8_t wire[UT_COLUMN_MAX_ENCODED_LEN(INPUTS)];
+    const int64_t rounds = ITERATIONS / INPUTS;
+    size_t len = 0, n = 0;
+    char name[64];
+
+    int64_t t = 1704067200000000000LL;
+    for (int i = 0; i < INPUTS; i++) {
+        t += step + (int64_t)((i * 7919) % 1000) * (step / 1000);
+        series[i].nanos = t;
+    }
+
+    int64_t t0 = bench_clock_ns();
+    for (int64_t r = 0; r < rounds; r++) {
+        ut_encode_column(series, INPUTS, wire, sizeof(wire), &len);
+    }
+    int64_t t1 = bench_clock_ns();
+    snprintf(name, sizeof(name), "column_encode/%s", label);
+    bench_report(name, t1 - t0, rounds * INPUTS);
+
+    t0 = bench_clock_ns();
+    for (int64_t r = 0; r < rounds; r++) {
+        ut_decode_column(wire, len, decoded, INPUTS, &n);
+        bench_sink += decoded[r & INPUT_MASK].nanos;
+    }
+    t1 = bench_clock_ns();
+    snprintf(name, sizeof(name), "column_decode/%s", label);
+    bench_report(name, t1 - t0, rounds * INPUTS);
+}
+
+/* Calls ut_now_monotonic() from one of several contending threads. */
+static void *monotonic_worker(void *arg) {
+    int64_t total = 0;
+    for (int i = 0; i < ITERATIONS / 4; i++) {
+        total += ut_now_monotonic().nanos;
+    }
+    *(int64_t *)arg = total;
+    return NULL;
+}
+
+/* Reports the aggregate cost per ut_now_monotonic() call across threads. */
+static void run_monotonic_contended(int threads) {
+    pthread_t ids[64];
+    int64_t sinks[64];
+
+    int64_t t0 = bench_clock_ns();
+    for (int i = 0; i < threads; i++) {
+        pthread_create(&ids[i], NULL, monotonic_worker, &sinks[i]);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+        bench_sink += sinks[i];
+    }
+    int64_t t1 = bench_clock_ns();
+
+    char name[64];
+    snprintf(name, sizeof(name), "now_monotonic/%d-threads", threads);
+    bench_report(name, t1 - t0, (int64_t)threads * (ITERATIONS / 4));
+}
+
+int main(int argc, char **argv) {
+    long max_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0) {
+            max_threads = strtol(argv[i + 1], NULL, 10);
+        }
+    }
+    if (max_threads < 2) {
+        max_threads = 2;
+    }
+    if (max_threads > 64) {
+        max_threads = 64;
+    }
+
+    bench_begin(argc, argv, "bench_suite");
+
+    run_clock("now", ut_now);
+    run_clock("now_monotonic", ut_now_monotonic);
+    for (int threads = 2; threads <= max_threads; threads *= 2) {
+        run_monotonic_contended(threads);
+    }
+
+    /* Parsing runs on strings up to year 9999; the others stop at the int64 nanosecond limit. */
+    static const struct {
+        const char *label;
+        int64_t base;
+        int year;
+        bool calendar;
+    } ranges[] = {
+        {"1970", 0, 0, true},
+        {"2024", 1704067200000000000LL, 0, true},
+        {"2262", INT64_MAX - 366LL * 86400 * 1000000000LL, 0, true},
+        {"9999", 1672531200000000000LL, 9999, false},
+    };
+
+    for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++) {
+        char name[64];
+        prepare(ranges[r].base, ranges[r].year);
+
+        if (ranges[r].calendar) {
+            snprintf(name, sizeof(name), "format/nanos/%s", ranges[r].label);
+            run_format(name, true);
+            snprintf(name, sizeof(name), "format/no_nanos/%s", ranges[r].label);
+            run_format(name, false);
+        }
+        snprintf(name, sizeof(name), "parse_strict/%s", ranges[r].label);
+        run_parse(name, ut_parse_strict, g_strict[0], sizeof(g_strict[0]));
+        snprintf(name, sizeof(name), "parse_lenient/%s", ranges[r].label);
+        run_parse(name, ut_parse_lenient, g_lenient[0], sizeof(g_lenient[0]));
+        snprintf(name, sizeof(name), "parse_flexible/%s", ranges[r].label);
+        run_parse(name, parse_flexible_all, g_lenient[0], sizeof(g_lenient[0]));
+        if (ranges[r].calendar) {
+            snprintf(name, sizeof(name), "iso_week/%s", ranges[r].label);
+            run_iso_week(name);
+            snprintf(name, sizeof(name), "japanese_era/%s", ranges[r].label);
+            run_japanese_era(name);
+        }
+    }
+
+    run_column("1us", 1000);
+    run_column("1ms", 1000000);
+    run_column("1s", 1000000000);
+
+    bench_end();
+    return 0;
+}
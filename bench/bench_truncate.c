@@ -0,0 +1,77 @@
+/**
+ * @file bench_truncate.c
+ * @brief Compares per-row ut_truncate()/ut_to_iso_week() calls against the
+ *        ut_truncate_batch() and ut_iso_week_batch() kernels.
+ */
+
+#include "universal_timestamp.h"
+#include "bench.h"
+#include <stdlib.h>
+
+#define ROWS 1000000
+#define ROUNDS 10
+
+static ut_timestamp_t g_in[ROWS];
+static ut_timestamp_t g_out[ROWS];
+static int g_years[ROWS];
+static int g_weeks[ROWS];
+static int g_days[ROWS];
+
+/* Times ROUNDS passes of scalar ut_truncate() over the input. */
+static void run_scalar(const char *name, ut_unit_t unit) {
+    int64_t t0 = bench_clock_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (size_t i = 0; i < ROWS; i++) {
+            g_out[i] = ut_truncate(g_in[i], unit);
+        }
+    }
+    int64_t t1 = bench_clock_ns();
+    bench_sink = g_out[ROWS / 2].nanos;
+    bench_report(name, t1 - t0, (int64_t)ROWS * ROUNDS);
+}
+
+/* Times ROUNDS passes of ut_truncate_batch() over the input. */
+static void run_batch(const char *name, ut_unit_t unit) {
+    int64_t t0 = bench_clock_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        ut_truncate_batch(g_in, ROWS, unit, g_out);
+    }
+    int64_t t1 = bench_clock_ns();
+    bench_sink = g_out[ROWS / 2].nanos;
+    bench_report(name, t1 - t0, (int64_t)ROWS * ROUNDS);
+}
+
+int main(void) {
+    int64_t value = 1734146001123456789LL;
+    for (size_t i = 0; i < ROWS; i++) {
+        value += rand() % 100000000;
+        g_in[i] = ut_from_unix_nanos(value);
+    }
+
+    run_scalar("truncate/minute ut_truncate", UT_UNIT_MINUTE);
+    run_batch("truncate/minute ut_truncate_batch", UT_UNIT_MINUTE);
+    run_scalar("truncate/day ut_truncate", UT_UNIT_DAY);
+    run_batch("truncate/day ut_truncate_batch", UT_UNIT_DAY);
+    run_scalar("truncate/week ut_truncate", UT_UNIT_WEEK);
+    run_batch("truncate/week ut_truncate_batch", UT_UNIT_WEEK);
+    run_scalar("truncate/month ut_truncate", UT_UNIT_MONTH);
+    run_batch("truncate/month ut_truncate_batch", UT_UNIT_MONTH);
+
+    int64_t t0 = bench_clock_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (size_t i = 0; i < ROWS; i++) {
+            ut_to_iso_week(g_in[i], &g_years[i], &g_weeks[i], &g_days[i]);
+        }
+    }
+    int64_t t1 = bench_clock_ns();
+    bench_report("iso_week/ut_to_iso_week", t1 - t0, (int64_t)ROWS * ROUNDS);
+
+    t0 = bench_clock_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        ut_iso_week_batch(g_in, ROWS, g_years, g_weeks, g_days);
+    }
+    t1 = bench_clock_ns();
+    bench_sink = g_weeks[ROWS / 2];
+    bench_report("iso_week/ut_iso_week_batch", t1 - t0, (int64_t)ROWS * ROUNDS);
+    return 0;
+}
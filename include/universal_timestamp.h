@@ -21,6 +21,32 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+/**
+ * @brief Visibility marker for the public API.
+ *
+ * The shared library is compiled with -fvisibility=hidden (and, on Windows,
+ * with UT_BUILD_SHARED), so only declarations carrying UT_API are exported;
+ * the ut_internal_* helpers stay private and bind without PLT indirection.
+ */
+
+#if defined(_WIN32) && defined(UT_BUILD_SHARED)
+    #define UT_API __declspec(dllexport)
+#elif defined(__GNUC__) || defined(__clang__)
+    #define UT_API __attribute__((visibility("default")))
+#else
+    #define UT_API
+#endif
+
+/**
+ * @brief Define UT_INLINE_ACCESSORS before including this header to get
+ * ut_from_unix_nanos(), ut_to_unix_nanos() and ut_get_calendar() as static
+ * inline functions instead of calls into the library.
+ *
+ * The library itself always exports the out-of-line versions, so objects
+ * built with and without this macro link against the same archive or
+ * shared library.
+ */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -46,7 +72,10 @@ typedef enum {
     UT_ERR_UNSUPPORTED_OFFSET,    /**< Non-zero timezone offset in strict mode */
     UT_ERR_FRACTION_TOO_LONG,     /**< More than 9 fractional digits */
     UT_ERR_LEAP_SECOND,           /**< Leap second (SS=60) not supported */
-    UT_ERR_NULL_POINTER           /**< Null pointer argument */
+    UT_ERR_NULL_POINTER,          /**< Null pointer argument */
+    UT_ERR_BUFFER_TOO_SMALL,      /**< Output buffer cannot hold the result */
+    UT_ERR_OUT_OF_MEMORY,         /**< Memory allocation failed */
+    UT_ERR_UNAVAILABLE            /**< Operating-system resource could not be created or opened */
 } ut_error_t;
 
 /**
@@ -77,6 +106,12 @@ typedef enum {
     UT_ERA_MEIJI                  /**< Meiji era (1868-01-25 to 1912-07-29) */
 } ut_japanese_era_t;
 
+/**
+ * @brief Maximum number of Japanese eras, built-in plus registered.
+ */
+
+#define UT_JAPANESE_ERA_CAPACITY 16
+
 /**
  * @brief Clock precision levels detected at runtime.
  *
@@ -91,6 +126,56 @@ typedef enum {
     UT_PRECISION_ERROR = -1       /**< Unable to determine precision */
 } ut_precision_t;
 
+/**
+ * @brief Clock sources selectable with ut_now_with().
+ *
+ * Sources trade precision for cost per call. A source that is not
+ * available on the running platform falls back to UT_CLOCK_PRECISE;
+ * ut_get_clock_info() reports which source is actually read.
+ */
+
+typedef enum {
+    UT_CLOCK_PRECISE = 0,         /**< Full-precision wall clock (the ut_now() default) */
+    UT_CLOCK_COARSE,              /**< Scheduler-tick wall clock: cheapest, millisecond-level resolution */
+    UT_CLOCK_TSC,                 /**< CPU timestamp counter anchored to the wall clock */
+    UT_CLOCK_SHARED               /**< Time page published by ut_shared_clock_init() */
+} ut_clock_source_t;
+
+/**
+ * @brief Role of a process attached with ut_shared_clock_init().
+ */
+
+typedef enum {
+    UT_SHARED_READER = 0,         /**< Map an existing segment; read its time page and counter */
+    UT_SHARED_PUBLISHER           /**< Create or take over the segment and keep its time page current */
+} ut_shared_role_t;
+
+/**
+ * @brief Segment name used by ut_shared_clock_init() when name is NULL.
+ */
+
+#define UT_SHARED_DEFAULT_NAME "/universal_timestamp"
+
+/**
+ * @brief Suggested publisher period for ut_shared_clock_init(), in nanoseconds.
+ */
+
+#define UT_SHARED_DEFAULT_INTERVAL_NS 100000
+
+/**
+ * @brief Measured characteristics of a clock source.
+ */
+
+typedef struct {
+    ut_clock_source_t source;     /**< Source that was queried */
+    ut_clock_source_t effective;  /**< Source actually read after any fallback */
+    int64_t resolution_ns;        /**< Nominal tick in nanoseconds (0 if unknown) */
+    double cost_ns;               /**< Measured average cost of one reading in nanoseconds */
+    ut_precision_t precision;     /**< Digit granularity inferred from distinct sampled readings */
+    int64_t step_ns;              /**< Smallest forward step between distinct readings (0 if none seen) */
+    uint32_t regressions;         /**< Backward steps seen while probing; non-zero means not monotonic */
+} ut_clock_info_t;
+
 /**
  * @brief Timestamp structure storing nanoseconds since Unix epoch.
  *
@@ -103,6 +188,132 @@ typedef struct {
     int64_t nanos;  /**< Nanoseconds since Unix epoch (1970-01-01T00:00:00Z) */
 } ut_timestamp_t;
 
+/**
+ * @brief Signed span of time in nanoseconds.
+ *
+ * Kept distinct from ut_timestamp_t so that instants and intervals
+ * cannot be mixed up; the range is the same (about ±292 years).
+ */
+
+typedef struct {
+    int64_t nanos;  /**< Length of the span in nanoseconds */
+} ut_duration_t;
+
+/**
+ * @brief Time units for durations and truncation.
+ *
+ * UT_UNIT_MONTH and UT_UNIT_YEAR are calendar units with no fixed
+ * length: they are accepted by the truncation functions only, and
+ * ut_duration_from() / ut_duration_to() return zero for them.
+ */
+
+typedef enum {
+    UT_UNIT_NANOSECOND = 0,       /**< 1 ns */
+    UT_UNIT_MICROSECOND,          /**< 1,000 ns */
+    UT_UNIT_MILLISECOND,          /**< 1,000,000 ns */
+    UT_UNIT_SECOND,               /**< 10^9 ns */
+    UT_UNIT_MINUTE,               /**< 60 s */
+    UT_UNIT_HOUR,                 /**< 3,600 s */
+    UT_UNIT_DAY,                  /**< 86,400 s (UTC has no leap seconds here) */
+    UT_UNIT_WEEK,                 /**< 7 days; truncation aligns to ISO Monday */
+    UT_UNIT_MONTH,                /**< Calendar month (truncation only) */
+    UT_UNIT_YEAR                  /**< Calendar year (truncation only) */
+} ut_unit_t;
+
+/**
+ * @brief Extra input forms accepted by ut_parse_flexible(); combine with |.
+ */
+
+typedef enum {
+    UT_FLEX_OFFSETS = 1 << 0,     /**< Apply non-zero UTC offsets instead of rejecting them */
+    UT_FLEX_SPACE   = 1 << 1,     /**< Accept ' ' or 't' between date and time, and ' ' before the zone */
+    UT_FLEX_BASIC   = 1 << 2,     /**< Accept ISO-8601 basic format, e.g. 20241214T120000Z */
+    UT_FLEX_EPOCH   = 1 << 3,     /**< Accept a decimal Unix epoch, unit chosen by digit count */
+    UT_FLEX_ALL     = 0xF         /**< Every form above */
+} ut_flex_flags_t;
+
+/**
+ * @brief Input form recognized by ut_parse_flexible().
+ */
+
+typedef enum {
+    UT_FORM_EXTENDED = 0,         /**< YYYY-MM-DDTHH:MM:SS (RFC 3339 / ISO-8601 extended) */
+    UT_FORM_BASIC,                /**< YYYYMMDDTHHMMSS (ISO-8601 basic) */
+    UT_FORM_EPOCH_SECONDS,        /**< Epoch seconds: up to 11 integer digits */
+    UT_FORM_EPOCH_MILLIS,         /**< Epoch milliseconds: 12 to 14 integer digits */
+    UT_FORM_EPOCH_MICROS,         /**< Epoch microseconds: 15 to 17 integer digits */
+    UT_FORM_EPOCH_NANOS           /**< Epoch nanoseconds: 18 or 19 integer digits */
+} ut_parse_form_t;
+
+/**
+ * @brief What ut_parse_flexible() found in its input.
+ */
+
+typedef struct {
+    ut_parse_form_t form;         /**< Layout that matched */
+    int32_t offset_seconds;       /**< Offset removed to reach UTC (local minus UTC); 0 for Z and epochs */
+    bool zoned;                   /**< false if the input had no Z or offset and UTC was assumed */
+} ut_parse_info_t;
+
+/**
+ * @brief Hit and miss counters for ut_format_cached().
+ */
+
+typedef struct {
+    uint64_t hits;    /**< Calls that reused the thread's cached date prefix */
+    uint64_t misses;  /**< Calls that had to recompute the calendar date */
+} ut_format_cache_stats_t;
+
+/**
+ * @brief Number of ut_stats_t::parse_results slots, one per ut_error_t value.
+ */
+
+#define UT_STATS_RESULT_COUNT (UT_ERR_UNAVAILABLE + 1)
+
+/**
+ * @brief Library-wide counters collected when built with UT_ENABLE_STATS.
+ */
+
+typedef struct {
+    uint64_t monotonic_calls;       /**< Monotonic reservations: ut_now_monotonic(), _n() and generators */
+    uint64_t monotonic_bumps;       /**< Reservations that found the clock behind and advanced the last value */
+    uint64_t monotonic_cas_retries; /**< Failed compare-and-swap attempts on a shared monotonic counter */
+    uint64_t shared_fallbacks;      /**< Shared time page reads that stayed mid-update and used the precise clock */
+    uint64_t parse_results[UT_STATS_RESULT_COUNT]; /**< Parse attempts by result, indexed by ut_error_t */
+    ut_clock_source_t clock_source; /**< Source selected with ut_set_clock_source() */
+    ut_clock_source_t clock_effective; /**< Source actually read after any fallback */
+    double clock_cost_ns;           /**< Measured cost of one reading of the selected source */
+} ut_stats_t;
+
+/**
+ * @brief Version written to, and accepted from, the binary column header.
+ */
+
+#define UT_COLUMN_VERSION 1
+
+/**
+ * @brief Bytes in the column header ("UT", version, flags).
+ */
+
+#define UT_COLUMN_HEADER_LEN 4
+
+/**
+ * @brief Worst-case encoded size of a column of n timestamps.
+ */
+
+#define UT_COLUMN_MAX_ENCODED_LEN(n) (UT_COLUMN_HEADER_LEN + (size_t)(n) * 10)
+
+/**
+ * @brief Incremental column encoder state.
+ *
+ * Initialize with ut_column_encoder_init(); the fields are private.
+ */
+
+typedef struct {
+    int64_t prev;   /**< Last value encoded */
+    bool started;   /**< Header already written */
+} ut_column_encoder_t;
+
 /**
  * @brief Callback type for clock regression detection.
  *
@@ -120,6 +331,48 @@ typedef void (*ut_regression_callback_t)(
     ut_timestamp_t adjusted
 );
 
+/**
+ * @brief One clock regression, as queued by UT_REGRESSION_QUEUE and UT_REGRESSION_ASYNC.
+ */
+
+typedef struct {
+    ut_timestamp_t expected;      /**< The expected minimum timestamp */
+    ut_timestamp_t actual;        /**< The actual clock reading */
+    ut_timestamp_t adjusted;      /**< The timestamp that was returned instead */
+} ut_regression_event_t;
+
+/**
+ * @brief How clock regressions reach the application.
+ */
+
+typedef enum {
+    UT_REGRESSION_SYNC = 0,       /**< Call the callback on the thread that saw the regression (default) */
+    UT_REGRESSION_QUEUE,          /**< Queue events for ut_drain_regression_events() */
+    UT_REGRESSION_ASYNC           /**< Queue events and call the callback from a background thread */
+} ut_regression_delivery_t;
+
+/**
+ * @brief Events the regression queue holds before new ones are dropped.
+ */
+
+#define UT_REGRESSION_QUEUE_CAPACITY 1024
+
+/**
+ * @brief Largest number of low-order bits a generator can reserve for its shard ID.
+ */
+
+#define UT_MONOTONIC_MAX_SHARD_BITS 20
+
+/**
+ * @brief Opaque monotonic timestamp generator.
+ *
+ * Each generator keeps its own last-issued value on a separate cache
+ * line, so generators owned by different threads or cores never contend.
+ * Create one with ut_monotonic_gen_create().
+ */
+
+typedef struct ut_monotonic_gen ut_monotonic_gen_t;
+
 /**
  * @brief Get the current UTC timestamp.
  *
@@ -137,7 +390,43 @@ typedef void (*ut_regression_callback_t)(
  * @endcode
  */
 
-ut_timestamp_t ut_now(void);
+UT_API ut_timestamp_t ut_now(void);
+
+/**
+ * @brief Get the current UTC timestamp from a specific clock source.
+ *
+ * UT_CLOCK_PRECISE behaves exactly like ut_now(). UT_CLOCK_COARSE reads
+ * the cheapest wall clock the platform offers, which only advances once
+ * per scheduler tick (typically 1-16 ms):
+ * - Linux/Android: CLOCK_REALTIME_COARSE
+ * - FreeBSD/DragonFly: CLOCK_REALTIME_FAST
+ * - Windows: GetSystemTimeAsFileTime()
+ *
+ * Where no such clock exists (Apple, whose only cheaper clocks are
+ * monotonic, and other platforms without one), UT_CLOCK_COARSE falls back
+ * to UT_CLOCK_PRECISE and ut_get_clock_info() reports it as effective.
+ *
+ * UT_CLOCK_TSC reads the invariant TSC (x86) or CNTVCT (ARM64) counter,
+ * converted to wall-clock time by a fixed-point multiply-shift against an
+ * anchor taken from CLOCK_REALTIME. The counter is calibrated on first
+ * use (about 5 ms) and re-anchored once per second so it follows NTP
+ * slew. When the counter is not invariant or not present, UT_CLOCK_TSC
+ * falls back to UT_CLOCK_PRECISE.
+ *
+ * UT_CLOCK_SHARED returns the time last published to the segment
+ * attached with ut_shared_clock_init(): a seqlock read of shared memory
+ * with no system call, at the publisher's update period. Without an
+ * attached segment it falls back to UT_CLOCK_PRECISE.
+ *
+ * @param source Clock source to read.
+ * @return Current UTC timestamp.
+ *
+ * @code
+ * ut_timestamp_t tag = ut_now_with(UT_CLOCK_COARSE);
+ * @endcode
+ */
+
+UT_API ut_timestamp_t ut_now_with(ut_clock_source_t source);
 
 /**
  * @brief Get the current UTC timestamp with monotonic guarantee.
@@ -147,7 +436,9 @@ ut_timestamp_t ut_now(void);
  * clock moves backwards, the timestamp is synthesized by incrementing
  * the last known timestamp by 1 nanosecond.
  *
- * Thread-safe: Uses atomic operations for the internal counter.
+ * Thread-safe: Uses atomic operations for the internal counter. All
+ * callers share one counter; under heavy multi-threaded use prefer one
+ * ut_monotonic_gen_t per thread.
  *
  * @return Monotonically increasing UTC timestamp.
  *
@@ -160,7 +451,30 @@ ut_timestamp_t ut_now(void);
  * @endcode
  */
 
-ut_timestamp_t ut_now_monotonic(void);
+UT_API ut_timestamp_t ut_now_monotonic(void);
+
+/**
+ * @brief Reserve n consecutive monotonic timestamps with one atomic update.
+ *
+ * Fills out with n values t, t+1, ..., t+n-1 where t is greater than any
+ * value previously returned by ut_now_monotonic() or ut_now_monotonic_n(),
+ * and the whole range is reserved with a single compare-and-swap on the
+ * shared counter. The regression callback fires at most once per call.
+ *
+ * Because the range is consecutive nanoseconds, a large n reserves
+ * values slightly ahead of the wall clock; later calls continue after it.
+ *
+ * @param out    Array receiving n timestamps.
+ * @param n      Number of timestamps to reserve (0 is a no-op).
+ * @return UT_OK on success, UT_ERR_NULL_POINTER if out is NULL and n > 0.
+ *
+ * @code
+ * ut_timestamp_t ids[1000];
+ * ut_now_monotonic_n(ids, 1000);
+ * @endcode
+ */
+
+UT_API ut_error_t ut_now_monotonic_n(ut_timestamp_t *out, size_t n);
 
 /**
  * @brief Set a callback for clock regression events.
@@ -178,7 +492,119 @@ ut_timestamp_t ut_now_monotonic(void);
  * @endcode
  */
 
-void ut_set_regression_callback(ut_regression_callback_t callback);
+UT_API void ut_set_regression_callback(ut_regression_callback_t callback);
+
+/**
+ * @brief Choose how clock regressions are delivered.
+ *
+ * UT_REGRESSION_SYNC (the default) calls the callback from inside
+ * ut_now_monotonic() and the other monotonic sources, so a slow callback
+ * delays the timestamp. The other modes only push an event onto a
+ * lock-free queue of UT_REGRESSION_QUEUE_CAPACITY entries shared by all
+ * threads; when it is full the event is dropped and counted by
+ * ut_get_regression_overflow(). With UT_REGRESSION_QUEUE the application
+ * drains it with ut_drain_regression_events(). With UT_REGRESSION_ASYNC a
+ * library thread drains it every interval_ns (0 selects 1 ms) and calls
+ * the callback there. Leaving UT_REGRESSION_ASYNC stops the thread after
+ * delivering what is queued.
+ *
+ * Not thread-safe with respect to itself; call at start-up.
+ *
+ * @param mode         Delivery mode.
+ * @param interval_ns  Drain period for UT_REGRESSION_ASYNC; ignored otherwise.
+ * @return UT_OK, UT_ERR_OUT_OF_RANGE for an unknown mode or negative
+ *         interval, or UT_ERR_UNAVAILABLE if the thread cannot be started.
+ *
+ * @code
+ * ut_set_regression_callback(log_and_count);
+ * ut_set_regression_delivery(UT_REGRESSION_ASYNC, 0);
+ * @endcode
+ */
+
+UT_API ut_error_t ut_set_regression_delivery(ut_regression_delivery_t mode, int64_t interval_ns);
+
+/**
+ * @brief Remove queued clock regressions, oldest first.
+ *
+ * Never blocks: if another thread (including the UT_REGRESSION_ASYNC
+ * thread) is draining, returns 0 at once.
+ *
+ * @param out       Array receiving the events.
+ * @param capacity  Number of elements out can hold.
+ * @return Number of events stored in out.
+ *
+ * @code
+ * ut_regression_event_t events[64];
+ * size_t n;
+ * while ((n = ut_drain_regression_events(events, 64)) > 0) {
+ *     record(events, n);
+ * }
+ * @endcode
+ */
+
+UT_API size_t ut_drain_regression_events(ut_regression_event_t *out, size_t capacity);
+
+/**
+ * @brief Count regressions dropped because the queue was full.
+ *
+ * @return Events dropped since the process started.
+ */
+
+UT_API uint64_t ut_get_regression_overflow(void);
+
+/**
+ * @brief Create a monotonic timestamp generator for one shard.
+ *
+ * With shard_bits == 0 the generator returns strictly increasing
+ * timestamps, like ut_now_monotonic() but scoped to the generator.
+ * Give each thread (or core) its own generator to avoid contention.
+ *
+ * With shard_bits > 0 the low shard_bits bits of every timestamp are
+ * replaced by shard_id and the generator advances in steps of
+ * 2^shard_bits nanoseconds. Values are then strictly increasing within
+ * the shard and unique across all generators with distinct shard IDs
+ * and the same shard_bits, at the cost of that much timestamp precision.
+ *
+ * A single generator may be shared between threads; only its own
+ * counter is contended. Clock regressions fire the callback installed
+ * with ut_set_regression_callback().
+ *
+ * @param shard_id   Shard identifier stored in the low bits (< 2^shard_bits).
+ * @param shard_bits Reserved low-order bits (0 to UT_MONOTONIC_MAX_SHARD_BITS).
+ * @param out        Receives the new generator.
+ * @return UT_OK on success, UT_ERR_NULL_POINTER, UT_ERR_OUT_OF_RANGE for
+ *         an invalid shard, or UT_ERR_OUT_OF_MEMORY.
+ *
+ * @code
+ * ut_monotonic_gen_t *gen;
+ * ut_monotonic_gen_create(worker_index, 8, &gen);  // up to 256 workers
+ * ut_timestamp_t id = ut_monotonic_gen_next(gen);
+ * ut_monotonic_gen_destroy(gen);
+ * @endcode
+ */
+
+UT_API ut_error_t ut_monotonic_gen_create(uint32_t shard_id, unsigned shard_bits,
+                                          ut_monotonic_gen_t **out);
+
+/**
+ * @brief Get the next timestamp from a generator.
+ *
+ * Reads the clock selected with ut_set_clock_source() and returns a value
+ * strictly greater than any previously returned by this generator.
+ *
+ * @param gen    Generator created by ut_monotonic_gen_create().
+ * @return Next timestamp, or a zero timestamp if gen is NULL.
+ */
+
+UT_API ut_timestamp_t ut_monotonic_gen_next(ut_monotonic_gen_t *gen);
+
+/**
+ * @brief Release a generator created by ut_monotonic_gen_create().
+ *
+ * @param gen    Generator to free (NULL is ignored).
+ */
+
+UT_API void ut_monotonic_gen_destroy(ut_monotonic_gen_t *gen);
 
 /**
  * @brief Format a timestamp to an ISO-8601 string.
@@ -204,7 +630,122 @@ void ut_set_regression_callback(ut_regression_callback_t callback);
  * @endcode
  */
 
-int ut_format(ut_timestamp_t ts, char *buf, size_t buf_size, bool include_nanos);
+UT_API int ut_format(ut_timestamp_t ts, char *buf, size_t buf_size, bool include_nanos);
+
+/**
+ * @brief Format a timestamp, reusing the calling thread's last date.
+ *
+ * Produces exactly the same output as ut_format(). Each thread keeps the
+ * last UTC day it formatted together with its rendered "YYYY-MM-DDT"
+ * prefix, so consecutive calls on the same day only compute and render
+ * the time of day. This pays off for temporally clustered input such as
+ * log lines or ut_now() results.
+ *
+ * Thread-safe: the cache is thread-local and needs no locking.
+ *
+ * @param ts            Timestamp to format.
+ * @param buf           Output buffer (must be at least UT_MAX_STRING_LEN bytes).
+ * @param buf_size      Size of the output buffer.
+ * @param include_nanos If true, include fractional seconds when non-zero.
+ * @return Number of characters written (excluding null terminator), or -1 on error.
+ *
+ * @code
+ * char buf[UT_MAX_STRING_LEN];
+ * ut_format_cached(ut_now(), buf, sizeof(buf), true);
+ * @endcode
+ */
+
+UT_API int ut_format_cached(ut_timestamp_t ts, char *buf, size_t buf_size, bool include_nanos);
+
+/**
+ * @brief Read the ut_format_cached() hit and miss counters.
+ *
+ * Counters are totals across all threads since start-up or the last
+ * ut_reset_format_cache_stats(). Each thread publishes its counts every
+ * 64 calls, so other threads' most recent calls may not be included yet;
+ * the calling thread's own counts are always up to date.
+ *
+ * @param out    Receives the current counters.
+ *
+ * @code
+ * ut_format_cache_stats_t stats;
+ * ut_get_format_cache_stats(&stats);
+ * printf("hit rate: %.1f%%\n", 100.0 * stats.hits / (stats.hits + stats.misses));
+ * @endcode
+ */
+
+UT_API void ut_get_format_cache_stats(ut_format_cache_stats_t *out);
+
+/**
+ * @brief Reset the ut_format_cached() hit and miss counters to zero.
+ *
+ * Counts not yet published by other threads are kept and show up later.
+ */
+
+UT_API void ut_reset_format_cache_stats(void);
+
+/**
+ * @brief Format an array of timestamps into fixed-size slots.
+ *
+ * Element i is written as a null-terminated string starting at
+ * out + i * stride, using the same rules as ut_format(). Consecutive
+ * timestamps that fall on the same UTC day share one date computation,
+ * which makes sorted input (log flushes, column exports) cheap.
+ *
+ * @param in            Array of n timestamps.
+ * @param n             Number of timestamps.
+ * @param out           Output buffer of at least n * stride bytes.
+ * @param stride        Distance between slots (minimum UT_MAX_STRING_LEN).
+ * @param include_nanos If true, include fractional seconds when non-zero.
+ * @return UT_OK on success, UT_ERR_NULL_POINTER or UT_ERR_BUFFER_TOO_SMALL.
+ *
+ * @code
+ * ut_timestamp_t column[1024];
+ * char text[1024][UT_MAX_STRING_LEN];
+ * ut_format_batch(column, 1024, &text[0][0], UT_MAX_STRING_LEN, true);
+ * @endcode
+ */
+
+UT_API ut_error_t ut_format_batch(const ut_timestamp_t *in, size_t n,
+                                  char *out, size_t stride, bool include_nanos);
+
+/**
+ * @brief Format an array of timestamps into one packed, delimited buffer.
+ *
+ * Each formatted timestamp is followed by delim (for example '\n' for
+ * line-oriented output or '\0' for a sequence of C strings). No extra
+ * terminator is written after the last delimiter.
+ *
+ * When offsets is non-NULL it receives n + 1 entries: offsets[i] is the
+ * start of element i and offsets[n] is the total number of bytes written,
+ * so element i spans offsets[i + 1] - offsets[i] - 1 characters.
+ *
+ * A buffer of n * (UT_MAX_STRING_LEN - 1) bytes is always large enough.
+ *
+ * @param in            Array of n timestamps.
+ * @param n             Number of timestamps.
+ * @param out           Output buffer.
+ * @param out_size      Size of the output buffer in bytes.
+ * @param delim         Byte written after every element.
+ * @param include_nanos If true, include fractional seconds when non-zero.
+ * @param offsets       Optional array of n + 1 element offsets, or NULL.
+ * @param out_len       Receives the number of bytes written (may be NULL).
+ * @return UT_OK on success, UT_ERR_NULL_POINTER or UT_ERR_BUFFER_TOO_SMALL.
+ *         On UT_ERR_BUFFER_TOO_SMALL, out_len reports the bytes of the
+ *         elements that did fit.
+ *
+ * @code
+ * char text[4096];
+ * size_t len;
+ * ut_format_batch_packed(column, 100, text, sizeof(text), '\n', true, NULL, &len);
+ * fwrite(text, 1, len, stdout);
+ * @endcode
+ */
+
+UT_API ut_error_t ut_format_batch_packed(const ut_timestamp_t *in, size_t n,
+                                         char *out, size_t out_size, char delim,
+                                         bool include_nanos, size_t *offsets,
+                                         size_t *out_len);
 
 /**
  * @brief Parse a timestamp string in strict mode.
@@ -229,7 +770,7 @@ int ut_format(ut_timestamp_t ts, char *buf, size_t buf_size, bool include_nanos)
  * @endcode
  */
  
-ut_error_t ut_parse_strict(const char *str, ut_timestamp_t *out);
+UT_API ut_error_t ut_parse_strict(const char *str, ut_timestamp_t *out);
 
 /**
  * @brief Parse a timestamp string in lenient mode.
@@ -251,7 +792,285 @@ ut_error_t ut_parse_strict(const char *str, ut_timestamp_t *out);
  * @endcode
  */
 
-ut_error_t ut_parse_lenient(const char *str, ut_timestamp_t *out);
+UT_API ut_error_t ut_parse_lenient(const char *str, ut_timestamp_t *out);
+
+/**
+ * @brief Parse a length-delimited timestamp in strict mode.
+ *
+ * Same rules as ut_parse_strict(), but the input is exactly len bytes and
+ * does not need to be null-terminated. Use this for slices of larger
+ * network or memory-mapped buffers.
+ *
+ * @param str    Start of the timestamp text.
+ * @param len    Number of bytes to parse.
+ * @param out    Pointer to store the parsed timestamp.
+ * @return UT_OK on success, error code on failure.
+ *
+ * @code
+ * const char *record = "2024-12-14T03:13:21Z,GET,/index.html";
+ * ut_timestamp_t ts;
+ * ut_parse_strict_n(record, 20, &ts);
+ * @endcode
+ */
+
+UT_API ut_error_t ut_parse_strict_n(const char *str, size_t len, ut_timestamp_t *out);
+
+/**
+ * @brief Parse a length-delimited timestamp in lenient mode.
+ *
+ * Same rules as ut_parse_lenient(), but the input is exactly len bytes and
+ * does not need to be null-terminated.
+ *
+ * @param str    Start of the timestamp text.
+ * @param len    Number of bytes to parse.
+ * @param out    Pointer to store the parsed timestamp.
+ * @return UT_OK on success, error code on failure.
+ */
+
+UT_API ut_error_t ut_parse_lenient_n(const char *str, size_t len, ut_timestamp_t *out);
+
+/**
+ * @brief Parse a timestamp at the start of a buffer and report its length.
+ *
+ * Reads one timestamp from the beginning of str (at most len bytes) and
+ * stops at the first byte that cannot continue it, so timestamps embedded
+ * in JSON or CSV records can be parsed in place. In strict mode the
+ * timestamp must still end with 'Z'; in lenient mode the suffix is optional.
+ *
+ * @param str       Start of the buffer.
+ * @param len       Number of readable bytes.
+ * @param out       Pointer to store the parsed timestamp.
+ * @param consumed  Receives the number of bytes that form the timestamp.
+ * @param strict    true for strict mode, false for lenient mode.
+ * @return UT_OK on success, error code on failure.
+ *
+ * @code
+ * const char *json = "2024-12-14T03:13:21.5Z\",\"level\":\"info\"}";
+ * ut_timestamp_t ts;
+ * size_t used;
+ * ut_parse_prefix(json, strlen(json), &ts, &used, true);  // used == 22
+ * @endcode
+ */
+
+UT_API ut_error_t ut_parse_prefix(const char *str, size_t len, ut_timestamp_t *out,
+                                  size_t *consumed, bool strict);
+
+/**
+ * @brief Parse common timestamp spellings in one pass, converting offsets to UTC.
+ *
+ * Without flags this accepts what ut_parse_lenient_n() accepts, plus
+ * "+HHMM" and "+HH" zero offsets and ',' as the decimal mark. Each flag
+ * adds more forms:
+ * - UT_FLEX_OFFSETS: a non-zero "+HH:MM", "+HHMM" or "+HH" offset is
+ *   subtracted to give UTC instead of failing with
+ *   UT_ERR_UNSUPPORTED_OFFSET.
+ * - UT_FLEX_SPACE: "2024-12-14 12:00:00", lowercase 't', and one space
+ *   before the zone ("... 12:00:00 +0100").
+ * - UT_FLEX_BASIC: "20241214T120000.5Z" and "20241214T120000+0100".
+ * - UT_FLEX_EPOCH: an optionally signed Unix epoch with an optional
+ *   fraction. The unit comes from the number of integer digits: up to 11
+ *   is seconds, 12-14 milliseconds, 15-17 microseconds, 18-19
+ *   nanoseconds.
+ *
+ * The input is scanned once: a character-class table decides the form
+ * from the first digit run and the byte after it, and no copy or
+ * normalized string is made. Fractions beyond nanosecond precision are
+ * truncated. A result outside the int64 nanosecond range fails with
+ * UT_ERR_OUT_OF_RANGE.
+ *
+ * @param str    Start of the timestamp text.
+ * @param len    Number of bytes to parse; the whole range must match.
+ * @param flags  Bitwise OR of ut_flex_flags_t values.
+ * @param out    Pointer to store the parsed timestamp.
+ * @param info   Receives the matched form and offset; may be NULL.
+ * @return UT_OK on success, error code on failure.
+ *
+ * @code
+ * const char *line = "2024-12-14 13:00:00+01:00";
+ * ut_timestamp_t ts;
+ * ut_parse_info_t info;
+ * ut_parse_flexible(line, strlen(line), UT_FLEX_ALL, &ts, &info);
+ * // ts is 2024-12-14T12:00:00Z, info.offset_seconds == 3600
+ * @endcode
+ */
+
+UT_API ut_error_t ut_parse_flexible(const char *str, size_t len, unsigned flags,
+                                    ut_timestamp_t *out, ut_parse_info_t *info);
+
+/**
+ * @brief Parse an array of timestamp strings in one call.
+ *
+ * Each element is parsed exactly as ut_parse_strict() or ut_parse_lenient()
+ * would parse it, but strings are described by explicit lengths so no null
+ * terminator or strlen() pass is needed. Failed elements store 0 in out[i].
+ *
+ * @param strs    Array of n string pointers.
+ * @param lens    Array of n lengths, or NULL to treat every string as
+ *                null-terminated.
+ * @param n       Number of strings.
+ * @param out     Array receiving n timestamps.
+ * @param errs    Optional array receiving n per-element error codes, or NULL.
+ * @param strict  true for strict mode, false for lenient mode.
+ * @return UT_OK if every element parsed, otherwise the error code of the
+ *         first failing element (UT_ERR_NULL_POINTER for bad arguments).
+ *
+ * @code
+ * const char *lines[] = {"2024-12-14T03:13:21Z", "bogus"};
+ * ut_timestamp_t ts[2];
+ * ut_error_t errs[2];
+ * ut_parse_batch(lines, NULL, 2, ts, errs, true);
+ * // errs[0] == UT_OK, errs[1] == UT_ERR_INVALID_FORMAT
+ * @endcode
+ */
+
+UT_API ut_error_t ut_parse_batch(const char *const *strs, const size_t *lens, size_t n,
+                                 ut_timestamp_t *out, ut_error_t *errs, bool strict);
+
+/**
+ * @brief Parse delimiter-separated timestamps from one contiguous buffer.
+ *
+ * The buffer is split on delim; a trailing delimiter does not start an
+ * extra record. When delim is '\n', a '\r' before it is also stripped so
+ * CRLF files parse unchanged. The buffer does not need a null terminator.
+ *
+ * @param buf       Input bytes.
+ * @param len       Number of bytes in buf.
+ * @param delim     Record separator.
+ * @param out       Array receiving up to capacity timestamps.
+ * @param errs      Optional array of capacity per-record error codes, or NULL.
+ * @param capacity  Number of entries available in out (and errs).
+ * @param count     Receives the number of records parsed.
+ * @param strict    true for strict mode, false for lenient mode.
+ * @return UT_ERR_BUFFER_TOO_SMALL if buf holds more than capacity records,
+ *         otherwise UT_OK or the error code of the first failing record.
+ *
+ * @code
+ * const char data[] = "2024-12-14T03:13:21Z\n2024-12-14T03:13:22Z\n";
+ * ut_timestamp_t ts[8];
+ * size_t count;
+ * ut_parse_delimited(data, sizeof(data) - 1, '\n', ts, NULL, 8, &count, true);
+ * // count == 2
+ * @endcode
+ */
+
+UT_API ut_error_t ut_parse_delimited(const char *buf, size_t len, char delim,
+                                     ut_timestamp_t *out, ut_error_t *errs,
+                                     size_t capacity, size_t *count, bool strict);
+
+/**
+ * @brief Parse timestamps located by an offsets array within one buffer.
+ *
+ * Record i spans buf[offsets[i]] up to buf[offsets[i + 1]], so offsets
+ * holds n + 1 entries. A single trailing '\n', "\r\n" or '\0' inside a
+ * span is ignored, which means the output of ut_format_batch_packed()
+ * can be fed back in directly.
+ *
+ * @param buf      Input bytes.
+ * @param offsets  Array of n + 1 byte offsets into buf.
+ * @param n        Number of records.
+ * @param out      Array receiving n timestamps.
+ * @param errs     Optional array receiving n per-record error codes, or NULL.
+ * @param strict   true for strict mode, false for lenient mode.
+ * @return UT_OK if every record parsed, otherwise the error code of the
+ *         first failing record (UT_ERR_NULL_POINTER for bad arguments).
+ */
+
+UT_API ut_error_t ut_parse_offsets(const char *buf, const size_t *offsets, size_t n,
+                                   ut_timestamp_t *out, ut_error_t *errs, bool strict);
+
+/**
+ * @brief Encode timestamps as a binary column.
+ *
+ * Writes a UT_COLUMN_HEADER_LEN-byte header followed by the zig-zag
+ * LEB128 varint of each difference from the previous value (the first
+ * value is relative to 0), as defined in section 7 of the specification.
+ * Sorted or clustered data usually needs 3-5 bytes per timestamp.
+ * A buffer of UT_COLUMN_MAX_ENCODED_LEN(n) bytes is always enough.
+ *
+ * @param in        Timestamps to encode.
+ * @param n         Number of timestamps.
+ * @param out       Output buffer.
+ * @param out_size  Size of out in bytes.
+ * @param written   Receives the number of bytes written.
+ * @return UT_OK, UT_ERR_NULL_POINTER, or UT_ERR_BUFFER_TOO_SMALL (nothing
+ *         is written in that case).
+ *
+ * @code
+ * uint8_t wire[UT_COLUMN_MAX_ENCODED_LEN(1000)];
+ * size_t len;
+ * ut_encode_column(column, 1000, wire, sizeof(wire), &len);
+ * @endcode
+ */
+
+UT_API ut_error_t ut_encode_column(const ut_timestamp_t *in, size_t n,
+                                   uint8_t *out, size_t out_size, size_t *written);
+
+/**
+ * @brief Reset an incremental column encoder.
+ *
+ * @param enc  Encoder to reset.
+ */
+
+UT_API void ut_column_encoder_init(ut_column_encoder_t *enc);
+
+/**
+ * @brief Append timestamps to a column being built incrementally.
+ *
+ * The first call writes the header. The bytes produced by successive
+ * calls, concatenated, equal what ut_encode_column() writes for all the
+ * values at once. The append is all-or-nothing: on
+ * UT_ERR_BUFFER_TOO_SMALL nothing is written and enc is unchanged.
+ *
+ * @param enc       Encoder state.
+ * @param in        Timestamps to append.
+ * @param n         Number of timestamps.
+ * @param out       Output buffer for this call's bytes.
+ * @param out_size  Size of out in bytes.
+ * @param written   Receives the number of bytes written.
+ * @return UT_OK, UT_ERR_NULL_POINTER or UT_ERR_BUFFER_TOO_SMALL.
+ */
+
+UT_API ut_error_t ut_column_encode_append(ut_column_encoder_t *enc, const ut_timestamp_t *in, size_t n,
+                                          uint8_t *out, size_t out_size, size_t *written);
+
+/**
+ * @brief Count the timestamps in an encoded column without decoding them.
+ *
+ * @param in     Encoded column.
+ * @param len    Length of in in bytes.
+ * @param count  Receives the number of timestamps.
+ * @return UT_OK, UT_ERR_NULL_POINTER, or UT_ERR_INVALID_FORMAT for a bad
+ *         header, an unsupported version or a truncated final value.
+ */
+
+UT_API ut_error_t ut_column_count(const uint8_t *in, size_t len, size_t *count);
+
+/**
+ * @brief Decode a binary column produced by ut_encode_column().
+ *
+ * On x86-64 CPUs with fast BMI2 the varints are decoded a 64-bit word at a
+ * time with PEXT; elsewhere a scalar loop is used.
+ *
+ * @param in        Encoded column.
+ * @param len       Length of in in bytes.
+ * @param out       Array receiving the timestamps.
+ * @param capacity  Number of elements out can hold.
+ * @param count     Receives the number of timestamps decoded.
+ * @return UT_OK, UT_ERR_NULL_POINTER, UT_ERR_INVALID_FORMAT for a bad
+ *         header, an unsupported version or a malformed varint, or
+ *         UT_ERR_BUFFER_TOO_SMALL when the column holds more than
+ *         capacity values (the first capacity are decoded).
+ *
+ * @code
+ * size_t n;
+ * ut_column_count(wire, len, &n);
+ * ut_timestamp_t *column = malloc(n * sizeof(*column));
+ * ut_decode_column(wire, len, column, n, &n);
+ * @endcode
+ */
+
+UT_API ut_error_t ut_decode_column(const uint8_t *in, size_t len,
+                                   ut_timestamp_t *out, size_t capacity, size_t *count);
 
 /**
  * @brief Create a timestamp from Unix nanoseconds.
@@ -268,7 +1087,14 @@ ut_error_t ut_parse_lenient(const char *str, ut_timestamp_t *out);
  * @endcode
  */
 
-ut_timestamp_t ut_from_unix_nanos(int64_t nanos);
+#if defined(UT_INLINE_ACCESSORS)
+static inline ut_timestamp_t ut_from_unix_nanos(int64_t nanos) {
+    ut_timestamp_t ts = {nanos};
+    return ts;
+}
+#else
+UT_API ut_timestamp_t ut_from_unix_nanos(int64_t nanos);
+#endif
 
 /**
  * @brief Convert a timestamp to Unix nanoseconds.
@@ -285,7 +1111,127 @@ ut_timestamp_t ut_from_unix_nanos(int64_t nanos);
  * @endcode
  */
 
-int64_t ut_to_unix_nanos(ut_timestamp_t ts);
+#if defined(UT_INLINE_ACCESSORS)
+static inline int64_t ut_to_unix_nanos(ut_timestamp_t ts) {
+    return ts.nanos;
+}
+#else
+UT_API int64_t ut_to_unix_nanos(ut_timestamp_t ts);
+#endif
+
+/**
+ * @brief Build a duration from a count of units, saturating on overflow.
+ *
+ * @param count  Number of units (may be negative).
+ * @param unit   Unit of count.
+ * @return The duration, clamped to the int64_t nanosecond range.
+ *
+ * @code
+ * ut_duration_t window = ut_duration_from(5, UT_UNIT_MINUTE);
+ * @endcode
+ */
+
+UT_API ut_duration_t ut_duration_from(int64_t count, ut_unit_t unit);
+
+/**
+ * @brief Convert a duration to whole units, truncating toward zero.
+ *
+ * @param d      Duration to convert.
+ * @param unit   Target unit.
+ * @return Number of whole units in d.
+ */
+
+UT_API int64_t ut_duration_to(ut_duration_t d, ut_unit_t unit);
+
+/**
+ * @brief Add a duration to a timestamp, clamping at the representable range.
+ *
+ * @param ts     Starting instant.
+ * @param d      Duration to add (may be negative).
+ * @return ts + d, or the nearest representable timestamp on overflow.
+ */
+
+UT_API ut_timestamp_t ut_add_saturating(ut_timestamp_t ts, ut_duration_t d);
+
+/**
+ * @brief Subtract a duration from a timestamp, clamping at the representable range.
+ *
+ * @param ts     Starting instant.
+ * @param d      Duration to subtract (may be negative).
+ * @return ts - d, or the nearest representable timestamp on overflow.
+ */
+
+UT_API ut_timestamp_t ut_sub_saturating(ut_timestamp_t ts, ut_duration_t d);
+
+/**
+ * @brief Get the duration a - b, clamping at the representable range.
+ *
+ * @param a      Later instant.
+ * @param b      Earlier instant.
+ * @return Elapsed time from b to a (negative if a is before b).
+ */
+
+UT_API ut_duration_t ut_diff_saturating(ut_timestamp_t a, ut_timestamp_t b);
+
+/**
+ * @brief Add a duration to a timestamp, reporting overflow.
+ *
+ * @param ts     Starting instant.
+ * @param d      Duration to add.
+ * @param out    Receives ts + d on success; untouched on failure.
+ * @return UT_OK, UT_ERR_OUT_OF_RANGE on overflow, or UT_ERR_NULL_POINTER.
+ *
+ * @code
+ * ut_timestamp_t deadline;
+ * if (ut_add_checked(ut_now(), timeout, &deadline) != UT_OK) {
+ *     // timeout too large
+ * }
+ * @endcode
+ */
+
+UT_API ut_error_t ut_add_checked(ut_timestamp_t ts, ut_duration_t d, ut_timestamp_t *out);
+
+/**
+ * @brief Subtract a duration from a timestamp, reporting overflow.
+ *
+ * @param ts     Starting instant.
+ * @param d      Duration to subtract.
+ * @param out    Receives ts - d on success; untouched on failure.
+ * @return UT_OK, UT_ERR_OUT_OF_RANGE on overflow, or UT_ERR_NULL_POINTER.
+ */
+
+UT_API ut_error_t ut_sub_checked(ut_timestamp_t ts, ut_duration_t d, ut_timestamp_t *out);
+
+/**
+ * @brief Get the duration a - b, reporting overflow.
+ *
+ * @param a      Later instant.
+ * @param b      Earlier instant.
+ * @param out    Receives a - b on success; untouched on failure.
+ * @return UT_OK, UT_ERR_OUT_OF_RANGE on overflow, or UT_ERR_NULL_POINTER.
+ */
+
+UT_API ut_error_t ut_diff_checked(ut_timestamp_t a, ut_timestamp_t b, ut_duration_t *out);
+
+/**
+ * @brief Round a timestamp down to a multiple of a unit.
+ *
+ * Rounds toward negative infinity, so instants before the epoch land on
+ * the start of their own second, minute or day. UT_UNIT_WEEK truncates
+ * to 00:00 on the ISO Monday, UT_UNIT_MONTH to the first of the month
+ * and UT_UNIT_YEAR to January 1st. Results that would fall below the
+ * representable range clamp to INT64_MIN nanoseconds.
+ *
+ * @param ts     Timestamp to truncate.
+ * @param unit   Unit to truncate to.
+ * @return The start of the unit containing ts.
+ *
+ * @code
+ * ut_timestamp_t bucket = ut_truncate(ut_now(), UT_UNIT_MINUTE);
+ * @endcode
+ */
+
+UT_API ut_timestamp_t ut_truncate(ut_timestamp_t ts, ut_unit_t unit);
 
 /**
  * @brief Get a human-readable error message.
@@ -296,7 +1242,7 @@ int64_t ut_to_unix_nanos(ut_timestamp_t ts);
  * @return Null-terminated error message string.
  */
 
-const char *ut_error_string(ut_error_t err);
+UT_API const char *ut_error_string(ut_error_t err);
 
 /**
  * @brief Get the calendar system used for date calculations.
@@ -307,13 +1253,158 @@ const char *ut_error_string(ut_error_t err);
  * @return The default calendar type (UT_CALENDAR_GREGORIAN).
  */
 
-ut_calendar_t ut_get_calendar(void);
+#if defined(UT_INLINE_ACCESSORS)
+static inline ut_calendar_t ut_get_calendar(void) {
+    return UT_CALENDAR_GREGORIAN;
+}
+#else
+UT_API ut_calendar_t ut_get_calendar(void);
+#endif
+
+/**
+ * @brief Select the clock source used by ut_now() and ut_now_monotonic().
+ *
+ * The default is UT_CLOCK_PRECISE. Selecting UT_CLOCK_TSC calibrates the
+ * counter immediately so the first timestamp does not pay for it; if
+ * the counter is unusable, reads fall back to UT_CLOCK_PRECISE. The
+ * ut_now_monotonic() ordering guarantee holds for every source.
+ *
+ * Thread-safe, but intended to be called once at start-up.
+ *
+ * @param source Clock source to use.
+ * @return UT_OK on success, UT_ERR_OUT_OF_RANGE for an unknown source.
+ *
+ * @code
+ * ut_set_clock_source(UT_CLOCK_TSC);
+ * ut_clock_info_t info;
+ * ut_get_clock_info(UT_CLOCK_TSC, &info);
+ * if (info.effective != UT_CLOCK_TSC) {
+ *     // TSC not invariant on this machine; ut_now() uses the precise clock
+ * }
+ * @endcode
+ */
+
+UT_API ut_error_t ut_set_clock_source(ut_clock_source_t source);
+
+/**
+ * @brief Get the clock source used by ut_now() and ut_now_monotonic().
+ *
+ * @return The source last passed to ut_set_clock_source(), or UT_CLOCK_PRECISE.
+ */
+
+UT_API ut_clock_source_t ut_get_clock_source(void);
+
+/**
+ * @brief Attach to a shared-memory time page and monotonic counter.
+ *
+ * Maps a segment that several processes on the host share (POSIX shared
+ * memory, or a named file mapping on Windows). It holds a time page,
+ * updated by one publisher under a seqlock and read with
+ * UT_CLOCK_SHARED, and the counter behind ut_now_monotonic() and
+ * ut_now_monotonic_n(). Once attached, those two functions are strictly
+ * increasing across every attached process, not only within this one.
+ * The clock they sample is still the one chosen with
+ * ut_set_clock_source(); select UT_CLOCK_SHARED to read the page instead
+ * of the system clock.
+ *
+ * A UT_SHARED_PUBLISHER creates the segment, or takes over an existing
+ * one while keeping its counter. With interval_ns > 0 it starts a
+ * background thread that publishes the precise clock every interval_ns
+ * (see UT_SHARED_DEFAULT_INTERVAL_NS); with 0 no thread is started and
+ * the caller publishes with ut_shared_clock_publish(). A UT_SHARED_READER
+ * maps an existing segment and ignores interval_ns. If the publisher
+ * stops, readers keep seeing its last published time. If the page is
+ * left mid-update (a publisher killed inside a write), a read gives up
+ * after a few hundred retries and returns UT_CLOCK_PRECISE instead.
+ *
+ * On POSIX the segment is created with mode 0600, and both roles refuse
+ * a segment owned by another user or writable by group or other, since
+ * any writer can corrupt the time and counter of every attached
+ * process. A publisher tightens a looser segment it owns. Sharing is
+ * therefore limited to processes running as the same user.
+ *
+ * Call once at start-up, before other threads use the clock. A process
+ * attaches to at most one segment at a time.
+ *
+ * @param name        Segment name starting with '/', or NULL for UT_SHARED_DEFAULT_NAME.
+ * @param role        UT_SHARED_READER or UT_SHARED_PUBLISHER.
+ * @param interval_ns Publisher update period, or 0 for manual publishing.
+ * @return UT_OK, UT_ERR_OUT_OF_RANGE for an unknown role or negative
+ *         interval, UT_ERR_INVALID_FORMAT for a bad name or an
+ *         incompatible segment, or UT_ERR_UNAVAILABLE if already attached
+ *         or the segment or thread cannot be created or opened (including
+ *         a segment with an unsafe owner or mode, and platforms without
+ *         shared memory).
+ *
+ * @code
+ * // Publisher process
+ * ut_shared_clock_init("/uts-clock", UT_SHARED_PUBLISHER, UT_SHARED_DEFAULT_INTERVAL_NS);
+ *
+ * // Each worker process
+ * ut_shared_clock_init("/uts-clock", UT_SHARED_READER, 0);
+ * ut_set_clock_source(UT_CLOCK_SHARED);
+ * ut_timestamp_t id = ut_now_monotonic();  // unique across all workers
+ * @endcode
+ */
+
+UT_API ut_error_t ut_shared_clock_init(const char *name, ut_shared_role_t role, int64_t interval_ns);
+
+/**
+ * @brief Publish the current precise time to the attached time page.
+ *
+ * For publishers started with interval_ns = 0 that drive updates from
+ * their own loop. Safe to call alongside the background thread.
+ *
+ * @return UT_OK, or UT_ERR_UNAVAILABLE unless attached as a publisher.
+ */
+
+UT_API ut_error_t ut_shared_clock_publish(void);
+
+/**
+ * @brief Detach from the shared segment.
+ *
+ * Stops the publisher thread, if any, and unmaps the segment; a
+ * publisher also removes its name, so later readers fail to attach until
+ * a new publisher starts. ut_now_monotonic() returns to a process-local
+ * counter that continues above the last shared value, and UT_CLOCK_SHARED
+ * falls back to UT_CLOCK_PRECISE. Must not run concurrently with other
+ * calls into the library. Does nothing when not attached.
+ */
+
+UT_API void ut_shared_clock_shutdown(void);
+
+/**
+ * @brief Describe the resolution, precision and cost of a clock source.
+ *
+ * The first call for a source probes it once: about a thousand readings
+ * for cost and backward steps, then up to eight distinct readings (for at
+ * most 10 ms) for the smallest step and digit granularity. The result is
+ * cached, and later calls from any thread copy it. Attaching to or
+ * detaching from a shared clock discards the UT_CLOCK_SHARED entry.
+ *
+ * @param source Clock source to inspect.
+ * @param out    Receives the measured characteristics.
+ * @return UT_OK on success, UT_ERR_NULL_POINTER or UT_ERR_OUT_OF_RANGE
+ *         for an unknown source.
+ *
+ * @code
+ * ut_clock_info_t info;
+ * ut_get_clock_info(UT_CLOCK_COARSE, &info);
+ * printf("coarse: %lld ns tick, %.1f ns/call\n",
+ *        (long long)info.resolution_ns, info.cost_ns);
+ * @endcode
+ */
+
+UT_API ut_error_t ut_get_clock_info(ut_clock_source_t source, ut_clock_info_t *out);
 
 /**
  * @brief Detect the clock precision available on the current hardware.
  *
- * Samples the system clock multiple times to determine the actual
- * precision available. Lower return values indicate higher precision.
+ * Returns the precision field of the cached ut_get_clock_info() probe for
+ * the source selected with ut_set_clock_source(), so only the first call
+ * per source takes samples. Lower return values indicate higher precision.
+ * Use ut_get_clock_info() for the resolution and cost of each source and
+ * to see whether the TSC backend is active.
  *
  * @return Precision level:
  *         - UT_PRECISION_NANOSECOND (0): Full nanosecond precision
@@ -330,7 +1421,71 @@ ut_calendar_t ut_get_calendar(void);
  * @endcode
  */
 
-ut_precision_t ut_get_clock_precision(void);
+UT_API ut_precision_t ut_get_clock_precision(void);
+
+/**
+ * @brief Read the library-wide statistics counters.
+ *
+ * Available only when the library is built with UT_ENABLE_STATS
+ * (`make STATS=1`); otherwise the counting code is compiled out and this
+ * fills only the clock fields and returns UT_ERR_UNAVAILABLE. Each thread counts into its own slot without
+ * touching shared cache lines; this call sums every slot, including those
+ * of threads that have exited, so it is exact but costs O(threads). It
+ * also measures the selected clock source with ut_get_clock_info(), so
+ * call it from diagnostics rather than a hot path.
+ *
+ * Parse counts cover the single-value and batch ut_parse_*() functions;
+ * arguments rejected with UT_ERR_NULL_POINTER before parsing are not
+ * counted.
+ *
+ * @param out    Receives the counters since start-up or the last ut_reset_stats().
+ * @return UT_OK, UT_ERR_NULL_POINTER, or UT_ERR_UNAVAILABLE without UT_ENABLE_STATS.
+ *
+ * @code
+ * ut_stats_t stats;
+ * if (ut_get_stats(&stats) == UT_OK) {
+ *     printf("%llu bumps\n", (unsigned long long)stats.monotonic_bumps);
+ * }
+ * @endcode
+ */
+
+UT_API ut_error_t ut_get_stats(ut_stats_t *out);
+
+/**
+ * @brief Restart the statistics counters from zero.
+ *
+ * Counting threads are not disturbed: later ut_get_stats() calls report
+ * activity after this point. Does nothing without UT_ENABLE_STATS.
+ */
+
+UT_API void ut_reset_stats(void);
+
+/**
+ * @brief Render statistics in the Prometheus text exposition format.
+ *
+ * Writes `ut_monotonic_calls_total`, `ut_monotonic_bumps_total`,
+ * `ut_monotonic_cas_retries_total`, `ut_shared_fallbacks_total`,
+ * `ut_parse_total{result="..."}` (one
+ * sample per ut_error_t, labelled "ok", "invalid_format", ...) and
+ * `ut_clock_cost_ns{source="...",effective="..."}`, each with HELP and
+ * TYPE lines. Works whether or not the library counts statistics.
+ *
+ * @param stats     Counters from ut_get_stats().
+ * @param buf       Output buffer.
+ * @param buf_size  Size of buf; 2048 bytes is always enough.
+ * @return Length written (excluding the terminator), or -1 if an argument
+ *         is NULL or buf is too small.
+ *
+ * @code
+ * ut_stats_t stats;
+ * char text[2048];
+ * if (ut_get_stats(&stats) == UT_OK && ut_format_stats(&stats, text, sizeof(text)) > 0) {
+ *     fputs(text, stdout);
+ * }
+ * @endcode
+ */
+
+UT_API int ut_format_stats(const ut_stats_t *stats, char *buf, size_t buf_size);
 
 /**
  * @brief Convert Gregorian year to Thai Buddhist Era year.
@@ -345,7 +1500,7 @@ ut_precision_t ut_get_clock_precision(void);
  * @endcode
  */
 
-int ut_gregorian_to_thai(int gregorian_year);
+UT_API int ut_gregorian_to_thai(int gregorian_year);
 
 /**
  * @brief Convert Thai Buddhist Era year to Gregorian year.
@@ -356,7 +1511,7 @@ int ut_gregorian_to_thai(int gregorian_year);
  * @return Gregorian year.
  */
 
-int ut_thai_to_gregorian(int thai_year);
+UT_API int ut_thai_to_gregorian(int thai_year);
 
 /**
  * @brief Convert Gregorian year to Korean Dangi year.
@@ -371,7 +1526,7 @@ int ut_thai_to_gregorian(int thai_year);
  * @endcode
  */
 
-int ut_gregorian_to_dangi(int gregorian_year);
+UT_API int ut_gregorian_to_dangi(int gregorian_year);
 
 /**
  * @brief Convert Korean Dangi year to Gregorian year.
@@ -382,7 +1537,7 @@ int ut_gregorian_to_dangi(int gregorian_year);
  * @return Gregorian year.
  */
 
-int ut_dangi_to_gregorian(int dangi_year);
+UT_API int ut_dangi_to_gregorian(int dangi_year);
 
 /**
  * @brief Convert Gregorian year to Minguo (ROC) year.
@@ -397,7 +1552,7 @@ int ut_dangi_to_gregorian(int dangi_year);
  * @endcode
  */
 
-int ut_gregorian_to_minguo(int gregorian_year);
+UT_API int ut_gregorian_to_minguo(int gregorian_year);
 
 /**
  * @brief Convert Minguo (ROC) year to Gregorian year.
@@ -408,12 +1563,15 @@ int ut_gregorian_to_minguo(int gregorian_year);
  * @return Gregorian year.
  */
 
-int ut_minguo_to_gregorian(int minguo_year);
+UT_API int ut_minguo_to_gregorian(int minguo_year);
 
 /**
  * @brief Get Japanese era and year for a given timestamp.
  *
  * Returns the Japanese era and year within that era for the given timestamp.
+ * Eras begin at 00:00 UTC on their first day. The lookup compares against
+ * precomputed boundaries, newest first, so recent timestamps take a single
+ * comparison; eras added with ut_register_japanese_era() are included.
  *
  * @param ts        Timestamp to convert.
  * @param era       Pointer to store the era identifier.
@@ -427,7 +1585,55 @@ int ut_minguo_to_gregorian(int minguo_year);
  * @endcode
  */
 
-ut_error_t ut_to_japanese_era(ut_timestamp_t ts, ut_japanese_era_t *era, int *era_year);
+UT_API ut_error_t ut_to_japanese_era(ut_timestamp_t ts, ut_japanese_era_t *era, int *era_year);
+
+/**
+ * @brief Get Japanese era and year for an array of timestamps.
+ *
+ * Produces exactly what ut_to_japanese_era() returns for each element.
+ * The era and year of the previous row are reused while they still
+ * apply, so sorted exports cost a range check per row.
+ *
+ * @param in         Timestamps to convert.
+ * @param n          Number of timestamps.
+ * @param eras       Receives n era identifiers.
+ * @param era_years  Receives n years within the era (0 for rows before Meiji).
+ * @param errs       Optional array receiving n per-element error codes, or NULL.
+ * @return UT_OK if every row converted, otherwise the error of the first
+ *         failing row (UT_ERR_NULL_POINTER for bad arguments).
+ */
+
+UT_API ut_error_t ut_to_japanese_era_batch(const ut_timestamp_t *in, size_t n,
+                                           ut_japanese_era_t *eras, int *era_years,
+                                           ut_error_t *errs);
+
+/**
+ * @brief Register a Japanese era that starts after the newest known one.
+ *
+ * Lets a deployment pick up a newly proclaimed era without rebuilding
+ * the library. The era begins at 00:00 UTC on the given date and ends
+ * the previous era. Registered eras are numbered UT_ERA_MEIJI + 1,
+ * UT_ERA_MEIJI + 2, ... in registration order. Safe to call while
+ * other threads convert timestamps.
+ *
+ * @param year   Gregorian year of the first day.
+ * @param month  Month of the first day (1-12).
+ * @param day    Day of the first day.
+ * @param name   Romaji name (fewer than 24 bytes); copied.
+ * @param era    Receives the identifier of the new era.
+ * @return UT_OK, UT_ERR_INVALID_DATE, UT_ERR_OUT_OF_RANGE if the era
+ *         does not start after the newest one, UT_ERR_BUFFER_TOO_SMALL
+ *         for a long name, UT_ERR_OUT_OF_MEMORY when the table holds
+ *         UT_JAPANESE_ERA_CAPACITY eras, or UT_ERR_NULL_POINTER.
+ *
+ * @code
+ * ut_japanese_era_t next;
+ * ut_register_japanese_era(2045, 4, 1, "Example", &next);
+ * @endcode
+ */
+
+UT_API ut_error_t ut_register_japanese_era(int year, int month, int day, const char *name,
+                                           ut_japanese_era_t *era);
 
 /**
  * @brief Get the name of a Japanese era.
@@ -436,7 +1642,7 @@ ut_error_t ut_to_japanese_era(ut_timestamp_t ts, ut_japanese_era_t *era, int *er
  * @return Era name in romaji (e.g., "Reiwa", "Heisei").
  */
 
-const char *ut_japanese_era_name(ut_japanese_era_t era);
+UT_API const char *ut_japanese_era_name(ut_japanese_era_t era);
 
 /**
  * @brief Get ISO week date components from a timestamp.
@@ -455,7 +1661,48 @@ const char *ut_japanese_era_name(ut_japanese_era_t era);
  * @endcode
  */
 
-void ut_to_iso_week(ut_timestamp_t ts, int *year, int *week, int *day);
+UT_API void ut_to_iso_week(ut_timestamp_t ts, int *year, int *week, int *day);
+
+/**
+ * @brief Truncate an array of timestamps to a unit.
+ *
+ * Produces exactly ut_truncate(in[i], unit) for every element. Fixed
+ * units and weeks run a branch-free loop specialized per unit, so every
+ * division is by a constant. Months and years reuse the previous row's
+ * span while it still applies, which makes sorted input nearly free.
+ * in and out may be the same array.
+ *
+ * @param in     Timestamps to truncate.
+ * @param n      Number of timestamps.
+ * @param unit   Unit to truncate to.
+ * @param out    Destination array of n timestamps.
+ * @return UT_OK, UT_ERR_NULL_POINTER, or UT_ERR_OUT_OF_RANGE for an unknown unit.
+ *
+ * @code
+ * ut_truncate_batch(events, n, UT_UNIT_HOUR, buckets);
+ * @endcode
+ */
+
+UT_API ut_error_t ut_truncate_batch(const ut_timestamp_t *in, size_t n, ut_unit_t unit,
+                                    ut_timestamp_t *out);
+
+/**
+ * @brief Get ISO week date components for an array of timestamps.
+ *
+ * Produces exactly what ut_to_iso_week() returns for each element,
+ * written as three parallel arrays for columnar rollups. The week of
+ * the previous row is reused while it still applies.
+ *
+ * @param in     Timestamps to convert.
+ * @param n      Number of timestamps.
+ * @param years  Receives n ISO week-numbering years.
+ * @param weeks  Receives n week numbers (1-53).
+ * @param days   Receives n days of week (1-7, Monday = 1).
+ * @return UT_OK or UT_ERR_NULL_POINTER.
+ */
+
+UT_API ut_error_t ut_iso_week_batch(const ut_timestamp_t *in, size_t n,
+                                    int *years, int *weeks, int *days);
 
 #ifdef __cplusplus
 }
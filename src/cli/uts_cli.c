@@ -1,24 +1,185 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <unistd.h>
 #include <universal_timestamp.h>
+#include "uts_convert.h"
+#include "uts_stream.h"
 
 void print_help(const char* prog) {
     printf("Usage: %s <command> [args]\n", prog);
     printf("Commands:\n");
     printf("  now               Print current UTC timestamp (ISO-8601)\n");
     printf("  now-nanos         Print current UTC timestamp (nanoseconds)\n");
-    printf("  parse <str>       Parse ISO-8601 string to nanoseconds\n");
+    printf("  parse <str>       Parse a timestamp to nanoseconds: ISO-8601 with any\n");
+    printf("                    UTC offset, space separator, basic format, or epoch\n");
+    printf("                    seconds/ms/us/ns\n");
+    printf("  parse -           Parse one such timestamp per stdin line\n");
     printf("  format <nanos>    Format nanoseconds to ISO-8601 string\n");
+    printf("  format -          Format one nanosecond value per stdin line\n");
+    printf("  rewrite --field N [--delim C] [--to nanos|iso]\n");
+    printf("                    Convert field N (1-based) of each stdin line, copying\n");
+    printf("                    the rest; --delim defaults to ',' (use '\\t' for TSV)\n");
+    printf("  convert --input FILE [--output FILE] [--threads N] [--to nanos|iso]\n");
+    printf("          [--field N] [--delim C]\n");
+    printf("                    Convert a file on N worker threads (default: one per\n");
+    printf("                    CPU); whole lines unless --field is given\n");
+    printf("  stats [<command> [args]]\n");
+    printf("                    Run the command, then write library statistics in\n");
+    printf("                    Prometheus text format to stderr; alone, print them\n");
+    printf("                    (counters need a library built with make STATS=1)\n");
     printf("  version           Print library version (requires lib update, using 0.9.0)\n");
 }
 
-int main(int argc, char** argv) {
-    if (argc < 2) {
-        print_help(argv[0]);
+/* Parses a --delim argument: one character, or "\t" / "tab" for a tab. */
+static int parse_delim(const char* arg, char* out) {
+    if (strcmp(arg, "\\t") == 0 || strcmp(arg, "tab") == 0) {
+        *out = '\t';
+        return 0;
+    }
+    if (strlen(arg) != 1) {
+        return -1;
+    }
+    *out = arg[0];
+    return 0;
+}
+
+/* Options shared by "rewrite" and "convert". */
+typedef struct {
+    uts_transform_t t;
+    const char* input;
+    const char* output;
+    unsigned threads;
+    bool to_given;
+} cli_options_t;
+
+/* Reads options from argv[2..]; file options are accepted only when allow_files is set. */
+static int parse_options(int argc, char** argv, bool allow_files, cli_options_t* o) {
+    for (int i = 2; i < argc; i++) {
+        const char* opt = argv[i];
+        const char* val = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (strcmp(opt, "--field") == 0 && val != NULL) {
+            char* end;
+            long field = strtol(val, &end, 10);
+            if (*end != '\0' || field < 1) {
+                fprintf(stderr, "Error: --field must be a positive integer\n");
+                return 1;
+            }
+            o->t.field = (size_t)field;
+        } else if (strcmp(opt, "--delim") == 0 && val != NULL) {
+            if (parse_delim(val, &o->t.delim) != 0) {
+                fprintf(stderr, "Error: --delim must be a single character\n");
+                return 1;
+            }
+        } else if (strcmp(opt, "--to") == 0 && val != NULL) {
+            if (strcmp(val, "iso") == 0) {
+                o->t.to_iso = true;
+            } else if (strcmp(val, "nanos") == 0) {
+                o->t.to_iso = false;
+            } else {
+                fprintf(stderr, "Error: --to must be 'nanos' or 'iso'\n");
+                return 1;
+            }
+            o->to_given = true;
+        } else if (allow_files && strcmp(opt, "--input") == 0 && val != NULL) {
+            o->input = val;
+        } else if (allow_files && strcmp(opt, "--output") == 0 && val != NULL) {
+            o->output = val;
+        } else if (allow_files && strcmp(opt, "--threads") == 0 && val != NULL) {
+            char* end;
+            long threads = strtol(val, &end, 10);
+            if (*end != '\0' || threads < 1 || threads > 1024) {
+                fprintf(stderr, "Error: --threads must be between 1 and 1024\n");
+                return 1;
+            }
+            o->threads = (unsigned)threads;
+        } else {
+            fprintf(stderr, "Error: unknown or incomplete option '%s'\n", opt);
+            return 1;
+        }
+        i++;
+    }
+    return 0;
+}
+
+/* Runs "rewrite", reading its options from argv[2..]. */
+static int run_rewrite(int argc, char** argv) {
+    cli_options_t o = {{UTS_MODE_REWRITE, false, 0, ','}, NULL, NULL, 0, false};
+
+    if (parse_options(argc, argv, false, &o) != 0) {
+        return 1;
+    }
+    if (o.t.field == 0) {
+        fprintf(stderr, "Error: rewrite requires --field N\n");
         return 1;
     }
 
+    uts_stream_stats_t stats;
+    int rc = uts_stream_run(&o.t, STDIN_FILENO, STDOUT_FILENO, &stats);
+    if (rc == 1) {
+        fprintf(stderr, "uts-cli: %zu of %zu lines left unchanged\n", stats.errors, stats.lines);
+        rc = 0;
+    }
+    return rc;
+}
+
+/* Runs "convert", reading its options from argv[2..]. */
+static int run_convert(int argc, char** argv) {
+    cli_options_t o = {{UTS_MODE_PARSE, false, 0, ','}, NULL, NULL, 0, false};
+
+    if (parse_options(argc, argv, true, &o) != 0) {
+        return 1;
+    }
+    if (o.input == NULL) {
+        fprintf(stderr, "Error: convert requires --input FILE\n");
+        return 1;
+    }
+    if (o.t.field > 0) {
+        o.t.mode = UTS_MODE_REWRITE;
+    } else if (o.to_given && o.t.to_iso) {
+        o.t.mode = UTS_MODE_FORMAT;
+    }
+
+    uts_stream_stats_t stats;
+    int rc = uts_convert_file(&o.t, o.input, o.output, o.threads, &stats);
+    if (rc == 1 && o.t.mode == UTS_MODE_REWRITE) {
+        rc = 0;
+    }
+    return rc;
+}
+
+/* Writes the library statistics to out; returns 1 if counters are compiled out. */
+static int print_stats(FILE* out) {
+    ut_stats_t stats;
+    char text[2048];
+    ut_error_t err = ut_get_stats(&stats);
+
+    if (err == UT_ERR_UNAVAILABLE) {
+        fprintf(stderr, "uts-cli: statistics not compiled in (rebuild with make STATS=1)\n");
+    }
+    if (ut_format_stats(&stats, text, sizeof(text)) > 0) {
+        fputs(text, out);
+    }
+    return err == UT_OK ? 0 : 1;
+}
+
+static int run_command(const char* prog, int argc, char** argv);
+
+/* Runs "stats": the remaining arguments as a command, then the statistics dump. */
+static int run_stats(const char* prog, int argc, char** argv) {
+    if (argc < 3) {
+        return print_stats(stdout);
+    }
+
+    int rc = run_command(prog, argc - 1, argv + 1);
+    fflush(stdout);
+    print_stats(stderr);
+    return rc;
+}
+
+/* Dispatches argv[1] with its arguments; prog is used in the help text. */
+static int run_command(const char* prog, int argc, char** argv) {
     const char* cmd = argv[1];
 
     if (strcmp(cmd, "now") == 0) {
@@ -29,13 +190,23 @@ int main(int argc, char** argv) {
     } else if (strcmp(cmd, "now-nanos") == 0) {
         ut_timestamp_t ts = ut_now();
         printf("%ld\n", ut_to_unix_nanos(ts));
+    } else if (strcmp(cmd, "parse") == 0 && argc == 3 && strcmp(argv[2], "-") == 0) {
+        uts_transform_t t = {UTS_MODE_PARSE, false, 0, 0};
+        return uts_stream_run(&t, STDIN_FILENO, STDOUT_FILENO, NULL);
+    } else if (strcmp(cmd, "format") == 0 && argc == 3 && strcmp(argv[2], "-") == 0) {
+        uts_transform_t t = {UTS_MODE_FORMAT, false, 0, 0};
+        return uts_stream_run(&t, STDIN_FILENO, STDOUT_FILENO, NULL);
+    } else if (strcmp(cmd, "rewrite") == 0) {
+        return run_rewrite(argc, argv);
+    } else if (strcmp(cmd, "convert") == 0) {
+        return run_convert(argc, argv);
     } else if (strcmp(cmd, "parse") == 0) {
         if (argc < 3) {
             fprintf(stderr, "Error: missing timestamp string\n");
             return 1;
         }
         ut_timestamp_t ts;
-        if (ut_parse_lenient(argv[2], &ts) != UT_OK) {
+        if (ut_parse_flexible(argv[2], strlen(argv[2]), UT_FLEX_ALL, &ts, NULL) != UT_OK) {
             fprintf(stderr, "Error: invalid timestamp\n");
             return 1;
         }
@@ -50,12 +221,23 @@ int main(int argc, char** argv) {
         char buf[64];
         ut_format(ts, buf, sizeof(buf), 1);
         printf("%s\n", buf);
+    } else if (strcmp(cmd, "stats") == 0) {
+        return run_stats(prog, argc, argv);
     } else if (strcmp(cmd, "version") == 0) {
         printf("0.9.0\n");
     } else {
-        print_help(argv[0]);
+        print_help(prog);
         return 1;
     }
 
     return 0;
 }
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        print_help(argv[0]);
+        return 1;
+    }
+
+    return run_command(argv[0], argc, argv);
+}
@@ -0,0 +1,307 @@
+/**
+ * @file uts_convert.c
+ * @brief Multithreaded file conversion for "uts-cli convert".
+ */
+
+#include "uts_convert.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define UTS_CONVERT_CHUNK (4u << 20)
+#define UTS_SLOTS_PER_THREAD 2
+#define UTS_SLOT_INITIAL (64u << 10)
+
+/* One converted chunk waiting to be written. */
+typedef struct {
+    uts_writer_t out;
+    uts_stream_stats_t stats;
+    bool done;
+} convert_slot_t;
+
+/* State shared between the writer (main thread) and the workers. */
+typedef struct {
+    const uts_transform_t *t;
+    const char *data;
+    const size_t *bounds;           /* chunk i spans [bounds[i], bounds[i + 1]) */
+    size_t chunks;
+    convert_slot_t *slots;
+    size_t window;
+    size_t next;                    /* next chunk to claim */
+    size_t written;                 /* chunks already written out */
+    bool abort;
+    pthread_mutex_t lock;
+    pthread_cond_t slot_ready;      /* a worker finished a chunk */
+    pthread_cond_t slot_free;       /* the writer released a slot */
+} convert_job_t;
+
+/* Claims chunks in order and converts each one into its window slot. */
+static void *convert_worker(void *arg) {
+    convert_job_t *job = arg;
+
+    for (;;) {
+        pthread_mutex_lock(&job->lock);
+        while (!job->abort && job->next < job->chunks && job->next >= job->written + job->window) {
+            pthread_cond_wait(&job->slot_free, &job->lock);
+        }
+        if (job->abort || job->next >= job->chunks) {
+            pthread_mutex_unlock(&job->lock);
+            return NULL;
+        }
+        size_t chunk = job->next++;
+        pthread_mutex_unlock(&job->lock);
+
+        convert_slot_t *slot = &job->slots[chunk % job->window];
+        memset(&slot->stats, 0, sizeof(slot->stats));
+        slot->out.len = 0;
+        uts_convert_block(job->t, job->data + job->bounds[chunk],
+                          job->bounds[chunk + 1] - job->bounds[chunk], &slot->out, &slot->stats);
+
+        pthread_mutex_lock(&job->lock);
+        slot->done = true;
+        pthread_cond_broadcast(&job->slot_ready);
+        pthread_mutex_unlock(&job->lock);
+    }
+}
+
+/* Splits [0, len) into pieces of about UTS_CONVERT_CHUNK bytes that end just after a newline. */
+static size_t *split_chunks(const char *data, size_t len, size_t *count) {
+    size_t max = len / UTS_CONVERT_CHUNK + 2;
+    size_t *bounds = malloc(max * sizeof(*bounds));
+    size_t n = 0;
+
+    if (bounds == NULL) {
+        return NULL;
+    }
+
+    bounds[0] = 0;
+    while (bounds[n] < len) {
+        size_t end = bounds[n] + UTS_CONVERT_CHUNK;
+        if (end >= len) {
+            end = len;
+        } else {
+            const char *nl = memchr(data + end, '\n', len - end);
+            end = nl != NULL ? (size_t)(nl - data) + 1 : len;
+        }
+        bounds[++n] = end;
+    }
+
+    *count = n;
+    return bounds;
+}
+
+/* Returns the CLOCK_MONOTONIC time in seconds. */
+static double elapsed_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/* Writes n bytes to fd, retrying short writes. */
+static bool write_all(int fd, const char *src, size_t n) {
+    while (n > 0) {
+        ssize_t w = write(fd, src, n);
+        if (w < 0 && errno == EINTR) {
+            continue;
+        }
+        if (w <= 0) {
+            return false;
+        }
+        src += w;
+        n -= (size_t)w;
+    }
+    return true;
+}
+
+/* Adds a chunk's counters to the totals, shifting its line numbers by the lines before it. */
+static void merge_stats(uts_stream_stats_t *total, const uts_stream_stats_t *chunk) {
+    for (size_t i = 0; i < chunk->reported && total->reported < UTS_REPORTED_ERRORS; i++) {
+        total->error_lines[total->reported] = total->lines + chunk->error_lines[i];
+        total->error_codes[total->reported] = chunk->error_codes[i];
+        total->reported++;
+    }
+    total->lines += chunk->lines;
+    total->errors += chunk->errors;
+}
+
+/* Converts the mapped input with a pool of workers and writes the chunks in order;
+   reports in *used how many workers actually ran. */
+static bool convert_mapped(const uts_transform_t *t, const char *data, size_t len, int out_fd,
+                           unsigned threads, unsigned *used, uts_stream_stats_t *stats) {
+    convert_job_t job;
+    size_t chunks = 0;
+    size_t *bounds = split_chunks(data, len, &chunks);
+    bool ok = bounds != NULL;
+
+    if (threads > chunks) {
+        threads = chunks > 0 ? (unsigned)chunks : 1;
+    }
+
+    memset(&job, 0, sizeof(job));
+    job.t = t;
+    job.data = data;
+    job.bounds = bounds;
+    job.chunks = ok ? chunks : 0;
+    job.window = (size_t)threads * UTS_SLOTS_PER_THREAD;
+    job.slots = calloc(job.window, sizeof(*job.slots));
+    ok = ok && job.slots != NULL;
+
+    for (size_t i = 0; ok && i < job.window; i++) {
+        ok = uts_writer_init(&job.slots[i].out, UTS_SLOT_INITIAL, -1);
+    }
+    if (!ok) {
+        fprintf(stderr, "uts-cli: out of memory\n");
+        job.chunks = 0;
+    }
+
+    pthread_mutex_init(&job.lock, NULL);
+    pthread_cond_init(&job.slot_ready, NULL);
+    pthread_cond_init(&job.slot_free, NULL);
+
+    pthread_t *workers = calloc(threads, sizeof(*workers));
+    unsigned started = 0;
+    while (job.chunks > 0 && workers != NULL && started < threads &&
+           pthread_create(&workers[started], NULL, convert_worker, &job) == 0) {
+        started++;
+    }
+    if (job.chunks > 0 && started == 0) {
+        fprintf(stderr, "uts-cli: could not start worker threads\n");
+        ok = false;
+    }
+
+    for (size_t i = 0; ok && i < job.chunks; i++) {
+        convert_slot_t *slot = &job.slots[i % job.window];
+
+        pthread_mutex_lock(&job.lock);
+        while (!slot->done) {
+            pthread_cond_wait(&job.slot_ready, &job.lock);
+        }
+        pthread_mutex_unlock(&job.lock);
+
+        if (slot->out.failed) {
+            fprintf(stderr, "uts-cli: out of memory\n");
+            ok = false;
+        } else if (!write_all(out_fd, slot->out.data, slot->out.len)) {
+            fprintf(stderr, "uts-cli: I/O error: %s\n", strerror(errno));
+            ok = false;
+        }
+        merge_stats(stats, &slot->stats);
+
+        pthread_mutex_lock(&job.lock);
+        slot->done = false;
+        job.written++;
+        job.abort = !ok;
+        pthread_cond_broadcast(&job.slot_free);
+        pthread_mutex_unlock(&job.lock);
+    }
+
+    for (unsigned i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    *used = started;
+
+    pthread_cond_destroy(&job.slot_free);
+    pthread_cond_destroy(&job.slot_ready);
+    pthread_mutex_destroy(&job.lock);
+    for (size_t i = 0; job.slots != NULL && i < job.window; i++) {
+        uts_writer_free(&job.slots[i].out);
+    }
+    free(job.slots);
+    free(workers);
+    free(bounds);
+    return ok;
+}
+
+/**
+ * @brief Convert every line of input into output using worker threads.
+ */
+
+int uts_convert_file(const uts_transform_t *t, const char *input, const char *output,
+                     unsigned threads, uts_stream_stats_t *stats) {
+    uts_stream_stats_t local;
+    struct stat st;
+
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+
+    int in_fd = open(input, O_RDONLY);
+    if (in_fd < 0 || fstat(in_fd, &st) != 0) {
+        fprintf(stderr, "uts-cli: cannot read '%s': %s\n", input, strerror(errno));
+        if (in_fd >= 0) {
+            close(in_fd);
+        }
+        return 2;
+    }
+    if (!S_ISREG(st.st_mode)) {
+        fprintf(stderr, "uts-cli: cannot read '%s': not a regular file\n", input);
+        close(in_fd);
+        return 2;
+    }
+
+    int out_fd = STDOUT_FILENO;
+    if (output != NULL) {
+        out_fd = open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (out_fd < 0) {
+            fprintf(stderr, "uts-cli: cannot write '%s': %s\n", output, strerror(errno));
+            close(in_fd);
+            return 2;
+        }
+    }
+
+    if (threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (unsigned)cpus : 1;
+    }
+
+    size_t len = (size_t)st.st_size;
+    const char *data = NULL;
+    if (len > 0) {
+        data = mmap(NULL, len, PROT_READ, MAP_PRIVATE, in_fd, 0);
+        if (data == MAP_FAILED) {
+            fprintf(stderr, "uts-cli: cannot map '%s': %s\n", input, strerror(errno));
+            close(in_fd);
+            if (output != NULL) {
+                close(out_fd);
+            }
+            return 2;
+        }
+#if defined(POSIX_MADV_SEQUENTIAL)
+        posix_madvise((void *)data, len, POSIX_MADV_SEQUENTIAL);
+#endif
+    }
+
+    double start = elapsed_seconds();
+    unsigned used = 0;
+    bool ok = convert_mapped(t, data, len, out_fd, threads, &used, stats);
+    double seconds = elapsed_seconds() - start;
+
+    if (data != NULL) {
+        munmap((void *)data, len);
+    }
+    close(in_fd);
+    if (output != NULL && close(out_fd) != 0 && ok) {
+        fprintf(stderr, "uts-cli: I/O error: %s\n", strerror(errno));
+        ok = false;
+    }
+
+    uts_report_errors(stats, 0);
+    if (stats->errors > stats->reported) {
+        fprintf(stderr, "uts-cli: %zu further errors not shown\n", stats->errors - stats->reported);
+    }
+    fprintf(stderr, "uts-cli: %zu lines in %.3f s (%.0f lines/s, %u threads), %zu errors\n",
+            stats->lines, seconds, seconds > 0 ? (double)stats->lines / seconds : 0.0,
+            used, stats->errors);
+
+    if (!ok) {
+        return 2;
+    }
+    return stats->errors > 0 ? 1 : 0;
+}
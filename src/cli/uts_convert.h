@@ -0,0 +1,30 @@
+/**
+ * @file uts_convert.h
+ * @brief Multithreaded file conversion for "uts-cli convert".
+ */
+
+#ifndef UTS_CONVERT_H
+#define UTS_CONVERT_H
+
+#include "uts_stream.h"
+
+/**
+ * @brief Convert every line of input into output using worker threads.
+ *
+ * The input is memory-mapped and split into newline-aligned chunks that
+ * workers convert with uts_convert_block(); chunks are written in input
+ * order, and only a small window of converted chunks is held at once.
+ * Throughput and the error count are reported on stderr.
+ *
+ * @param t Conversion to apply
+ * @param input Path of a regular file
+ * @param output Path to write, or NULL for stdout
+ * @param threads Worker count; 0 uses one per online CPU
+ * @param stats Optional destination for line and error counts
+ * @return 0 on success, 1 if any line failed to convert, 2 on I/O error
+ */
+
+int uts_convert_file(const uts_transform_t *t, const char *input, const char *output,
+                     unsigned threads, uts_stream_stats_t *stats);
+
+#endif
@@ -0,0 +1,421 @@
+/**
+ * @file uts_stream.c
+ * @brief Buffered line conversion for the uts-cli streaming commands.
+ */
+
+#include "uts_stream.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define UTS_READ_CHUNK (1u << 20)
+#define UTS_INT64_DIGITS 20
+#define UTS_BLOCK_LINES 512
+
+/* Grows or flushes w so that n more bytes fit; returns false on failure. */
+static bool writer_reserve(uts_writer_t *w, size_t n) {
+    if (w->len + n <= w->cap) {
+        return true;
+    }
+    if (w->fd >= 0) {
+        uts_writer_flush(w);
+        if (w->len + n <= w->cap) {
+            return !w->failed;
+        }
+    }
+
+    size_t cap = w->cap * 2;
+    while (cap < w->len + n) {
+        cap *= 2;
+    }
+    char *data = realloc(w->data, cap);
+    if (data == NULL) {
+        w->failed = true;
+        return false;
+    }
+    w->data = data;
+    w->cap = cap;
+    return true;
+}
+
+/* Appends n bytes to w. */
+static void writer_put(uts_writer_t *w, const char *src, size_t n) {
+    if (writer_reserve(w, n)) {
+        memcpy(w->data + w->len, src, n);
+        w->len += n;
+    }
+}
+
+/**
+ * @brief Initialize a writer with cap bytes of storage.
+ */
+
+bool uts_writer_init(uts_writer_t *w, size_t cap, int fd) {
+    w->data = malloc(cap);
+    w->len = 0;
+    w->cap = cap;
+    w->fd = fd;
+    w->failed = w->data == NULL;
+    return !w->failed;
+}
+
+/**
+ * @brief Write out any buffered bytes (no-op for in-memory writers).
+ */
+
+void uts_writer_flush(uts_writer_t *w) {
+    if (w->fd < 0) {
+        return;
+    }
+
+    size_t done = 0;
+    while (done < w->len && !w->failed) {
+        ssize_t n = write(w->fd, w->data + done, w->len - done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            w->failed = true;
+            break;
+        }
+        done += (size_t)n;
+    }
+    w->len = 0;
+}
+
+/**
+ * @brief Flush and release the writer's buffer.
+ */
+
+void uts_writer_free(uts_writer_t *w) {
+    uts_writer_flush(w);
+    free(w->data);
+    w->data = NULL;
+    w->cap = 0;
+}
+
+/* Parses an optionally negative decimal int64; returns false on junk or overflow. */
+static bool parse_int64(const char *s, size_t len, int64_t *out) {
+    size_t i = 0;
+    bool negative = len > 0 && s[0] == '-';
+    i += negative;
+    if (i == len) {
+        return false;
+    }
+
+    uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    uint64_t value = 0;
+    for (; i < len; i++) {
+        unsigned digit = (unsigned)(s[i] - '0');
+        if (digit > 9 || value > (limit - digit) / 10) {
+            return false;
+        }
+        value = value * 10 + digit;
+    }
+
+    *out = negative ? (int64_t)(0 - value) : (int64_t)value;
+    return true;
+}
+
+/* Writes value in decimal to dst and returns the number of characters. */
+static size_t render_int64(int64_t value, char *dst) {
+    char tmp[UTS_INT64_DIGITS];
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    size_t n = 0;
+
+    do {
+        tmp[n++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    size_t pos = 0;
+    if (value < 0) {
+        dst[pos++] = '-';
+    }
+    while (n > 0) {
+        dst[pos++] = tmp[--n];
+    }
+    return pos;
+}
+
+/* Converts an ISO-8601, RFC 3339 or epoch value to decimal nanoseconds in w. */
+static ut_error_t put_nanos(const char *s, size_t len, uts_writer_t *w) {
+    ut_timestamp_t ts;
+    ut_error_t err = ut_parse_strict_n(s, len, &ts);
+    if (err != UT_OK) {
+        err = ut_parse_flexible(s, len, UT_FLEX_ALL, &ts, NULL);
+    }
+    if (err != UT_OK || !writer_reserve(w, UTS_INT64_DIGITS + 1)) {
+        return err;
+    }
+
+    w->len += render_int64(ts.nanos, w->data + w->len);
+    return UT_OK;
+}
+
+/* Converts a decimal nanosecond value to ISO-8601 in w. */
+static ut_error_t put_iso(const char *s, size_t len, uts_writer_t *w) {
+    int64_t nanos;
+    if (!parse_int64(s, len, &nanos)) {
+        return UT_ERR_INVALID_FORMAT;
+    }
+    if (!writer_reserve(w, UT_MAX_STRING_LEN)) {
+        return UT_OK;
+    }
+
+    int n = ut_format_cached(ut_from_unix_nanos(nanos), w->data + w->len, UT_MAX_STRING_LEN, true);
+    w->len += n > 0 ? (size_t)n : 0;
+    return UT_OK;
+}
+
+/* Rewrites the selected field of a delimited line, copying the line unchanged on failure. */
+static ut_error_t rewrite_field(const uts_transform_t *t, const char *line, size_t len,
+                                uts_writer_t *w) {
+    const char *end = line + len;
+    const char *start = line;
+
+    for (size_t i = 1; i < t->field; i++) {
+        const char *next = memchr(start, t->delim, (size_t)(end - start));
+        if (next == NULL) {
+            writer_put(w, line, len);
+            return UT_ERR_INVALID_FORMAT;
+        }
+        start = next + 1;
+    }
+
+    const char *stop = memchr(start, t->delim, (size_t)(end - start));
+    if (stop == NULL) {
+        stop = end;
+    }
+
+    writer_put(w, line, (size_t)(start - line));
+    size_t mark = w->len;
+    ut_error_t err = t->to_iso ? put_iso(start, (size_t)(stop - start), w)
+                               : put_nanos(start, (size_t)(stop - start), w);
+    if (err != UT_OK) {
+        w->len = mark;
+        writer_put(w, start, (size_t)(stop - start));
+    }
+    writer_put(w, stop, (size_t)(end - stop));
+    return err;
+}
+
+/**
+ * @brief Convert one line (without its newline) and append it plus '\n' to w.
+ */
+
+ut_error_t uts_transform_line(const uts_transform_t *t, const char *line, size_t len,
+                              uts_writer_t *w) {
+    bool crlf = len > 0 && line[len - 1] == '\r';
+    len -= crlf;
+
+    ut_error_t err;
+    switch (t->mode) {
+        case UTS_MODE_PARSE:  err = put_nanos(line, len, w); break;
+        case UTS_MODE_FORMAT: err = put_iso(line, len, w); break;
+        default:              err = rewrite_field(t, line, len, w); break;
+    }
+
+    writer_put(w, crlf ? "\r\n" : "\n", crlf ? 2 : 1);
+    return err;
+}
+
+/* Records a failure at the given 1-based line number. */
+static void record_error(uts_stream_stats_t *stats, size_t line, ut_error_t err) {
+    if (stats->reported < UTS_REPORTED_ERRORS) {
+        stats->error_lines[stats->reported] = line;
+        stats->error_codes[stats->reported] = err;
+        stats->reported++;
+    }
+    stats->errors++;
+}
+
+/* Appends one line ending, matching the input's. */
+static void put_eol(uts_writer_t *w, bool crlf) {
+    writer_put(w, crlf ? "\r\n" : "\n", crlf ? 2 : 1);
+}
+
+/* Parses a block of whole-line ISO-8601 values with ut_parse_batch(), retrying failures with the flexible parser. */
+static void parse_block(const char *const *strs, const size_t *lens, const bool *crlf, size_t n,
+                        uts_writer_t *w, uts_stream_stats_t *stats) {
+    ut_timestamp_t ts[UTS_BLOCK_LINES];
+    ut_error_t errs[UTS_BLOCK_LINES];
+
+    ut_parse_batch(strs, lens, n, ts, errs, true);
+
+    for (size_t i = 0; i < n; i++) {
+        if (errs[i] != UT_OK) {
+            errs[i] = ut_parse_flexible(strs[i], lens[i], UT_FLEX_ALL, &ts[i], NULL);
+        }
+        if (errs[i] == UT_OK && writer_reserve(w, UTS_INT64_DIGITS + 1)) {
+            w->len += render_int64(ts[i].nanos, w->data + w->len);
+        } else if (errs[i] != UT_OK) {
+            record_error(stats, stats->lines + i + 1, errs[i]);
+        }
+        put_eol(w, crlf[i]);
+    }
+}
+
+/* Formats a block of whole-line nanosecond values with ut_format_batch_packed(). */
+static void format_block(const char *const *strs, const size_t *lens, const bool *crlf, size_t n,
+                         uts_writer_t *w, uts_stream_stats_t *stats) {
+    ut_timestamp_t ts[UTS_BLOCK_LINES];
+    bool ok[UTS_BLOCK_LINES];
+    size_t offsets[UTS_BLOCK_LINES + 1];
+    char text[UTS_BLOCK_LINES * (UT_MAX_STRING_LEN - 1)];
+
+    for (size_t i = 0; i < n; i++) {
+        ok[i] = parse_int64(strs[i], lens[i], &ts[i].nanos);
+        if (!ok[i]) {
+            ts[i].nanos = 0;
+            record_error(stats, stats->lines + i + 1, UT_ERR_INVALID_FORMAT);
+        }
+    }
+
+    ut_format_batch_packed(ts, n, text, sizeof(text), '\n', true, offsets, NULL);
+
+    for (size_t i = 0; i < n; i++) {
+        if (ok[i]) {
+            writer_put(w, text + offsets[i], offsets[i + 1] - offsets[i] - 1);
+        }
+        put_eol(w, crlf[i]);
+    }
+}
+
+/**
+ * @brief Convert every newline-delimited line of a buffer and append it to w.
+ */
+
+void uts_convert_block(const uts_transform_t *t, const char *data, size_t len,
+                       uts_writer_t *w, uts_stream_stats_t *stats) {
+    const char *strs[UTS_BLOCK_LINES];
+    size_t lens[UTS_BLOCK_LINES];
+    bool crlf[UTS_BLOCK_LINES];
+    size_t pos = 0;
+
+    while (pos < len) {
+        size_t n = 0;
+
+        while (n < UTS_BLOCK_LINES && pos < len) {
+            const char *nl = memchr(data + pos, '\n', len - pos);
+            size_t end = nl != NULL ? (size_t)(nl - data) : len;
+            size_t line_len = end - pos;
+
+            crlf[n] = line_len > 0 && data[end - 1] == '\r';
+            strs[n] = data + pos;
+            lens[n] = line_len - crlf[n];
+            n++;
+            pos = end + 1;
+        }
+
+        if (t->mode == UTS_MODE_PARSE) {
+            parse_block(strs, lens, crlf, n, w, stats);
+        } else if (t->mode == UTS_MODE_FORMAT) {
+            format_block(strs, lens, crlf, n, w, stats);
+        } else {
+            for (size_t i = 0; i < n; i++) {
+                ut_error_t err = rewrite_field(t, strs[i], lens[i], w);
+                if (err != UT_OK) {
+                    record_error(stats, stats->lines + i + 1, err);
+                }
+                put_eol(w, crlf[i]);
+            }
+        }
+
+        stats->lines += n;
+    }
+}
+
+/**
+ * @brief Print the recorded failures from index first onward on stderr.
+ */
+
+void uts_report_errors(const uts_stream_stats_t *stats, size_t first) {
+    for (size_t i = first; i < stats->reported; i++) {
+        fprintf(stderr, "uts-cli: line %zu: %s\n", stats->error_lines[i], ut_error_string(stats->error_codes[i]));
+    }
+}
+
+/**
+ * @brief Apply t to every newline-delimited line read from in_fd.
+ */
+
+int uts_stream_run(const uts_transform_t *t, int in_fd, int out_fd, uts_stream_stats_t *stats) {
+    uts_stream_stats_t local;
+    uts_writer_t w;
+    size_t cap = UTS_READ_CHUNK;
+    size_t have = 0;
+    size_t shown = 0;
+    char *buf = malloc(cap);
+
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    if (buf == NULL || !uts_writer_init(&w, UTS_READ_CHUNK + UTS_READ_CHUNK / 2, out_fd)) {
+        free(buf);
+        fprintf(stderr, "uts-cli: out of memory\n");
+        return 2;
+    }
+
+    bool eof = false;
+    bool io_error = false;
+
+    while (!eof) {
+        ssize_t n = read(in_fd, buf + have, cap - have);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0) {
+            io_error = true;
+            break;
+        }
+        eof = n == 0;
+        have += (size_t)n;
+
+        size_t start = have;
+        if (!eof) {
+            const char *last = buf + have;
+            while (last > buf && last[-1] != '\n') {
+                last--;
+            }
+            start = (size_t)(last - buf);
+        }
+
+        uts_convert_block(t, buf, start, &w, stats);
+        uts_report_errors(stats, shown);
+        shown = stats->reported;
+
+        memmove(buf, buf + start, have - start);
+        have -= start;
+        if (have == cap) {
+            char *grown = realloc(buf, cap * 2);
+            if (grown == NULL) {
+                io_error = true;
+                break;
+            }
+            buf = grown;
+            cap *= 2;
+        }
+
+        uts_writer_flush(&w);
+        if (w.failed) {
+            io_error = true;
+            break;
+        }
+    }
+
+    uts_writer_free(&w);
+    free(buf);
+
+    if (io_error || w.failed) {
+        fprintf(stderr, "uts-cli: I/O error: %s\n", strerror(errno));
+        return 2;
+    }
+    if (stats->errors > stats->reported) {
+        fprintf(stderr, "uts-cli: %zu further errors not shown\n", stats->errors - stats->reported);
+    }
+    return stats->errors > 0 ? 1 : 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file uts_stream.h
+ * @brief Line-oriented timestamp conversion used by the uts-cli streaming commands.
+ */
+
+#ifndef UTS_STREAM_H
+#define UTS_STREAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <universal_timestamp.h>
+
+/**
+ * @brief What a transform does to each line.
+ */
+
+typedef enum {
+    UTS_MODE_PARSE,     /**< ISO-8601 line -> nanoseconds */
+    UTS_MODE_FORMAT,    /**< Nanoseconds line -> ISO-8601 */
+    UTS_MODE_REWRITE    /**< Convert one delimited field, copy the rest */
+} uts_mode_t;
+
+/**
+ * @brief One line-level conversion, as selected on the command line.
+ */
+
+typedef struct {
+    uts_mode_t mode;
+    bool to_iso;        /**< rewrite: field holds nanoseconds and becomes ISO-8601 */
+    size_t field;       /**< rewrite: 1-based field number */
+    char delim;         /**< rewrite: field separator */
+} uts_transform_t;
+
+/**
+ * @brief Growable output buffer that flushes to fd when one is attached.
+ */
+
+typedef struct {
+    char *data;
+    size_t len;
+    size_t cap;
+    int fd;             /**< Destination descriptor, or -1 to grow in memory */
+    bool failed;        /**< Set on allocation or write failure */
+} uts_writer_t;
+
+/**
+ * @brief Number of failing lines whose position is kept for reporting.
+ */
+
+#define UTS_REPORTED_ERRORS 10
+
+/**
+ * @brief Counters collected while converting.
+ */
+
+typedef struct {
+    size_t lines;                                   /**< Lines processed */
+    size_t errors;                                  /**< Lines whose value could not be converted */
+    size_t reported;                                /**< Entries used in error_lines */
+    size_t error_lines[UTS_REPORTED_ERRORS];        /**< 1-based line numbers of the first failures */
+    ut_error_t error_codes[UTS_REPORTED_ERRORS];    /**< Matching error codes */
+} uts_stream_stats_t;
+
+/**
+ * @brief Initialize a writer with cap bytes of storage.
+ * @return false if the buffer could not be allocated.
+ */
+
+bool uts_writer_init(uts_writer_t *w, size_t cap, int fd);
+
+/**
+ * @brief Write out any buffered bytes (no-op for in-memory writers).
+ */
+
+void uts_writer_flush(uts_writer_t *w);
+
+/**
+ * @brief Flush and release the writer's buffer.
+ */
+
+void uts_writer_free(uts_writer_t *w);
+
+/**
+ * @brief Convert one line (without its newline) and append it plus '\n' to w.
+ *
+ * A trailing '\r' is ignored for conversion and kept in the output, so
+ * CRLF input stays CRLF.
+ *
+ * parse and format write an empty line for input they cannot convert;
+ * rewrite copies such lines through unchanged. Either way the line count
+ * of the output matches the input.
+ *
+ * @return UT_OK, or the error that prevented conversion.
+ */
+
+ut_error_t uts_transform_line(const uts_transform_t *t, const char *line, size_t len,
+                              uts_writer_t *w);
+
+/**
+ * @brief Convert every newline-delimited line of a buffer and append it to w.
+ *
+ * Lines are handed to ut_parse_batch() or ut_format_batch_packed() a block
+ * at a time; rewrite converts field by field. A final line without a
+ * newline is converted too. Line numbers recorded in stats continue from
+ * stats->lines, so one stats object can span consecutive buffers.
+ */
+
+void uts_convert_block(const uts_transform_t *t, const char *data, size_t len,
+                       uts_writer_t *w, uts_stream_stats_t *stats);
+
+/**
+ * @brief Print the recorded failures from index first onward on stderr.
+ */
+
+void uts_report_errors(const uts_stream_stats_t *stats, size_t first);
+
+/**
+ * @brief Apply t to every newline-delimited line read from in_fd.
+ *
+ * Reads in large chunks and writes the converted output once per chunk,
+ * so throughput is bounded by conversion rather than system calls while
+ * interactive pipes still see output promptly. The first few failing
+ * lines are reported on stderr.
+ *
+ * @return 0 on success, 1 if any line failed, 2 on an I/O error.
+ */
+
+int uts_stream_run(const uts_transform_t *t, int in_fd, int out_fd, uts_stream_stats_t *stats);
+
+#endif /* UTS_STREAM_H */
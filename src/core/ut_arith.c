@@ -0,0 +1,70 @@
+/**
+ * Overflow-aware 64-bit arithmetic shared by the duration and truncation APIs.
+ */
+
+#include "ut_internal.h"
+
+/* Returns the length of a fixed-size unit in nanoseconds, 0 for calendar units and 1 for unknown units. */
+int64_t ut_internal_unit_nanos(ut_unit_t unit) {
+    switch (unit) {
+        case UT_UNIT_MICROSECOND: return 1000LL;
+        case UT_UNIT_MILLISECOND: return 1000000LL;
+        case UT_UNIT_SECOND:      return 1000000000LL;
+        case UT_UNIT_MINUTE:      return 60000000000LL;
+        case UT_UNIT_HOUR:        return 3600000000000LL;
+        case UT_UNIT_DAY:         return 86400000000000LL;
+        case UT_UNIT_WEEK:        return 604800000000000LL;
+        case UT_UNIT_MONTH:
+        case UT_UNIT_YEAR:        return 0;
+        default:                  return 1;
+    }
+}
+
+/* Returns true if a + b does not fit in int64_t. */
+bool ut_internal_add_overflows(int64_t a, int64_t b) {
+    return (b > 0 && a > INT64_MAX - b) || (b < 0 && a < INT64_MIN - b);
+}
+
+/* Returns true if a - b does not fit in int64_t. */
+bool ut_internal_sub_overflows(int64_t a, int64_t b) {
+    return (b < 0 && a > INT64_MAX + b) || (b > 0 && a < INT64_MIN + b);
+}
+
+/* Returns a + b clamped to [INT64_MIN, INT64_MAX]. */
+int64_t ut_internal_saturating_add(int64_t a, int64_t b) {
+    if (ut_internal_add_overflows(a, b)) {
+        return b > 0 ? INT64_MAX : INT64_MIN;
+    }
+    return a + b;
+}
+
+/* Returns a - b clamped to [INT64_MIN, INT64_MAX]. */
+int64_t ut_internal_saturating_sub(int64_t a, int64_t b) {
+    if (ut_internal_sub_overflows(a, b)) {
+        return b < 0 ? INT64_MAX : INT64_MIN;
+    }
+    return a - b;
+}
+
+/* Returns a * b clamped to [INT64_MIN, INT64_MAX] for a positive b. */
+int64_t ut_internal_saturating_mul(int64_t a, int64_t b) {
+    if (a > INT64_MAX / b) {
+        return INT64_MAX;
+    }
+    if (a < INT64_MIN / b) {
+        return INT64_MIN;
+    }
+    return a * b;
+}
+
+/* Rounds value toward negative infinity to a multiple of a positive step, clamping at INT64_MIN. */
+int64_t ut_internal_floor_to(int64_t value, int64_t step) {
+    int64_t rem = value % step;
+    if (rem < 0) {
+        if (value < INT64_MIN + (step + rem)) {
+            return INT64_MIN;
+        }
+        rem += step;
+    }
+    return value - rem;
+}
@@ -0,0 +1,159 @@
+/**
+ * Clock source backends behind ut_now() and ut_now_with().
+ */
+
+#include "ut_platform.h"
+#include "ut_internal.h"
+#include <stdatomic.h>
+
+static atomic_int g_default_source = ATOMIC_VAR_INIT(UT_CLOCK_PRECISE);
+
+/* Apple has no wall clock cheaper than CLOCK_REALTIME (its _APPROX clocks are monotonic),
+   so there, and wherever no coarse clock id exists, UT_CLOCK_COARSE reads the precise one. */
+#if defined(UT_PLATFORM_WINDOWS)
+    #define UT_HAS_COARSE_CLOCK 1
+#elif defined(UT_HAS_POSIX_CLOCK) && !defined(UT_PLATFORM_APPLE) && !defined(UT_PLATFORM_EMSCRIPTEN) && \
+      (defined(CLOCK_REALTIME_COARSE) || defined(CLOCK_REALTIME_FAST))
+    #define UT_HAS_COARSE_CLOCK 1
+#endif
+
+#if defined(UT_PLATFORM_WINDOWS)
+
+/* Converts a FILETIME (100 ns ticks since 1601) to nanoseconds since the Unix epoch. */
+static int64_t filetime_to_nanos(const FILETIME *ft) {
+    int64_t wintime = ((int64_t)ft->dwHighDateTime << 32) | ft->dwLowDateTime;
+    return (wintime - UT_WINDOWS_TO_UNIX_EPOCH * UT_WINDOWS_TICK) * 100LL;
+}
+
+#elif defined(UT_HAS_POSIX_CLOCK)
+
+/* Reads a POSIX clock as nanoseconds. */
+static int64_t read_posix(clockid_t id) {
+    struct timespec spec;
+    clock_gettime(id, &spec);
+    return (int64_t)spec.tv_sec * 1000000000LL + spec.tv_nsec;
+}
+
+#if defined(UT_HAS_COARSE_CLOCK)
+
+/* Returns the clock id backing the coarse source. */
+static clockid_t coarse_clock_id(void) {
+#if defined(CLOCK_REALTIME_COARSE)
+    return CLOCK_REALTIME_COARSE;
+#else
+    return CLOCK_REALTIME_FAST;
+#endif
+}
+
+#endif
+
+#endif
+
+/* Reads the full-precision wall clock in nanoseconds since epoch. */
+static int64_t read_precise(void) {
+#if defined(UT_PLATFORM_WINDOWS)
+    FILETIME ft;
+    GetSystemTimePreciseAsFileTime(&ft);
+    return filetime_to_nanos(&ft);
+#elif defined(UT_PLATFORM_EMSCRIPTEN)
+    double ms = emscripten_get_now();
+    return (int64_t)(ms * 1000000.0);
+#elif defined(UT_PLATFORM_APPLE)
+    return (int64_t)clock_gettime_nsec_np(CLOCK_REALTIME);
+#elif defined(UT_HAS_POSIX_CLOCK)
+    return read_posix(CLOCK_REALTIME);
+#else
+    return (int64_t)time(NULL) * 1000000000LL;
+#endif
+}
+
+/* Reads the cheapest available wall clock, updated at scheduler-tick granularity. */
+static int64_t read_coarse(void) {
+#if defined(UT_PLATFORM_WINDOWS)
+    FILETIME ft;
+    GetSystemTimeAsFileTime(&ft);
+    return filetime_to_nanos(&ft);
+#elif defined(UT_HAS_COARSE_CLOCK)
+    return read_posix(coarse_clock_id());
+#else
+    return read_precise();
+#endif
+}
+
+/* Maps a requested clock source to the one that will actually be read. */
+ut_clock_source_t ut_internal_clock_effective(ut_clock_source_t source) {
+    switch (source) {
+#if defined(UT_HAS_COARSE_CLOCK)
+        case UT_CLOCK_COARSE: return UT_CLOCK_COARSE;
+#endif
+        case UT_CLOCK_TSC:    return ut_internal_tsc_available() ? UT_CLOCK_TSC : UT_CLOCK_PRECISE;
+        case UT_CLOCK_SHARED: return ut_internal_shared_available() ? UT_CLOCK_SHARED : UT_CLOCK_PRECISE;
+        default:              return UT_CLOCK_PRECISE;
+    }
+}
+
+/* Reads the given clock source in nanoseconds since epoch. */
+int64_t ut_internal_clock_read(ut_clock_source_t source) {
+    switch (source) {
+        case UT_CLOCK_COARSE: return read_coarse();
+        case UT_CLOCK_TSC:    return ut_internal_tsc_now();
+        case UT_CLOCK_SHARED: return ut_internal_shared_now();
+        default:              return read_precise();
+    }
+}
+
+/* Reads the process-wide default clock source selected with ut_set_clock_source(). */
+int64_t ut_internal_clock_now(void) {
+    return ut_internal_clock_read(
+        (ut_clock_source_t)atomic_load_explicit(&g_default_source, memory_order_relaxed));
+}
+
+/* Returns the process-wide default clock source. */
+ut_clock_source_t ut_internal_clock_default(void) {
+    return (ut_clock_source_t)atomic_load_explicit(&g_default_source, memory_order_relaxed);
+}
+
+/* Sets the process-wide default clock source. */
+void ut_internal_clock_set_default(ut_clock_source_t source) {
+    atomic_store_explicit(&g_default_source, (int)source, memory_order_relaxed);
+}
+
+/* Returns the nominal tick of a clock source in nanoseconds, or 0 when unknown. */
+int64_t ut_internal_clock_resolution(ut_clock_source_t source) {
+    source = ut_internal_clock_effective(source);
+    if (source == UT_CLOCK_TSC) {
+        return ut_internal_tsc_resolution();
+    }
+    if (source == UT_CLOCK_SHARED) {
+        return ut_internal_shared_resolution();
+    }
+
+#if defined(UT_PLATFORM_WINDOWS)
+    if (source == UT_CLOCK_COARSE) {
+        DWORD adjustment, increment;
+        BOOL disabled;
+        if (GetSystemTimeAdjustment(&adjustment, &increment, &disabled)) {
+            return (int64_t)increment * 100LL;
+        }
+        return 0;
+    }
+    return 100;
+#elif defined(UT_PLATFORM_EMSCRIPTEN)
+    (void)source;
+    return 1000;
+#elif defined(UT_HAS_POSIX_CLOCK)
+    struct timespec res;
+#if defined(UT_HAS_COARSE_CLOCK)
+    clockid_t id = source == UT_CLOCK_COARSE ? coarse_clock_id() : CLOCK_REALTIME;
+#else
+    clockid_t id = CLOCK_REALTIME;
+#endif
+    if (clock_getres(id, &res) != 0) {
+        return 0;
+    }
+    return (int64_t)res.tv_sec * 1000000000LL + res.tv_nsec;
+#else
+    (void)source;
+    return 1000000000LL;
+#endif
+}
@@ -0,0 +1,161 @@
+/**
+ * One-time per-source clock capability probe behind ut_get_clock_info() and ut_get_clock_precision().
+ */
+
+#include "ut_platform.h"
+#include "ut_internal.h"
+#include <stdatomic.h>
+
+#if defined(UT_PLATFORM_WINDOWS)
+    #define UT_PROBE_YIELD() SwitchToThread()
+#elif defined(UT_HAS_POSIX_CLOCK)
+    #include <sched.h>
+    #define UT_PROBE_YIELD() sched_yield()
+#else
+    #define UT_PROBE_YIELD() ((void)0)
+#endif
+
+#define UT_PROBE_SOURCES (UT_CLOCK_SHARED + 1)
+#define UT_PROBE_COST_SAMPLES 1000
+#define UT_PROBE_DISTINCT 8
+#define UT_PROBE_BUDGET_NS 10000000LL
+
+/* PROBE_STALE marks a probe that was reset while running; its result is discarded. */
+enum {
+    PROBE_UNINIT = 0,
+    PROBE_RUNNING,
+    PROBE_STALE,
+    PROBE_READY
+};
+
+static atomic_int g_probe_state[UT_PROBE_SOURCES];
+static atomic_int g_probe_precision[UT_PROBE_SOURCES];
+static atomic_flag g_probe_lock[UT_PROBE_SOURCES] = {
+    ATOMIC_FLAG_INIT, ATOMIC_FLAG_INIT, ATOMIC_FLAG_INIT, ATOMIC_FLAG_INIT
+};
+static ut_clock_info_t g_probe_info[UT_PROBE_SOURCES];
+
+/* Returns the largest power of ten, up to one second, that divides a reading. */
+static int64_t granule_of(int64_t nanos) {
+    int64_t granule = 1;
+    while (granule < 1000000000LL && nanos % (granule * 10) == 0) {
+        granule *= 10;
+    }
+    return granule;
+}
+
+/* Maps a granule or tick in nanoseconds to a precision level. */
+static ut_precision_t precision_for(int64_t granule) {
+    if (granule >= 1000000000LL) return UT_PRECISION_SECOND;
+    if (granule >= 1000000) return UT_PRECISION_MILLISECOND;
+    if (granule >= 1000) return UT_PRECISION_MICROSECOND;
+    return UT_PRECISION_NANOSECOND;
+}
+
+/* Measures call cost, backward steps, smallest step and digit granularity of one source. */
+static void measure(ut_clock_source_t source, ut_clock_info_t *info) {
+    info->source = source;
+    info->effective = ut_internal_clock_effective(source);
+    info->resolution_ns = ut_internal_clock_resolution(source);
+
+    uint32_t backward = 0;
+    int64_t prev = ut_internal_clock_read(source);
+    int64_t start = ut_internal_clock_read(UT_CLOCK_PRECISE);
+    for (int i = 0; i < UT_PROBE_COST_SAMPLES; i++) {
+        int64_t cur = ut_internal_clock_read(source);
+        backward += cur < prev;
+        prev = cur;
+    }
+    int64_t elapsed = ut_internal_clock_read(UT_CLOCK_PRECISE) - start;
+    info->cost_ns = elapsed > 0 ? (double)elapsed / UT_PROBE_COST_SAMPLES : 0.0;
+
+    /* Granularity comes from distinct readings only, so a source that returns one
+       round value many times in a row is not mistaken for a coarser one. */
+    int64_t granule = granule_of(prev);
+    int64_t step = 0;
+    int distinct = 1;
+    int64_t deadline = start + elapsed + UT_PROBE_BUDGET_NS;
+    while (distinct < UT_PROBE_DISTINCT) {
+        int64_t cur = ut_internal_clock_read(source);
+        if (cur == prev) {
+            if (ut_internal_clock_read(UT_CLOCK_PRECISE) > deadline) {
+                break;
+            }
+            continue;
+        }
+        if (cur < prev) {
+            backward++;
+        } else if (step == 0 || cur - prev < step) {
+            step = cur - prev;
+        }
+        int64_t g = granule_of(cur);
+        granule = g < granule ? g : granule;
+        prev = cur;
+        distinct++;
+    }
+
+    info->step_ns = step;
+    info->regressions = backward;
+    info->precision = distinct > 1 || info->resolution_ns <= 0
+        ? precision_for(granule)
+        : precision_for(info->resolution_ns);
+}
+
+/* Copies a cached entry in or out under its lock, so a reader never sees a half-written one. */
+static void copy_entry(ut_clock_source_t source, ut_clock_info_t *dst, const ut_clock_info_t *src) {
+    while (atomic_flag_test_and_set_explicit(&g_probe_lock[source], memory_order_acquire)) {
+    }
+    *dst = *src;
+    atomic_flag_clear_explicit(&g_probe_lock[source], memory_order_release);
+}
+
+/* Waits until the source has a current probe, running it here if no other thread is. */
+static void ensure_probed(ut_clock_source_t source) {
+    atomic_int *state = &g_probe_state[source];
+    for (;;) {
+        int current = atomic_load_explicit(state, memory_order_acquire);
+        if (current == PROBE_READY) {
+            return;
+        }
+        if (current != PROBE_UNINIT ||
+            !atomic_compare_exchange_strong(state, &current, PROBE_RUNNING)) {
+            UT_PROBE_YIELD();
+            continue;
+        }
+
+        ut_clock_info_t info;
+        measure(source, &info);
+        copy_entry(source, &g_probe_info[source], &info);
+        atomic_store_explicit(&g_probe_precision[source], (int)info.precision, memory_order_relaxed);
+
+        int expected = PROBE_RUNNING;
+        if (!atomic_compare_exchange_strong(state, &expected, PROBE_READY)) {
+            atomic_store_explicit(state, PROBE_UNINIT, memory_order_release);
+        }
+    }
+}
+
+/* Copies the cached capability probe of a clock source, running it on first use. */
+void ut_internal_clock_probe(ut_clock_source_t source, ut_clock_info_t *out) {
+    ensure_probed(source);
+    copy_entry(source, out, &g_probe_info[source]);
+}
+
+/* Returns the cached precision of a clock source without copying the whole probe. */
+ut_precision_t ut_internal_clock_probe_precision(ut_clock_source_t source) {
+    ensure_probed(source);
+    return (ut_precision_t)atomic_load_explicit(&g_probe_precision[source], memory_order_relaxed);
+}
+
+/* Drops the cached probe of a clock source so the next lookup measures it again; a probe
+   still running is marked stale and discarded when it finishes. */
+void ut_internal_clock_probe_reset(ut_clock_source_t source) {
+    atomic_int *state = &g_probe_state[source];
+    int current = atomic_load_explicit(state, memory_order_acquire);
+    while (current == PROBE_READY || current == PROBE_RUNNING) {
+        int next = current == PROBE_READY ? PROBE_UNINIT : PROBE_STALE;
+        if (atomic_compare_exchange_weak(state, &current, next)) {
+            return;
+        }
+    }
+}
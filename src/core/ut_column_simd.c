@@ -0,0 +1,143 @@
+/**
+ * Varint decoders for the binary column: a BMI2 backend that works a 64-bit
+ * word at a time, and the scalar reference it falls back to.
+ */
+
+#include "ut_internal.h"
+#include <string.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define UT_SIMD_BMI2 1
+    #define UT_TARGET_BMI2 __attribute__((target("bmi,bmi2")))
+    #include <immintrin.h>
+#elif defined(_M_X64) && defined(_MSC_VER)
+    #define UT_SIMD_BMI2 1
+    #define UT_TARGET_BMI2
+    #include <intrin.h>
+    #include <immintrin.h>
+#endif
+
+#define UT_CONTINUATION_BITS 0x8080808080808080ULL
+#define UT_PAYLOAD_BITS 0x7F7F7F7F7F7F7F7FULL
+
+/* Inverse of the encoder's zig-zag mapping. */
+static uint64_t unzigzag(uint64_t u) {
+    return (u >> 1) ^ (0 - (u & 1));
+}
+
+/* Decodes one varint of up to ten bytes at in[*pos], or returns false if it is truncated or too long. */
+static bool get_varint_scalar(const uint8_t *in, size_t len, size_t *pos, uint64_t *value) {
+    uint64_t v = 0;
+    size_t p = *pos;
+
+    for (unsigned shift = 0; p < len && shift < 64; shift += 7) {
+        uint8_t byte = in[p++];
+        if (shift == 63 && byte > 1) {
+            return false;
+        }
+        v |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *pos = p;
+            *value = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+#if defined(UT_SIMD_BMI2)
+
+/* Returns true when the CPU has BMI2 and implements PEXT in hardware (not AMD before Zen 3). */
+static bool cpu_has_fast_pext(void) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    bool amd = info[1] == 0x68747541 && info[3] == 0x69746E65 && info[2] == 0x444D4163;
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    int family = ((info[0] >> 8) & 0xF) + ((info[0] >> 20) & 0xFF);
+    if (amd && family < 0x19) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 3)) != 0 && (info[1] & (1 << 8)) != 0;
+#else
+    return __builtin_cpu_supports("bmi2") && !__builtin_cpu_is("amdfam15h") &&
+           !__builtin_cpu_is("znver1") && !__builtin_cpu_is("znver2");
+#endif
+}
+
+/* Extracts every varint that ends inside each loaded word with one PEXT per value; stops at a longer value. */
+UT_TARGET_BMI2
+static size_t decode_words_bmi2(const uint8_t *in, size_t len, size_t *pos, uint64_t *prev,
+                                ut_timestamp_t *out, size_t capacity) {
+    size_t p = *pos;
+    size_t k = 0;
+    uint64_t value = *prev;
+
+    while (p + 8 <= len && k < capacity) {
+        uint64_t word;
+        memcpy(&word, in + p, sizeof(word));
+        uint64_t ends = ~word & UT_CONTINUATION_BITS;
+        if (ends == 0) {
+            break;
+        }
+
+        unsigned start = 0;
+        do {
+            unsigned last = (unsigned)_tzcnt_u64(ends);
+            uint64_t bits = last == 63 ? word : _bzhi_u64(word, last + 1);
+            value += unzigzag(_pext_u64(bits >> start, UT_PAYLOAD_BITS));
+            out[k++].nanos = (int64_t)value;
+            start = last + 1;
+            ends = _blsr_u64(ends);
+        } while (ends != 0 && k < capacity);
+        p += start / 8;
+    }
+
+    *pos = p;
+    *prev = value;
+    return k;
+}
+
+#endif
+
+/* Decodes the column body in[pos..len) with the best available backend; *count receives the values written. */
+ut_error_t ut_internal_column_decode(const uint8_t *in, size_t len, size_t pos,
+                                     ut_timestamp_t *out, size_t capacity, size_t *count) {
+    size_t k = 0;
+    uint64_t prev = 0;
+    ut_error_t err = UT_OK;
+
+#if defined(UT_SIMD_BMI2)
+    bool fast = cpu_has_fast_pext();
+#endif
+
+    while (pos < len) {
+#if defined(UT_SIMD_BMI2)
+        if (fast) {
+            k += decode_words_bmi2(in, len, &pos, &prev, out + k, capacity - k);
+            if (pos == len) {
+                break;
+            }
+        }
+#endif
+        if (k == capacity) {
+            err = UT_ERR_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        uint64_t u;
+        if (!get_varint_scalar(in, len, &pos, &u)) {
+            err = UT_ERR_INVALID_FORMAT;
+            break;
+        }
+        prev += unzigzag(u);
+        out[k++].nanos = (int64_t)prev;
+    }
+
+    *count = k;
+    return err;
+}
@@ -30,33 +30,36 @@ bool ut_internal_validate_date(int year, int month, int day) {
     return true;
 }
 
-/* Days from epoch (1970-01-01) to given date. */
-static int64_t days_from_epoch(int year, int month, int day) {
-    int64_t days = 0;
-    
-    if (year >= 1970) {
-        for (int y = 1970; y < year; y++) {
-            days += ut_internal_is_leap_year(y) ? 366 : 365;
-        }
-    } else {
-        for (int y = year; y < 1970; y++) {
-            days -= ut_internal_is_leap_year(y) ? 366 : 365;
-        }
-    }
-    
-    for (int m = 1; m < month; m++) {
-        days += ut_internal_days_in_month(year, m);
-    }
-    
-    days += day - 1;
-    return days;
+/* Days from epoch (1970-01-01) to given proleptic Gregorian date. */
+int64_t ut_internal_days_from_civil(int year, int month, int day) {
+    int64_t y = (int64_t)year - (month <= 2);
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    int64_t yoe = y - era * 400;
+    int64_t mp = (month + 9) % 12;
+    int64_t doy = (153 * mp + 2) / 5 + day - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+/* Converts days since epoch (1970-01-01) to a proleptic Gregorian date. */
+void ut_internal_civil_from_days(int64_t days, int *year, int *month, int *day) {
+    int64_t z = days + 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    int64_t m = mp < 10 ? mp + 3 : mp - 9;
+    *year = (int)(yoe + era * 400 + (m <= 2));
+    *month = (int)m;
+    *day = (int)(doy - (153 * mp + 2) / 5 + 1);
 }
 
 /* Converts broken-down time to nanoseconds since epoch. */
 int64_t ut_internal_to_nanos(int year, int month, int day,
                               int hour, int minute, int second,
                               int64_t frac_nanos) {
-    int64_t days = days_from_epoch(year, month, day);
+    int64_t days = ut_internal_days_from_civil(year, month, day);
     int64_t seconds = days * SECONDS_PER_DAY
                       + (int64_t)hour * SECONDS_PER_HOUR
                       + (int64_t)minute * SECONDS_PER_MINUTE
@@ -64,11 +67,8 @@ int64_t ut_internal_to_nanos(int year, int month, int day,
     return seconds * NANOS_PER_SECOND + frac_nanos;
 }
 
-/* Converts nanoseconds since epoch to broken-down time. */
-void ut_internal_from_nanos(int64_t nanos,
-                             int *year, int *month, int *day,
-                             int *hour, int *minute, int *second,
-                             int *frac_nanos) {
+/* Splits nanoseconds since epoch into whole days, second of day and nanosecond of second. */
+void ut_internal_split_nanos(int64_t nanos, int64_t *days, int *day_seconds, int *frac_nanos) {
     int64_t total_seconds = nanos / NANOS_PER_SECOND;
     int64_t remaining_nanos = nanos % NANOS_PER_SECOND;
     
@@ -77,46 +77,74 @@ void ut_internal_from_nanos(int64_t nanos,
         total_seconds--;
     }
     
-    *frac_nanos = (int)remaining_nanos;
+    int64_t d = total_seconds / SECONDS_PER_DAY;
+    int64_t sod = total_seconds % SECONDS_PER_DAY;
     
-    int64_t days = total_seconds / SECONDS_PER_DAY;
-    int64_t day_seconds = total_seconds % SECONDS_PER_DAY;
-    
-    if (day_seconds < 0) {
-        day_seconds += SECONDS_PER_DAY;
-        days--;
+    if (sod < 0) {
+        sod += SECONDS_PER_DAY;
+        d--;
     }
     
-    *hour = (int)(day_seconds / SECONDS_PER_HOUR);
-    *minute = (int)((day_seconds % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE);
-    *second = (int)(day_seconds % SECONDS_PER_MINUTE);
+    *days = d;
+    *day_seconds = (int)sod;
+    *frac_nanos = (int)remaining_nanos;
+}
+
+/* Converts nanoseconds since epoch to broken-down time. */
+void ut_internal_from_nanos(int64_t nanos,
+                             int *year, int *month, int *day,
+                             int *hour, int *minute, int *second,
+                             int *frac_nanos) {
+    int64_t days;
+    int day_seconds;
+    ut_internal_split_nanos(nanos, &days, &day_seconds, frac_nanos);
     
-    int y = 1970;
-    if (days >= 0) {
-        while (1) {
-            int days_in_year = ut_internal_is_leap_year(y) ? 366 : 365;
-            if (days < days_in_year) break;
-            days -= days_in_year;
-            y++;
-        }
-    } else {
-        while (days < 0) {
-            y--;
-            int days_in_year = ut_internal_is_leap_year(y) ? 366 : 365;
-            days += days_in_year;
-        }
-    }
-    *year = y;
+    *hour = day_seconds / (int)SECONDS_PER_HOUR;
+    *minute = (day_seconds % (int)SECONDS_PER_HOUR) / (int)SECONDS_PER_MINUTE;
+    *second = day_seconds % (int)SECONDS_PER_MINUTE;
     
-    int m = 1;
-    while (1) {
-        int days_in_month = ut_internal_days_in_month(y, m);
-        if (days < days_in_month) break;
-        days -= days_in_month;
-        m++;
+    ut_internal_civil_from_days(days, year, month, day);
+}
+
+/* Returns the ISO day of week (0=Monday, 6=Sunday) of a day count since epoch. */
+static int64_t iso_weekday(int64_t days) {
+    int64_t dow = (days + 3) % 7;
+    return dow < 0 ? dow + 7 : dow;
+}
+
+/* Returns the day count of the Monday, first of the month or January 1st on or before days. */
+int64_t ut_internal_calendar_floor_days(int64_t days, ut_unit_t unit) {
+    if (unit == UT_UNIT_WEEK) {
+        return days - iso_weekday(days);
     }
-    *month = m;
-    *day = (int)days + 1;
+    if (unit != UT_UNIT_MONTH && unit != UT_UNIT_YEAR) {
+        return days;
+    }
+
+    int year, month, day;
+    ut_internal_civil_from_days(days, &year, &month, &day);
+    return ut_internal_days_from_civil(year, unit == UT_UNIT_MONTH ? month : 1, 1);
+}
+
+/* Converts a day count to nanoseconds, clamping to [INT64_MIN, INT64_MAX]. */
+int64_t ut_internal_days_to_nanos(int64_t days) {
+    const int64_t nanos_per_day = SECONDS_PER_DAY * NANOS_PER_SECOND;
+    return days < INT64_MIN / nanos_per_day ? INT64_MIN
+         : days > INT64_MAX / nanos_per_day ? INT64_MAX
+         : days * nanos_per_day;
+}
+
+/* Computes the ISO week date of a day count since epoch. */
+void ut_internal_iso_week_from_days(int64_t days, int *year, int *week, int *day) {
+    int64_t dow = iso_weekday(days);
+    int64_t thursday = days - dow + 3;
+
+    int y, m, d;
+    ut_internal_civil_from_days(thursday, &y, &m, &d);
+
+    *year = y;
+    *week = (int)((thursday - ut_internal_days_from_civil(y, 1, 1)) / 7) + 1;
+    *day = (int)dow + 1;
 }
 
 /* Parses an integer of exactly n digits. Returns -1 on error. */
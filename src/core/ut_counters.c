@@ -0,0 +1,145 @@
+/**
+ * Per-thread statistics slots behind ut_get_stats(), summed on read.
+ */
+
+#include "ut_platform.h"
+#include "ut_internal.h"
+#include <stdlib.h>
+
+#if defined(UT_ENABLE_STATS)
+
+#if defined(UT_HAS_POSIX_CLOCK) && !defined(UT_PLATFORM_WINDOWS)
+    #define UT_COUNTERS_POSIX 1
+    #include <pthread.h>
+#endif
+
+#define UT_CACHE_LINE 64
+
+/* One thread's counters; the owner is the only writer, so increments need no read-modify-write. */
+typedef struct ut_counter_slot {
+    atomic_uint_fast64_t counters[UT_STAT_COUNT];
+    struct ut_counter_slot *next;
+    atomic_bool in_use;
+    char pad[UT_CACHE_LINE];
+} ut_counter_slot_t;
+
+static ut_counter_slot_t g_static_slot;
+static _Atomic(ut_counter_slot_t *) g_slots = ATOMIC_VAR_INIT(&g_static_slot);
+static UT_THREAD_LOCAL ut_counter_slot_t *t_slot = NULL;
+
+static uint64_t g_baseline[UT_STAT_COUNT];
+static atomic_flag g_read_lock = ATOMIC_FLAG_INIT;
+
+#if defined(UT_COUNTERS_POSIX)
+
+static pthread_key_t g_exit_key;
+static pthread_once_t g_exit_once = PTHREAD_ONCE_INIT;
+
+/* Thread-exit destructor: hands the slot, and the counts in it, to the next new thread. */
+static void release_slot(void *slot) {
+    atomic_store_explicit(&((ut_counter_slot_t *)slot)->in_use, false, memory_order_release);
+}
+
+/* Creates the key whose destructor recycles slots. */
+static void create_exit_key(void) {
+    pthread_key_create(&g_exit_key, release_slot);
+}
+
+#endif
+
+/* Claims a free slot or links a new one; falls back to a shared slot if allocation fails. */
+static ut_counter_slot_t *attach_slot(void) {
+    ut_counter_slot_t *slot = atomic_load_explicit(&g_slots, memory_order_acquire);
+    for (; slot != NULL; slot = slot->next) {
+        bool expected = false;
+        if (atomic_compare_exchange_strong(&slot->in_use, &expected, true)) {
+            break;
+        }
+    }
+
+    if (slot == NULL) {
+        slot = calloc(1, sizeof(*slot));
+        if (slot == NULL) {
+            return &g_static_slot;
+        }
+        atomic_init(&slot->in_use, true);
+        for (int i = 0; i < UT_STAT_COUNT; i++) {
+            atomic_init(&slot->counters[i], 0);
+        }
+        ut_counter_slot_t *head = atomic_load_explicit(&g_slots, memory_order_relaxed);
+        do {
+            slot->next = head;
+        } while (!atomic_compare_exchange_weak_explicit(&g_slots, &head, slot,
+                                                        memory_order_release,
+                                                        memory_order_relaxed));
+    }
+
+#if defined(UT_COUNTERS_POSIX)
+    pthread_once(&g_exit_once, create_exit_key);
+    pthread_setspecific(g_exit_key, slot);
+#endif
+    return slot;
+}
+
+/* Adds n to one of the calling thread's counters. */
+void ut_internal_stats_add(int counter, uint64_t n) {
+    ut_counter_slot_t *slot = t_slot;
+    if (slot == NULL) {
+        slot = t_slot = attach_slot();
+    }
+    uint64_t value = atomic_load_explicit(&slot->counters[counter], memory_order_relaxed);
+    atomic_store_explicit(&slot->counters[counter], value + n, memory_order_relaxed);
+}
+
+/* Counts one parse result and returns it unchanged. */
+ut_error_t ut_internal_stats_parse(ut_error_t err) {
+    ut_internal_stats_add(UT_STAT_PARSE + (int)err, 1);
+    return err;
+}
+
+/* Sums every slot into totals. */
+static void sum_slots(uint64_t *totals) {
+    for (int i = 0; i < UT_STAT_COUNT; i++) {
+        totals[i] = 0;
+    }
+    ut_counter_slot_t *slot = atomic_load_explicit(&g_slots, memory_order_acquire);
+    for (; slot != NULL; slot = slot->next) {
+        for (int i = 0; i < UT_STAT_COUNT; i++) {
+            totals[i] += atomic_load_explicit(&slot->counters[i], memory_order_relaxed);
+        }
+    }
+}
+
+/* Sums every thread's counters since the last reset; returns false when statistics are compiled out. */
+bool ut_internal_stats_read(uint64_t *totals) {
+    while (atomic_flag_test_and_set_explicit(&g_read_lock, memory_order_acquire)) {
+    }
+    sum_slots(totals);
+    for (int i = 0; i < UT_STAT_COUNT; i++) {
+        totals[i] -= g_baseline[i];
+    }
+    atomic_flag_clear_explicit(&g_read_lock, memory_order_release);
+    return true;
+}
+
+/* Makes later reads count from the current totals. */
+void ut_internal_stats_reset(void) {
+    while (atomic_flag_test_and_set_explicit(&g_read_lock, memory_order_acquire)) {
+    }
+    sum_slots(g_baseline);
+    atomic_flag_clear_explicit(&g_read_lock, memory_order_release);
+}
+
+#else
+
+/* Sums every thread's counters since the last reset; returns false when statistics are compiled out. */
+bool ut_internal_stats_read(uint64_t *totals) {
+    (void)totals;
+    return false;
+}
+
+/* Makes later reads count from the current totals. */
+void ut_internal_stats_reset(void) {
+}
+
+#endif
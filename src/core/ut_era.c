@@ -0,0 +1,95 @@
+/**
+ * Japanese era table: built-in eras plus any registered at runtime.
+ */
+
+#include "ut_internal.h"
+#include <string.h>
+
+#define UT_ERA_NAME_MAX 24
+
+typedef struct {
+    int64_t start_nanos;
+    int start_year;
+    ut_japanese_era_t era;
+    char name[UT_ERA_NAME_MAX];
+} era_entry_t;
+
+/* Oldest first; start_nanos is 00:00 UTC on the first day of the era. */
+static era_entry_t g_eras[UT_JAPANESE_ERA_CAPACITY] = {
+    {-3216758400000000000LL, 1868, UT_ERA_MEIJI,  "Meiji"},
+    {-1812153600000000000LL, 1912, UT_ERA_TAISHO, "Taisho"},
+    {-1357603200000000000LL, 1926, UT_ERA_SHOWA,  "Showa"},
+    { 600220800000000000LL,  1989, UT_ERA_HEISEI, "Heisei"},
+    { 1556668800000000000LL, 2019, UT_ERA_REIWA,  "Reiwa"}
+};
+
+static atomic_size_t g_era_count = ATOMIC_VAR_INIT(5);
+static atomic_flag g_era_lock = ATOMIC_FLAG_INIT;
+
+/* Finds the era containing nanos, scanning from the newest; sets [*start, *end) to its span. */
+bool ut_internal_era_find(int64_t nanos, ut_japanese_era_t *era, int *start_year,
+                          int64_t *start, int64_t *end) {
+    size_t count = atomic_load_explicit(&g_era_count, memory_order_acquire);
+    int64_t next = INT64_MAX;
+
+    for (size_t i = count; i-- > 0;) {
+        if (nanos >= g_eras[i].start_nanos) {
+            *era = g_eras[i].era;
+            *start_year = g_eras[i].start_year;
+            *start = g_eras[i].start_nanos;
+            *end = next;
+            return true;
+        }
+        next = g_eras[i].start_nanos;
+    }
+
+    return false;
+}
+
+/* Returns the name of an era, or NULL if it is not in the table. */
+const char *ut_internal_era_name(ut_japanese_era_t era) {
+    size_t count = atomic_load_explicit(&g_era_count, memory_order_acquire);
+
+    for (size_t i = 0; i < count; i++) {
+        if (g_eras[i].era == era) {
+            return g_eras[i].name;
+        }
+    }
+
+    return NULL;
+}
+
+/* Appends an era starting at 00:00 UTC on the given date after the newest one. */
+ut_error_t ut_internal_era_register(int year, int month, int day, const char *name,
+                                    ut_japanese_era_t *out) {
+    if (!ut_internal_validate_date(year, month, day)) {
+        return UT_ERR_INVALID_DATE;
+    }
+    if (strlen(name) >= UT_ERA_NAME_MAX) {
+        return UT_ERR_BUFFER_TOO_SMALL;
+    }
+
+    while (atomic_flag_test_and_set_explicit(&g_era_lock, memory_order_acquire)) {
+    }
+
+    size_t count = atomic_load_explicit(&g_era_count, memory_order_relaxed);
+    int64_t start = ut_internal_days_to_nanos(ut_internal_days_from_civil(year, month, day));
+    ut_error_t err = UT_OK;
+
+    if (count == UT_JAPANESE_ERA_CAPACITY) {
+        err = UT_ERR_OUT_OF_MEMORY;
+    } else if (start <= g_eras[count - 1].start_nanos || start == INT64_MAX) {
+        err = UT_ERR_OUT_OF_RANGE;
+    } else {
+        era_entry_t *entry = &g_eras[count];
+        entry->start_nanos = start;
+        entry->start_year = year;
+        entry->era = (ut_japanese_era_t)(UT_ERA_MEIJI + (int)(count - 4));
+        strcpy(entry->name, name);
+        *out = entry->era;
+        atomic_store_explicit(&g_era_count, count + 1, memory_order_release);
+    }
+
+    atomic_flag_clear_explicit(&g_era_lock, memory_order_release);
+    return err;
+}
@@ -7,18 +7,76 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "universal_timestamp.h"
+
+#define UT_DATE_PREFIX_LEN 11
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #define UT_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+    #define UT_THREAD_LOCAL _Thread_local
+#else
+    #define UT_THREAD_LOCAL __thread
+#endif
+
+/* Last rendered UTC day and its "YYYY-MM-DDT" text. */
+typedef struct {
+    int64_t day;
+    char prefix[UT_DATE_PREFIX_LEN];
+} ut_internal_day_cache_t;
+
+#define UT_DAY_CACHE_INIT { INT64_MIN, { 0 } }
+
+/* Statistics counter indexes; parse results occupy UT_STAT_PARSE + ut_error_t. */
+enum {
+    UT_STAT_MONOTONIC_CALLS,
+    UT_STAT_MONOTONIC_BUMPS,
+    UT_STAT_CAS_RETRIES,
+    UT_STAT_SHARED_FALLBACKS,
+    UT_STAT_PARSE,
+    UT_STAT_COUNT = UT_STAT_PARSE + UT_STATS_RESULT_COUNT
+};
+
+/* Hot-path statistics hooks; without UT_ENABLE_STATS they compile to nothing. */
+#if defined(UT_ENABLE_STATS)
+    #define UT_STAT_ADD(counter, n) ut_internal_stats_add((counter), (uint64_t)(n))
+    #define UT_STAT_PARSE(err) ut_internal_stats_parse(err)
+#else
+    #define UT_STAT_ADD(counter, n) ((void)0)
+    #define UT_STAT_PARSE(err) (err)
+#endif
 
 /* Converts broken-down time to nanoseconds since epoch. */
 int64_t ut_internal_to_nanos(int year, int month, int day,
                               int hour, int minute, int second,
                               int64_t frac_nanos);
 
+/* Splits nanoseconds since epoch into whole days, second of day and nanosecond of second. */
+void ut_internal_split_nanos(int64_t nanos, int64_t *days, int *day_seconds, int *frac_nanos);
+
 /* Converts nanoseconds since epoch to broken-down time. */
 void ut_internal_from_nanos(int64_t nanos,
                              int *year, int *month, int *day,
                              int *hour, int *minute, int *second,
                              int *frac_nanos);
 
+/* Returns the day count of the Monday, first of the month or January 1st on or before days. */
+int64_t ut_internal_calendar_floor_days(int64_t days, ut_unit_t unit);
+
+/* Converts a day count to nanoseconds, clamping to [INT64_MIN, INT64_MAX]. */
+int64_t ut_internal_days_to_nanos(int64_t days);
+
+/* Computes the ISO week date of a day count since epoch. */
+void ut_internal_iso_week_from_days(int64_t days, int *year, int *week, int *day);
+
+/* Days from epoch (1970-01-01) to given proleptic Gregorian date. */
+int64_t ut_internal_days_from_civil(int year, int month, int day);
+
+/* Converts days since epoch (1970-01-01) to a proleptic Gregorian date. */
+void ut_internal_civil_from_days(int64_t days, int *year, int *month, int *day);
+
 /* Validates a calendar date. Returns true if valid. */
 bool ut_internal_validate_date(int year, int month, int day);
 
@@ -34,4 +92,156 @@ int ut_internal_parse_int(const char *str, int n);
 /* Parses fractional seconds. Returns nanoseconds or -1 on error. */
 int64_t ut_internal_parse_fraction(const char *str, int len);
 
+/* Writes "YYYY-MM-DDT" at p and returns the position after it. */
+char *ut_internal_render_date(char *p, int year, int month, int day);
+
+/* Writes "HH:MM:SS[.f]Z" plus a null terminator at p and returns the terminator position. */
+char *ut_internal_render_time(char *p, int hour, int minute, int second, int frac_nanos);
+
+/* Formats nanos at p, reusing cache while the day is unchanged; sets *hit when non-NULL. Returns the terminator position. */
+char *ut_internal_render_cached(ut_internal_day_cache_t *cache, int64_t nanos, char *p,
+                                bool include_nanos, bool *hit);
+
+/* Parses an ISO-8601 timestamp at the start of str; with consumed set, trailing bytes are left unread. */
+ut_error_t ut_internal_parse_prefix(const char *str, size_t len, ut_timestamp_t *out,
+                                    bool strict, size_t *consumed);
+
+/* Parses an ISO-8601 timestamp of exactly len bytes with the reference scalar rules. */
+ut_error_t ut_internal_parse_scalar(const char *str, size_t len, ut_timestamp_t *out, bool strict);
+
+/* Parses str with the forms enabled by flags, choosing the form from the leading digit run. */
+ut_error_t ut_internal_parse_flexible(const char *str, size_t len, unsigned flags,
+                                      ut_timestamp_t *out, ut_parse_info_t *info);
+
+/* Strict parse using the best available SIMD backend, deferring to the scalar parser on any rejection. */
+ut_error_t ut_internal_parse_strict_fast(const char *str, size_t len, ut_timestamp_t *out);
+
+/* Decodes the column body in[pos..len) with the best available backend; *count receives the values written. */
+ut_error_t ut_internal_column_decode(const uint8_t *in, size_t len, size_t pos,
+                                     ut_timestamp_t *out, size_t capacity, size_t *count);
+
+/* Maps the named shared segment, creating it and starting an update thread for a publisher. */
+ut_error_t ut_internal_shared_attach(const char *name, bool publisher, int64_t interval_ns);
+
+/* Stops the update thread, unmaps the shared segment and, for a publisher, removes its name. */
+void ut_internal_shared_detach(void);
+
+/* Publishes the precise clock to the shared time page; returns false unless attached as a publisher. */
+bool ut_internal_shared_publish(void);
+
+/* Returns true while a shared segment is attached. */
+bool ut_internal_shared_available(void);
+
+/* Reads the shared time page, falling back to the precise clock when no segment is attached. */
+int64_t ut_internal_shared_now(void);
+
+/* Returns the publisher's update period in nanoseconds, or 0 when unknown. */
+int64_t ut_internal_shared_resolution(void);
+
+/* Maps a requested clock source to the one that will actually be read. */
+ut_clock_source_t ut_internal_clock_effective(ut_clock_source_t source);
+
+/* Reads the given clock source in nanoseconds since epoch. */
+int64_t ut_internal_clock_read(ut_clock_source_t source);
+
+/* Reads the process-wide default clock source selected with ut_set_clock_source(). */
+int64_t ut_internal_clock_now(void);
+
+/* Returns the process-wide default clock source. */
+ut_clock_source_t ut_internal_clock_default(void);
+
+/* Sets the process-wide default clock source. */
+void ut_internal_clock_set_default(ut_clock_source_t source);
+
+/* Returns the nominal tick of a clock source in nanoseconds, or 0 when unknown. */
+int64_t ut_internal_clock_resolution(ut_clock_source_t source);
+
+/* Copies the cached capability probe of a clock source, running it on first use. */
+void ut_internal_clock_probe(ut_clock_source_t source, ut_clock_info_t *out);
+
+/* Returns the cached precision of a clock source without copying the whole probe. */
+ut_precision_t ut_internal_clock_probe_precision(ut_clock_source_t source);
+
+/* Drops the cached probe of a clock source so the next lookup measures it again; a probe
+   still running is marked stale and discarded when it finishes. */
+void ut_internal_clock_probe_reset(ut_clock_source_t source);
+
+/* Returns true if the counter is invariant and calibrated; the first call performs calibration. */
+bool ut_internal_tsc_available(void);
+
+/* Returns the counter period in nanoseconds, rounded up, or 0 when the counter is unavailable. */
+int64_t ut_internal_tsc_resolution(void);
+
+/* Reads the calibrated counter as nanoseconds since epoch, falling back to CLOCK_REALTIME. */
+int64_t ut_internal_tsc_now(void);
+
+/* Returns the counter behind ut_now_monotonic(): the shared segment's when attached, else the process-local one. */
+atomic_int_fast64_t *ut_internal_monotonic_counter(void);
+
+/* Routes ut_now_monotonic() to counter (NULL for the process-local one), carrying the last value across. */
+void ut_internal_monotonic_use(atomic_int_fast64_t *counter);
+
+/* Installs the callback fired when a monotonic source observes the clock at or behind its last value. */
+void ut_internal_set_regression_callback(ut_regression_callback_t callback);
+
+/* Delivers one regression: calls the callback in UT_REGRESSION_SYNC mode, otherwise queues it. */
+void ut_internal_regression_report(int64_t expected, int64_t actual, int64_t adjusted);
+
+/* Switches the delivery mode, starting or stopping the drain thread as needed. */
+ut_error_t ut_internal_regression_delivery(ut_regression_delivery_t mode, int64_t interval_ns);
+
+/* Pops up to capacity queued events without blocking; returns 0 if another drainer holds the queue. */
+size_t ut_internal_regression_drain(ut_regression_event_t *out, size_t capacity);
+
+/* Returns the number of events dropped because the queue was full. */
+uint64_t ut_internal_regression_overflow(void);
+
+/* Reserves count values past now in steps of 2^shard_bits, keeping shard_id in the low bits, and returns the first. */
+int64_t ut_internal_monotonic_advance(atomic_int_fast64_t *last, int64_t now,
+                                      unsigned shard_bits, int64_t shard_id, size_t count);
+
+/* Returns the length of a fixed-size unit in nanoseconds, 0 for calendar units and 1 for unknown units. */
+int64_t ut_internal_unit_nanos(ut_unit_t unit);
+
+/* Returns true if a + b does not fit in int64_t. */
+bool ut_internal_add_overflows(int64_t a, int64_t b);
+
+/* Returns true if a - b does not fit in int64_t. */
+bool ut_internal_sub_overflows(int64_t a, int64_t b);
+
+/* Returns a + b clamped to [INT64_MIN, INT64_MAX]. */
+int64_t ut_internal_saturating_add(int64_t a, int64_t b);
+
+/* Returns a - b clamped to [INT64_MIN, INT64_MAX]. */
+int64_t ut_internal_saturating_sub(int64_t a, int64_t b);
+
+/* Returns a * b clamped to [INT64_MIN, INT64_MAX] for a positive b. */
+int64_t ut_internal_saturating_mul(int64_t a, int64_t b);
+
+/* Rounds value toward negative infinity to a multiple of a positive step, clamping at INT64_MIN. */
+int64_t ut_internal_floor_to(int64_t value, int64_t step);
+
+/* Finds the era containing nanos, scanning from the newest; sets [*start, *end) to its span. */
+bool ut_internal_era_find(int64_t nanos, ut_japanese_era_t *era, int *start_year,
+                          int64_t *start, int64_t *end);
+
+/* Returns the name of an era, or NULL if it is not in the table. */
+const char *ut_internal_era_name(ut_japanese_era_t era);
+
+/* Appends an era starting at 00:00 UTC on the given date after the newest one. */
+ut_error_t ut_internal_era_register(int year, int month, int day, const char *name,
+                                    ut_japanese_era_t *out);
+
+/* Adds n to one of the calling thread's counters. */
+void ut_internal_stats_add(int counter, uint64_t n);
+
+/* Counts one parse result and returns it unchanged. */
+ut_error_t ut_internal_stats_parse(ut_error_t err);
+
+/* Sums every thread's counters since the last reset; returns false when statistics are compiled out. */
+bool ut_internal_stats_read(uint64_t *totals);
+
+/* Makes later reads count from the current totals. */
+void ut_internal_stats_reset(void);
+
 #endif /* UT_INTERNAL_H */
@@ -0,0 +1,63 @@
+/**
+ * Shared compare-and-swap step behind ut_now_monotonic(), ut_now_monotonic_n() and the sharded generators.
+ */
+
+#include "ut_internal.h"
+
+static atomic_int_fast64_t g_process_last = ATOMIC_VAR_INIT(0);
+static _Atomic(atomic_int_fast64_t *) g_counter = ATOMIC_VAR_INIT(&g_process_last);
+
+/* Raises counter to at least value. */
+static void raise_to(atomic_int_fast64_t *counter, int64_t value) {
+    int64_t prev = atomic_load_explicit(counter, memory_order_relaxed);
+    while (prev < value &&
+           !atomic_compare_exchange_weak_explicit(counter, &prev, value,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+/* Returns the counter behind ut_now_monotonic(): the shared segment's when attached, else the process-local one. */
+atomic_int_fast64_t *ut_internal_monotonic_counter(void) {
+    return atomic_load_explicit(&g_counter, memory_order_acquire);
+}
+
+/* Routes ut_now_monotonic() to counter (NULL for the process-local one), carrying the last value across. */
+void ut_internal_monotonic_use(atomic_int_fast64_t *counter) {
+    if (counter == NULL) {
+        counter = &g_process_last;
+    }
+    atomic_int_fast64_t *current = atomic_load_explicit(&g_counter, memory_order_relaxed);
+    raise_to(counter, atomic_load_explicit(current, memory_order_relaxed));
+    atomic_store_explicit(&g_counter, counter, memory_order_release);
+}
+
+/* Reserves count values past now in steps of 2^shard_bits, keeping shard_id in the low bits, and returns the first. */
+int64_t ut_internal_monotonic_advance(atomic_int_fast64_t *last, int64_t now,
+                                      unsigned shard_bits, int64_t shard_id, size_t count) {
+    const int64_t step = (int64_t)1 << shard_bits;
+    const int64_t candidate = (now & ~(step - 1)) | shard_id;
+    const int64_t span = (int64_t)(count - 1) * step;
+
+    int64_t prev = atomic_load_explicit(last, memory_order_relaxed);
+    int64_t next;
+    bool regressed;
+
+    for (;;) {
+        regressed = candidate <= prev;
+        next = regressed ? prev + step : candidate;
+        if (atomic_compare_exchange_weak_explicit(last, &prev, next + span,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+            break;
+        }
+        UT_STAT_ADD(UT_STAT_CAS_RETRIES, 1);
+    }
+
+    UT_STAT_ADD(UT_STAT_MONOTONIC_CALLS, 1);
+    if (regressed) {
+        UT_STAT_ADD(UT_STAT_MONOTONIC_BUMPS, 1);
+        ut_internal_regression_report(prev + step, now, next);
+    }
+
+    return next;
+}
@@ -0,0 +1,301 @@
+/**
+ * Single-pass flexible parser behind ut_parse_flexible(): RFC 3339 offsets, basic format and epochs.
+ */
+
+#include "ut_internal.h"
+
+#define NANOS_PER_SECOND 1000000000LL
+#define EPOCH_MAX_DIGITS 19
+
+/* Character classes that drive form selection and field scanning. */
+enum {
+    C_DIGIT = 1 << 0,
+    C_SIGN = 1 << 1,
+    C_ZULU = 1 << 2,
+    C_UPPER_T = 1 << 3,
+    C_LOWER_T = 1 << 4,
+    C_SPACE = 1 << 5,
+    C_MARK = 1 << 6
+};
+
+static const unsigned char k_class[256] = {
+    ['0'] = C_DIGIT, ['1'] = C_DIGIT, ['2'] = C_DIGIT, ['3'] = C_DIGIT, ['4'] = C_DIGIT,
+    ['5'] = C_DIGIT, ['6'] = C_DIGIT, ['7'] = C_DIGIT, ['8'] = C_DIGIT, ['9'] = C_DIGIT,
+    ['+'] = C_SIGN, ['-'] = C_SIGN,
+    ['Z'] = C_ZULU, ['z'] = C_ZULU,
+    ['T'] = C_UPPER_T, ['t'] = C_LOWER_T, [' '] = C_SPACE,
+    ['.'] = C_MARK, [','] = C_MARK
+};
+
+/* Epoch unit in nanoseconds and form, indexed by the number of integer digits. */
+static const struct {
+    int64_t unit;
+    ut_parse_form_t form;
+} k_epoch_units[EPOCH_MAX_DIGITS + 1] = {
+    {NANOS_PER_SECOND, UT_FORM_EPOCH_SECONDS}, {NANOS_PER_SECOND, UT_FORM_EPOCH_SECONDS},
+    {NANOS_PER_SECOND, UT_FORM_EPOCH_SECONDS}, {NANOS_PER_SECOND, UT_FORM_EPOCH_SECONDS},
+    {NANOS_PER_SECOND, UT_FORM_EPOCH_SECONDS}, {NANOS_PER_SECOND, UT_FORM_EPOCH_SECONDS},
+    {NANOS_PER_SECOND, UT_FORM_EPOCH_SECONDS}, {NANOS_PER_SECOND, UT_FORM_EPOCH_SECONDS},
+    {NANOS_PER_SECOND, UT_FORM_EPOCH_SECONDS}, {NANOS_PER_SECOND, UT_FORM_EPOCH_SECONDS},
+    {NANOS_PER_SECOND, UT_FORM_EPOCH_SECONDS}, {NANOS_PER_SECOND, UT_FORM_EPOCH_SECONDS},
+    {1000000, UT_FORM_EPOCH_MILLIS}, {1000000, UT_FORM_EPOCH_MILLIS}, {1000000, UT_FORM_EPOCH_MILLIS},
+    {1000, UT_FORM_EPOCH_MICROS}, {1000, UT_FORM_EPOCH_MICROS}, {1000, UT_FORM_EPOCH_MICROS},
+    {1, UT_FORM_EPOCH_NANOS}, {1, UT_FORM_EPOCH_NANOS}
+};
+
+/* Returns the class of str[pos], or 0 past the end. */
+static unsigned class_at(const char *str, size_t len, size_t pos) {
+    return pos < len ? k_class[(unsigned char)str[pos]] : 0u;
+}
+
+/* Returns the number of consecutive digits starting at pos. */
+static size_t digit_run(const char *str, size_t len, size_t pos) {
+    size_t end = pos;
+    while (class_at(str, len, end) & C_DIGIT) {
+        end++;
+    }
+    return end - pos;
+}
+
+/* Returns the value of the n digits at p, or -1 if any byte is not a digit. */
+static int fixed_digits(const char *p, int n) {
+    unsigned bad = 0;
+    int value = 0;
+    for (int i = 0; i < n; i++) {
+        unsigned d = (unsigned)(p[i] - '0');
+        bad |= d > 9;
+        value = value * 10 + (int)d;
+    }
+    return bad ? -1 : value;
+}
+
+/* Combines whole seconds and a non-negative nanosecond fraction; returns false outside int64. */
+static bool seconds_to_nanos(int64_t seconds, int64_t frac, int64_t *out) {
+    if (seconds > INT64_MIN / NANOS_PER_SECOND && seconds < INT64_MAX / NANOS_PER_SECOND) {
+        *out = seconds * NANOS_PER_SECOND + frac;
+        return true;
+    }
+    if (seconds > INT64_MAX / NANOS_PER_SECOND || seconds < INT64_MIN / NANOS_PER_SECOND - 1) {
+        return false;
+    }
+    int64_t base = (seconds + (seconds < 0)) * NANOS_PER_SECOND;
+    int64_t rest = frac - (seconds < 0 ? NANOS_PER_SECOND : 0);
+    if (ut_internal_add_overflows(base, rest)) {
+        return false;
+    }
+    *out = base + rest;
+    return true;
+}
+
+/* Reads an optional "." or "," fraction at *pos in one pass, truncated to nanoseconds. */
+static ut_error_t parse_fraction(const char *str, size_t len, size_t *pos, int64_t *nanos) {
+    static const int64_t scale[10] = {
+        0, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1
+    };
+
+    *nanos = 0;
+    if (!(class_at(str, len, *pos) & C_MARK)) {
+        return UT_OK;
+    }
+
+    size_t start = *pos + 1, p = start;
+    int64_t value = 0;
+    while (class_at(str, len, p) & C_DIGIT) {
+        if (p - start < 9) {
+            value = value * 10 + (str[p] - '0');
+        }
+        p++;
+    }
+    if (p == start) {
+        return UT_ERR_INVALID_FORMAT;
+    }
+
+    *nanos = value * scale[p - start > 9 ? 9 : p - start];
+    *pos = p;
+    return UT_OK;
+}
+
+/* Reads an optional Z or +HH[[:]MM] zone at *pos, storing local minus UTC in info. */
+static ut_error_t parse_zone(const char *str, size_t len, unsigned flags, size_t *pos,
+                             ut_parse_info_t *info) {
+    size_t p = *pos;
+    if ((flags & UT_FLEX_SPACE) && (class_at(str, len, p) & C_SPACE) &&
+        (class_at(str, len, p + 1) & (C_SIGN | C_ZULU))) {
+        p++;
+    }
+
+    unsigned c = class_at(str, len, p);
+    if (c & C_ZULU) {
+        info->zoned = true;
+        *pos = p + 1;
+        return UT_OK;
+    }
+    if (!(c & C_SIGN)) {
+        return UT_OK;
+    }
+
+    const char *zone = str + p;
+    size_t run = digit_run(str, len, p + 1);
+    int minutes = 0;
+    if (run == 2 && p + 3 < len && zone[3] == ':') {
+        if (digit_run(str, len, p + 4) != 2) {
+            return UT_ERR_INVALID_FORMAT;
+        }
+        minutes = fixed_digits(zone + 4, 2);
+        p += 6;
+    } else if (run == 4) {
+        minutes = fixed_digits(zone + 3, 2);
+        p += 5;
+    } else if (run == 2) {
+        p += 3;
+    } else {
+        return UT_ERR_INVALID_FORMAT;
+    }
+
+    int hours = fixed_digits(zone + 1, 2);
+    if (hours > 23 || minutes > 59) {
+        return UT_ERR_OUT_OF_RANGE;
+    }
+    int32_t offset = (hours * 3600 + minutes * 60) * (zone[0] == '-' ? -1 : 1);
+    if (offset != 0 && !(flags & UT_FLEX_OFFSETS)) {
+        return UT_ERR_UNSUPPORTED_OFFSET;
+    }
+
+    info->zoned = true;
+    info->offset_seconds = offset;
+    *pos = p;
+    return UT_OK;
+}
+
+/* Returns true if the byte at pos may separate the date from the time under flags. */
+static bool is_date_time_separator(const char *str, size_t len, size_t pos, unsigned flags) {
+    unsigned allowed = C_UPPER_T | ((flags & UT_FLEX_SPACE) ? (C_LOWER_T | C_SPACE) : 0u);
+    return (class_at(str, len, pos) & allowed) != 0;
+}
+
+/* Validates the fields, reads the fraction and zone from pos, and produces UTC nanoseconds. */
+static ut_error_t finish_date_time(const char *str, size_t len, size_t pos, unsigned flags,
+                                   const int *f, ut_timestamp_t *out, ut_parse_info_t *info) {
+    if (f[3] > 23 || f[4] > 59) {
+        return UT_ERR_OUT_OF_RANGE;
+    }
+    if (f[5] == 60) {
+        return UT_ERR_LEAP_SECOND;
+    }
+    if (f[5] > 59) {
+        return UT_ERR_OUT_OF_RANGE;
+    }
+    if (!ut_internal_validate_date(f[0], f[1], f[2])) {
+        return UT_ERR_INVALID_DATE;
+    }
+
+    int64_t frac;
+    ut_error_t err = parse_fraction(str, len, &pos, &frac);
+    if (err == UT_OK) {
+        err = parse_zone(str, len, flags, &pos, info);
+    }
+    if (err != UT_OK) {
+        return err;
+    }
+    if (pos != len) {
+        return UT_ERR_INVALID_FORMAT;
+    }
+
+    int64_t seconds = ut_internal_days_from_civil(f[0], f[1], f[2]) * 86400
+                      + f[3] * 3600 + f[4] * 60 + f[5] - info->offset_seconds;
+    return seconds_to_nanos(seconds, frac, &out->nanos) ? UT_OK : UT_ERR_OUT_OF_RANGE;
+}
+
+/* Reads YYYY-MM-DD?HH:MM:SS from the start of str. */
+static ut_error_t parse_extended(const char *str, size_t len, unsigned flags,
+                                 ut_timestamp_t *out, ut_parse_info_t *info) {
+    if (len < 19 || str[7] != '-' || str[13] != ':' || str[16] != ':' ||
+        !is_date_time_separator(str, len, 10, flags)) {
+        return UT_ERR_INVALID_FORMAT;
+    }
+
+    int f[6] = {
+        fixed_digits(str, 4), fixed_digits(str + 5, 2), fixed_digits(str + 8, 2),
+        fixed_digits(str + 11, 2), fixed_digits(str + 14, 2), fixed_digits(str + 17, 2)
+    };
+    if ((f[0] | f[1] | f[2] | f[3] | f[4] | f[5]) < 0) {
+        return UT_ERR_INVALID_FORMAT;
+    }
+
+    info->form = UT_FORM_EXTENDED;
+    return finish_date_time(str, len, 19, flags, f, out, info);
+}
+
+/* Reads YYYYMMDD?HHMMSS from the start of str. */
+static ut_error_t parse_basic(const char *str, size_t len, unsigned flags,
+                              ut_timestamp_t *out, ut_parse_info_t *info) {
+    if (len < 15 || digit_run(str, len, 9) < 6) {
+        return UT_ERR_INVALID_FORMAT;
+    }
+
+    int f[6] = {
+        fixed_digits(str, 4), fixed_digits(str + 4, 2), fixed_digits(str + 6, 2),
+        fixed_digits(str + 9, 2), fixed_digits(str + 11, 2), fixed_digits(str + 13, 2)
+    };
+
+    info->form = UT_FORM_BASIC;
+    return finish_date_time(str, len, 15, flags, f, out, info);
+}
+
+/* Reads [+-]digits[.fraction] as a Unix epoch whose unit follows from the digit count. */
+static ut_error_t parse_epoch(const char *str, size_t len, ut_timestamp_t *out,
+                              ut_parse_info_t *info) {
+    size_t pos = (class_at(str, len, 0) & C_SIGN) ? 1 : 0;
+    bool negative = pos == 1 && str[0] == '-';
+    size_t run = digit_run(str, len, pos);
+    if (run == 0) {
+        return UT_ERR_INVALID_FORMAT;
+    }
+    if (run > EPOCH_MAX_DIGITS) {
+        return UT_ERR_OUT_OF_RANGE;
+    }
+
+    uint64_t magnitude = 0;
+    for (size_t i = 0; i < run; i++) {
+        magnitude = magnitude * 10 + (uint64_t)(str[pos + i] - '0');
+    }
+    pos += run;
+
+    int64_t frac;
+    if (parse_fraction(str, len, &pos, &frac) != UT_OK || pos != len) {
+        return UT_ERR_INVALID_FORMAT;
+    }
+
+    uint64_t unit = (uint64_t)k_epoch_units[run].unit;
+    uint64_t scaled = (uint64_t)frac * unit / NANOS_PER_SECOND;
+    uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    if (magnitude > limit / unit || scaled > limit - magnitude * unit) {
+        return UT_ERR_OUT_OF_RANGE;
+    }
+    uint64_t total = magnitude * unit + scaled;
+
+    out->nanos = negative ? (int64_t)(0 - total) : (int64_t)total;
+    info->form = k_epoch_units[run].form;
+    info->zoned = true;
+    return UT_OK;
+}
+
+/* Parses str with the forms enabled by flags, choosing the form from the leading digit run. */
+ut_error_t ut_internal_parse_flexible(const char *str, size_t len, unsigned flags,
+                                      ut_timestamp_t *out, ut_parse_info_t *info) {
+    info->form = UT_FORM_EXTENDED;
+    info->offset_seconds = 0;
+    info->zoned = false;
+
+    size_t run = digit_run(str, len, 0);
+    if (run == 4 && (class_at(str, len, 4) & C_SIGN) && str[4] == '-') {
+        return parse_extended(str, len, flags, out, info);
+    }
+    if (run == 8 && (flags & UT_FLEX_BASIC) && is_date_time_separator(str, len, 8, flags)) {
+        return parse_basic(str, len, flags, out, info);
+    }
+    if (flags & UT_FLEX_EPOCH) {
+        return parse_epoch(str, len, out, info);
+    }
+    return UT_ERR_INVALID_FORMAT;
+}
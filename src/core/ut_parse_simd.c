@@ -0,0 +1,173 @@
+/**
+ * SIMD backends for the fixed-width strict ISO-8601 layout.
+ */
+
+#include "ut_internal.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define UT_SIMD_SSSE3 1
+    #define UT_TARGET_SSSE3 __attribute__((target("ssse3")))
+    #include <immintrin.h>
+#elif defined(_M_X64) && defined(_MSC_VER)
+    #define UT_SIMD_SSSE3 1
+    #define UT_TARGET_SSSE3
+    #include <intrin.h>
+    #include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    #define UT_SIMD_NEON 1
+    #include <arm_neon.h>
+#endif
+
+/* Finishes a parse from the six decoded fields, or returns false to request the scalar path. */
+static bool finish_fields(const char *str, size_t len, const int *fields, ut_timestamp_t *out) {
+    int year = fields[0] * 100 + fields[1];
+    int month = fields[2];
+    int day = fields[3];
+    int hour = fields[4];
+    int minute = fields[5];
+
+    if (str[16] != ':' ||
+        (unsigned)(str[17] - '0') > 9 || (unsigned)(str[18] - '0') > 9) {
+        return false;
+    }
+    int second = (str[17] - '0') * 10 + (str[18] - '0');
+
+    if (hour > 23 || minute > 59 || second > 59 ||
+        !ut_internal_validate_date(year, month, day)) {
+        return false;
+    }
+
+    int64_t frac_nanos = 0;
+    size_t pos = 19;
+
+    if (str[pos] == '.') {
+        size_t frac_start = ++pos;
+        int64_t val = 0;
+        while (pos < len && (unsigned)(str[pos] - '0') <= 9) {
+            val = val * 10 + (str[pos] - '0');
+            pos++;
+        }
+        size_t frac_len = pos - frac_start;
+        if (frac_len == 0 || frac_len > 9) {
+            return false;
+        }
+        static const int64_t multipliers[] = {
+            100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1
+        };
+        frac_nanos = val * multipliers[frac_len - 1];
+    }
+
+    if (pos + 1 != len || str[pos] != 'Z') {
+        return false;
+    }
+
+    out->nanos = ut_internal_to_nanos(year, month, day, hour, minute, second, frac_nanos);
+    return true;
+}
+
+#if defined(UT_SIMD_SSSE3)
+
+/* Returns true when the running CPU supports SSSE3. */
+static bool cpu_has_ssse3(void) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+#else
+    return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+/* Validates and decodes "YYYY-MM-DDTHH:MM" with one 16-byte compare and a multiply-add. */
+UT_TARGET_SSSE3
+static bool decode_prefix_ssse3(const char *str, int *fields) {
+    const __m128i raw = _mm_loadu_si128((const __m128i *)str);
+    const __m128i digits = _mm_sub_epi8(raw, _mm_set1_epi8('0'));
+
+    const __m128i digit_lanes = _mm_setr_epi8(
+        -1, -1, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1);
+    const __m128i separators = _mm_setr_epi8(
+        0, 0, 0, 0, '-', 0, 0, '-', 0, 0, 'T', 0, 0, ':', 0, 0);
+
+    const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+    const __m128i is_sep = _mm_cmpeq_epi8(raw, separators);
+    const __m128i ok = _mm_or_si128(_mm_and_si128(is_digit, digit_lanes),
+                                    _mm_andnot_si128(digit_lanes, is_sep));
+    if (_mm_movemask_epi8(ok) != 0xFFFF) {
+        return false;
+    }
+
+    const __m128i gather = _mm_setr_epi8(
+        0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, -1, -1, -1, -1);
+    const __m128i pairs = _mm_shuffle_epi8(digits, gather);
+    const __m128i weights = _mm_setr_epi8(
+        10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 0, 0, 0, 0);
+    const __m128i values = _mm_maddubs_epi16(pairs, weights);
+
+    int16_t lanes[8];
+    _mm_storeu_si128((__m128i *)lanes, values);
+    for (int i = 0; i < 6; i++) {
+        fields[i] = lanes[i];
+    }
+    return true;
+}
+
+#elif defined(UT_SIMD_NEON)
+
+/* Validates and decodes "YYYY-MM-DDTHH:MM" with one 16-byte compare and a multiply-add. */
+static bool decode_prefix_neon(const char *str, int *fields) {
+    static const uint8_t digit_lane_bytes[16] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0, 0xFF, 0xFF, 0, 0xFF, 0xFF, 0, 0xFF, 0xFF, 0, 0xFF, 0xFF
+    };
+    static const uint8_t separator_bytes[16] = {
+        0, 0, 0, 0, '-', 0, 0, '-', 0, 0, 'T', 0, 0, ':', 0, 0
+    };
+    static const uint8_t gather_bytes[16] = {
+        0, 2, 5, 8, 11, 14, 0xFF, 0xFF, 1, 3, 6, 9, 12, 15, 0xFF, 0xFF
+    };
+
+    const uint8x16_t raw = vld1q_u8((const uint8_t *)str);
+    const uint8x16_t digits = vsubq_u8(raw, vdupq_n_u8('0'));
+    const uint8x16_t digit_lanes = vld1q_u8(digit_lane_bytes);
+
+    const uint8x16_t is_digit = vcleq_u8(digits, vdupq_n_u8(9));
+    const uint8x16_t is_sep = vceqq_u8(raw, vld1q_u8(separator_bytes));
+    const uint8x16_t ok = vbslq_u8(digit_lanes, is_digit, is_sep);
+    if (vminvq_u8(ok) != 0xFF) {
+        return false;
+    }
+
+    const uint8x16_t pairs = vqtbl1q_u8(digits, vld1q_u8(gather_bytes));
+    const uint8x8_t values = vmla_u8(vget_high_u8(pairs), vget_low_u8(pairs), vdup_n_u8(10));
+
+    uint8_t lanes[8];
+    vst1_u8(lanes, values);
+    for (int i = 0; i < 6; i++) {
+        fields[i] = lanes[i];
+    }
+    return true;
+}
+
+#endif
+
+/* Strict parse using the best available SIMD backend, deferring to the scalar parser on any rejection. */
+ut_error_t ut_internal_parse_strict_fast(const char *str, size_t len, ut_timestamp_t *out) {
+    if (len >= 20 && len <= 30) {
+        int fields[6];
+
+#if defined(UT_SIMD_SSSE3)
+        if (cpu_has_ssse3() && decode_prefix_ssse3(str, fields) &&
+            finish_fields(str, len, fields, out)) {
+            return UT_OK;
+        }
+#elif defined(UT_SIMD_NEON)
+        if (decode_prefix_neon(str, fields) && finish_fields(str, len, fields, out)) {
+            return UT_OK;
+        }
+#else
+        (void)fields;
+#endif
+    }
+
+    return ut_internal_parse_scalar(str, len, out, true);
+}
@@ -0,0 +1,80 @@
+/**
+ * Internal header for platform detection shared by the clock sources.
+ */
+
+#ifndef UT_PLATFORM_H
+#define UT_PLATFORM_H
+
+#if defined(__APPLE__) && defined(__MACH__) && !defined(_DARWIN_C_SOURCE)
+    #define _DARWIN_C_SOURCE 1
+#endif
+
+#include <time.h>
+
+/* Platform detection */
+#if defined(_WIN32) || defined(_WIN64)
+    #define UT_PLATFORM_WINDOWS 1
+    #include <windows.h>
+#elif defined(__EMSCRIPTEN__)
+    #define UT_PLATFORM_EMSCRIPTEN 1
+    #include <emscripten.h>
+#elif defined(__APPLE__) && defined(__MACH__)
+    #define UT_PLATFORM_APPLE 1
+    #include <TargetConditionals.h>
+    #if TARGET_OS_IPHONE
+        #define UT_PLATFORM_IOS 1
+    #else
+        #define UT_PLATFORM_MACOS 1
+    #endif
+#elif defined(__ANDROID__)
+    #define UT_PLATFORM_ANDROID 1
+#elif defined(__linux__)
+    #define UT_PLATFORM_LINUX 1
+#elif defined(__FreeBSD__)
+    #define UT_PLATFORM_FREEBSD 1
+#elif defined(__OpenBSD__)
+    #define UT_PLATFORM_OPENBSD 1
+#elif defined(__NetBSD__)
+    #define UT_PLATFORM_NETBSD 1
+#elif defined(__DragonFly__)
+    #define UT_PLATFORM_DRAGONFLY 1
+#elif defined(__sun) && defined(__SVR4)
+    #define UT_PLATFORM_SOLARIS 1
+#elif defined(_AIX)
+    #define UT_PLATFORM_AIX 1
+#elif defined(__hpux)
+    #define UT_PLATFORM_HPUX 1
+#elif defined(__QNX__) || defined(__QNXNTO__)
+    #define UT_PLATFORM_QNX 1
+#elif defined(__HAIKU__)
+    #define UT_PLATFORM_HAIKU 1
+#elif defined(__CYGWIN__)
+    #define UT_PLATFORM_CYGWIN 1
+#elif defined(__MINGW32__) || defined(__MINGW64__)
+    #define UT_PLATFORM_MINGW 1
+#elif defined(__vxworks)
+    #define UT_PLATFORM_VXWORKS 1
+#elif defined(__Fuchsia__)
+    #define UT_PLATFORM_FUCHSIA 1
+#endif
+
+/* POSIX availability check */
+#if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 199309L
+    #define UT_HAS_POSIX_CLOCK 1
+#elif defined(UT_PLATFORM_APPLE) || defined(UT_PLATFORM_LINUX) || \
+      defined(UT_PLATFORM_FREEBSD) || defined(UT_PLATFORM_OPENBSD) || \
+      defined(UT_PLATFORM_NETBSD) || defined(UT_PLATFORM_DRAGONFLY) || \
+      defined(UT_PLATFORM_ANDROID) || defined(UT_PLATFORM_SOLARIS) || \
+      defined(UT_PLATFORM_AIX) || defined(UT_PLATFORM_HPUX) || \
+      defined(UT_PLATFORM_QNX) || defined(UT_PLATFORM_HAIKU) || \
+      defined(UT_PLATFORM_CYGWIN) || defined(UT_PLATFORM_VXWORKS) || \
+      defined(UT_PLATFORM_FUCHSIA)
+    #define UT_HAS_POSIX_CLOCK 1
+#endif
+
+#if defined(UT_PLATFORM_WINDOWS)
+    #define UT_WINDOWS_TICK 10000000LL
+    #define UT_WINDOWS_TO_UNIX_EPOCH 11644473600LL
+#endif
+
+#endif /* UT_PLATFORM_H */
@@ -0,0 +1,233 @@
+/**
+ * Clock-regression delivery: the installed callback, and the lock-free event
+ * queue and drain thread used when delivery is taken off the hot path.
+ */
+
+#include "ut_platform.h"
+#include "ut_internal.h"
+#include <stdatomic.h>
+
+#if defined(UT_PLATFORM_WINDOWS)
+    #define UT_REGRESSION_WINDOWS 1
+#elif defined(UT_HAS_POSIX_CLOCK) && !defined(UT_PLATFORM_EMSCRIPTEN)
+    #define UT_REGRESSION_POSIX 1
+    #include <pthread.h>
+#endif
+
+#define UT_QUEUE_MASK (UT_REGRESSION_QUEUE_CAPACITY - 1)
+#define UT_DRAIN_BATCH 64
+#define UT_DEFAULT_DRAIN_NS 1000000LL
+
+/* One queue slot; seq tells producers and the consumer whose turn it is (bounded MPMC queue after Vyukov). */
+typedef struct {
+    atomic_size_t seq;
+    ut_regression_event_t event;
+} ut_queue_cell_t;
+
+static _Atomic(ut_regression_callback_t) g_regression_callback = ATOMIC_VAR_INIT(NULL);
+static atomic_int g_delivery = ATOMIC_VAR_INIT(UT_REGRESSION_SYNC);
+static atomic_uint_fast64_t g_overflow = ATOMIC_VAR_INIT(0);
+
+static ut_queue_cell_t g_queue[UT_REGRESSION_QUEUE_CAPACITY];
+static atomic_size_t g_enqueue_pos = ATOMIC_VAR_INIT(0);
+static size_t g_dequeue_pos = 0;
+static atomic_flag g_drain_lock = ATOMIC_FLAG_INIT;
+static bool g_queue_ready = false;
+
+static atomic_bool g_stop = ATOMIC_VAR_INIT(false);
+static int64_t g_interval_ns = UT_DEFAULT_DRAIN_NS;
+
+/* Pushes an event without blocking; returns false when the queue is full. */
+static bool queue_push(const ut_regression_event_t *event) {
+    size_t pos = atomic_load_explicit(&g_enqueue_pos, memory_order_relaxed);
+    for (;;) {
+        ut_queue_cell_t *cell = &g_queue[pos & UT_QUEUE_MASK];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        ptrdiff_t lag = (ptrdiff_t)(seq - pos);
+
+        if (lag == 0) {
+            if (atomic_compare_exchange_weak_explicit(&g_enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                cell->event = *event;
+                atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+                return true;
+            }
+        } else if (lag < 0) {
+            return false;
+        } else {
+            pos = atomic_load_explicit(&g_enqueue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+/* Pops up to capacity events; the caller holds the drain lock. */
+static size_t queue_pop(ut_regression_event_t *out, size_t capacity) {
+    size_t n = 0;
+    while (n < capacity) {
+        ut_queue_cell_t *cell = &g_queue[g_dequeue_pos & UT_QUEUE_MASK];
+        if (atomic_load_explicit(&cell->seq, memory_order_acquire) != g_dequeue_pos + 1) {
+            break;
+        }
+        out[n++] = cell->event;
+        atomic_store_explicit(&cell->seq, g_dequeue_pos + UT_REGRESSION_QUEUE_CAPACITY,
+                              memory_order_release);
+        g_dequeue_pos++;
+    }
+    return n;
+}
+
+/* Drains the queue into the installed callback until it is empty. */
+static void deliver_queued(void) {
+    ut_regression_event_t batch[UT_DRAIN_BATCH];
+    size_t n;
+    while ((n = ut_internal_regression_drain(batch, UT_DRAIN_BATCH)) > 0) {
+        ut_regression_callback_t callback =
+            atomic_load_explicit(&g_regression_callback, memory_order_acquire);
+        for (size_t i = 0; callback != NULL && i < n; i++) {
+            callback(batch[i].expected, batch[i].actual, batch[i].adjusted);
+        }
+    }
+}
+
+#if defined(UT_REGRESSION_POSIX)
+
+static pthread_t g_thread;
+static bool g_thread_running = false;
+
+/* Drain thread body: delivers queued events every interval until stopped. */
+static void *drain_main(void *arg) {
+    (void)arg;
+    struct timespec period = {
+        (time_t)(g_interval_ns / 1000000000LL), (long)(g_interval_ns % 1000000000LL)
+    };
+    while (!atomic_load_explicit(&g_stop, memory_order_acquire)) {
+        deliver_queued();
+        nanosleep(&period, NULL);
+    }
+    return NULL;
+}
+
+/* Starts the drain thread. */
+static bool start_thread(void) {
+    atomic_store_explicit(&g_stop, false, memory_order_relaxed);
+    g_thread_running = pthread_create(&g_thread, NULL, drain_main, NULL) == 0;
+    return g_thread_running;
+}
+
+/* Stops and joins the drain thread if one runs. */
+static void stop_thread(void) {
+    if (g_thread_running) {
+        atomic_store_explicit(&g_stop, true, memory_order_release);
+        pthread_join(g_thread, NULL);
+        g_thread_running = false;
+    }
+}
+
+#elif defined(UT_REGRESSION_WINDOWS)
+
+static HANDLE g_thread = NULL;
+
+/* Drain thread body: delivers queued events every interval (rounded up to 1 ms) until stopped. */
+static DWORD WINAPI drain_main(LPVOID arg) {
+    (void)arg;
+    DWORD period = (DWORD)((g_interval_ns + 999999) / 1000000);
+    while (!atomic_load_explicit(&g_stop, memory_order_acquire)) {
+        deliver_queued();
+        Sleep(period);
+    }
+    return 0;
+}
+
+/* Starts the drain thread. */
+static bool start_thread(void) {
+    atomic_store_explicit(&g_stop, false, memory_order_relaxed);
+    g_thread = CreateThread(NULL, 0, drain_main, NULL, 0, NULL);
+    return g_thread != NULL;
+}
+
+/* Stops and joins the drain thread if one runs. */
+static void stop_thread(void) {
+    if (g_thread != NULL) {
+        atomic_store_explicit(&g_stop, true, memory_order_release);
+        WaitForSingleObject(g_thread, INFINITE);
+        CloseHandle(g_thread);
+        g_thread = NULL;
+    }
+}
+
+#else
+
+/* No threads on this platform. */
+static bool start_thread(void) {
+    return false;
+}
+
+/* No threads on this platform. */
+static void stop_thread(void) {
+}
+
+#endif
+
+/* Installs the callback fired when a monotonic source observes the clock at or behind its last value. */
+void ut_internal_set_regression_callback(ut_regression_callback_t callback) {
+    atomic_store_explicit(&g_regression_callback, callback, memory_order_release);
+}
+
+/* Delivers one regression: calls the callback in UT_REGRESSION_SYNC mode, otherwise queues it. */
+void ut_internal_regression_report(int64_t expected, int64_t actual, int64_t adjusted) {
+    if (atomic_load_explicit(&g_delivery, memory_order_acquire) == UT_REGRESSION_SYNC) {
+        ut_regression_callback_t callback =
+            atomic_load_explicit(&g_regression_callback, memory_order_acquire);
+        if (callback != NULL) {
+            ut_timestamp_t e = {expected}, a = {actual}, d = {adjusted};
+            callback(e, a, d);
+        }
+        return;
+    }
+
+    ut_regression_event_t event = {{expected}, {actual}, {adjusted}};
+    if (!queue_push(&event)) {
+        atomic_fetch_add_explicit(&g_overflow, 1, memory_order_relaxed);
+    }
+}
+
+/* Switches the delivery mode, starting or stopping the drain thread as needed. */
+ut_error_t ut_internal_regression_delivery(ut_regression_delivery_t mode, int64_t interval_ns) {
+    if (!g_queue_ready) {
+        for (size_t i = 0; i < UT_REGRESSION_QUEUE_CAPACITY; i++) {
+            atomic_init(&g_queue[i].seq, i);
+        }
+        g_queue_ready = true;
+    }
+
+    int previous = atomic_load_explicit(&g_delivery, memory_order_relaxed);
+    if (previous == UT_REGRESSION_ASYNC) {
+        stop_thread();
+        deliver_queued();
+    }
+
+    if (mode == UT_REGRESSION_ASYNC) {
+        g_interval_ns = interval_ns > 0 ? interval_ns : UT_DEFAULT_DRAIN_NS;
+        if (!start_thread()) {
+            atomic_store_explicit(&g_delivery, UT_REGRESSION_QUEUE, memory_order_release);
+            return UT_ERR_UNAVAILABLE;
+        }
+    }
+    atomic_store_explicit(&g_delivery, (int)mode, memory_order_release);
+    return UT_OK;
+}
+
+/* Pops up to capacity queued events without blocking; returns 0 if another drainer holds the queue. */
+size_t ut_internal_regression_drain(ut_regression_event_t *out, size_t capacity) {
+    if (!g_queue_ready || atomic_flag_test_and_set_explicit(&g_drain_lock, memory_order_acquire)) {
+        return 0;
+    }
+    size_t n = queue_pop(out, capacity);
+    atomic_flag_clear_explicit(&g_drain_lock, memory_order_release);
+    return n;
+}
+
+/* Returns the number of events dropped because the queue was full. */
+uint64_t ut_internal_regression_overflow(void) {
+    return atomic_load_explicit(&g_overflow, memory_order_relaxed);
+}
@@ -0,0 +1,97 @@
+/**
+ * Fixed-width rendering helpers for ISO-8601 output.
+ */
+
+#include "ut_internal.h"
+#include <string.h>
+
+static const char DIGIT_PAIRS[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/* Writes the two-digit decimal form of value (0-99) at p. */
+static void put2(char *p, int value) {
+    memcpy(p, &DIGIT_PAIRS[value * 2], 2);
+}
+
+/* Writes "YYYY-MM-DDT" at p and returns the position after it. */
+char *ut_internal_render_date(char *p, int year, int month, int day) {
+    put2(p, year / 100);
+    put2(p + 2, year % 100);
+    p[4] = '-';
+    put2(p + 5, month);
+    p[7] = '-';
+    put2(p + 8, day);
+    p[10] = 'T';
+    return p + UT_DATE_PREFIX_LEN;
+}
+
+/* Writes "HH:MM:SS[.f]Z" plus a null terminator at p and returns the terminator position. */
+char *ut_internal_render_time(char *p, int hour, int minute, int second, int frac_nanos) {
+    put2(p, hour);
+    p[2] = ':';
+    put2(p + 3, minute);
+    p[5] = ':';
+    put2(p + 6, second);
+    p += 8;
+
+    if (frac_nanos > 0) {
+        uint32_t v = (uint32_t)frac_nanos;
+        int digits = 9;
+        while (v % 10 == 0) {
+            v /= 10;
+            digits--;
+        }
+
+        *p++ = '.';
+        char *q = p + digits;
+        p = q;
+        while (digits >= 2) {
+            q -= 2;
+            put2(q, (int)(v % 100));
+            v /= 100;
+            digits -= 2;
+        }
+        if (digits) {
+            *--q = (char)('0' + v);
+        }
+    }
+
+    p[0] = 'Z';
+    p[1] = '\0';
+    return p + 1;
+}
+
+/* Formats nanos at p, reusing cache while the day is unchanged; sets *hit when non-NULL. Returns the terminator position. */
+char *ut_internal_render_cached(ut_internal_day_cache_t *cache, int64_t nanos, char *p,
+                                bool include_nanos, bool *hit) {
+    int64_t days;
+    int day_seconds, frac_nanos;
+    ut_internal_split_nanos(nanos, &days, &day_seconds, &frac_nanos);
+
+    bool same_day = days == cache->day;
+    if (!same_day) {
+        int year, month, day;
+        ut_internal_civil_from_days(days, &year, &month, &day);
+        ut_internal_render_date(cache->prefix, year, month, day);
+        cache->day = days;
+    }
+    if (hit != NULL) {
+        *hit = same_day;
+    }
+
+    memcpy(p, cache->prefix, UT_DATE_PREFIX_LEN);
+    return ut_internal_render_time(p + UT_DATE_PREFIX_LEN,
+                                   day_seconds / 3600,
+                                   (day_seconds % 3600) / 60,
+                                   day_seconds % 60,
+                                   include_nanos ? frac_nanos : 0);
+}
@@ -0,0 +1,333 @@
+/**
+ * Shared-memory time page and monotonic counter behind UT_CLOCK_SHARED and ut_shared_clock_init().
+ */
+
+#include "ut_platform.h"
+#include "ut_internal.h"
+#include <stdatomic.h>
+#include <string.h>
+
+#if defined(UT_PLATFORM_WINDOWS)
+    #define UT_SHARED_WINDOWS 1
+    #include <stdio.h>
+#elif defined(UT_HAS_POSIX_CLOCK) && !defined(UT_PLATFORM_EMSCRIPTEN)
+    #define UT_SHARED_POSIX 1
+    #include <fcntl.h>
+    #include <pthread.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#define UT_SHARED_MAGIC 0x48535455u
+#define UT_SHARED_LAYOUT 1u
+#define UT_SHARED_NAME_MAX 250
+#define UT_CACHE_LINE 64
+#define UT_SHARED_MAX_RETRIES 256
+
+/* Segment layout; the time page and the counter sit on separate cache lines. */
+typedef struct {
+    atomic_uint magic;
+    uint32_t layout;
+    uint32_t size;
+    char pad_header[UT_CACHE_LINE - 3 * sizeof(uint32_t)];
+    atomic_uint seq;
+    atomic_int_fast64_t nanos;
+    atomic_int_fast64_t interval_ns;
+    char pad_page[UT_CACHE_LINE];
+    atomic_int_fast64_t last_monotonic;
+    char pad_counter[UT_CACHE_LINE];
+} ut_shared_page_t;
+
+static _Atomic(ut_shared_page_t *) g_page = ATOMIC_VAR_INIT(NULL);
+static bool g_publisher = false;
+static atomic_bool g_stop = ATOMIC_VAR_INIT(false);
+static atomic_flag g_publish_lock = ATOMIC_FLAG_INIT;
+static int64_t g_interval_ns = 0;
+
+#if defined(UT_SHARED_POSIX)
+
+static char g_name[UT_SHARED_NAME_MAX + 1];
+static pthread_t g_thread;
+static bool g_thread_running = false;
+
+/* Opens (and for a publisher creates and sizes) the named segment and maps it; only
+   segments owned by this user and closed to group and other writers are accepted. */
+static ut_error_t map_segment(const char *name, bool publisher, ut_shared_page_t **out) {
+    int fd = shm_open(name, publisher ? O_RDWR | O_CREAT : O_RDWR, 0600);
+    if (fd < 0) {
+        return UT_ERR_UNAVAILABLE;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_uid != geteuid()) {
+        close(fd);
+        return UT_ERR_UNAVAILABLE;
+    }
+    if (publisher && (st.st_mode & 077) != 0 && fchmod(fd, 0600) == 0) {
+        st.st_mode &= ~(mode_t)077;
+    }
+    if ((st.st_mode & (S_IWGRP | S_IWOTH)) != 0 ||
+        (publisher && ftruncate(fd, (off_t)sizeof(ut_shared_page_t)) != 0) || fstat(fd, &st) != 0) {
+        close(fd);
+        return UT_ERR_UNAVAILABLE;
+    }
+    if ((size_t)st.st_size < sizeof(ut_shared_page_t)) {
+        close(fd);
+        return UT_ERR_INVALID_FORMAT;
+    }
+
+    void *p = mmap(NULL, sizeof(ut_shared_page_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        return UT_ERR_UNAVAILABLE;
+    }
+    *out = (ut_shared_page_t *)p;
+    return UT_OK;
+}
+
+/* Unmaps the segment and, for a publisher, removes its name. */
+static void unmap_segment(ut_shared_page_t *page) {
+    munmap(page, sizeof(*page));
+    if (g_publisher) {
+        shm_unlink(g_name);
+    }
+}
+
+/* Publisher thread body: republishes every interval until stopped. */
+static void *publisher_main(void *arg) {
+    (void)arg;
+    struct timespec period = {
+        (time_t)(g_interval_ns / 1000000000LL), (long)(g_interval_ns % 1000000000LL)
+    };
+    while (!atomic_load_explicit(&g_stop, memory_order_acquire)) {
+        ut_internal_shared_publish();
+        nanosleep(&period, NULL);
+    }
+    return NULL;
+}
+
+/* Starts the publisher thread. */
+static bool start_thread(void) {
+    g_thread_running = pthread_create(&g_thread, NULL, publisher_main, NULL) == 0;
+    return g_thread_running;
+}
+
+/* Stops and joins the publisher thread if one runs. */
+static void stop_thread(void) {
+    if (g_thread_running) {
+        atomic_store_explicit(&g_stop, true, memory_order_release);
+        pthread_join(g_thread, NULL);
+        g_thread_running = false;
+    }
+}
+
+#elif defined(UT_SHARED_WINDOWS)
+
+static HANDLE g_mapping = NULL;
+static HANDLE g_thread = NULL;
+
+/* Opens (and for a publisher creates) the named file mapping in the session namespace and maps it. */
+static ut_error_t map_segment(const char *name, bool publisher, ut_shared_page_t **out) {
+    char full[UT_SHARED_NAME_MAX + 8];
+    snprintf(full, sizeof(full), "Local\\%s", name + 1);
+
+    HANDLE mapping = publisher
+        ? CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0,
+                             (DWORD)sizeof(ut_shared_page_t), full)
+        : OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, full);
+    if (mapping == NULL) {
+        return UT_ERR_UNAVAILABLE;
+    }
+
+    void *p = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(ut_shared_page_t));
+    if (p == NULL) {
+        CloseHandle(mapping);
+        return UT_ERR_UNAVAILABLE;
+    }
+    g_mapping = mapping;
+    *out = (ut_shared_page_t *)p;
+    return UT_OK;
+}
+
+/* Unmaps the segment; the name disappears with the last handle. */
+static void unmap_segment(ut_shared_page_t *page) {
+    UnmapViewOfFile(page);
+    CloseHandle(g_mapping);
+    g_mapping = NULL;
+}
+
+/* Publisher thread body: republishes every interval (rounded up to 1 ms) until stopped. */
+static DWORD WINAPI publisher_main(LPVOID arg) {
+    (void)arg;
+    DWORD period = (DWORD)((g_interval_ns + 999999) / 1000000);
+    while (!atomic_load_explicit(&g_stop, memory_order_acquire)) {
+        ut_internal_shared_publish();
+        Sleep(period);
+    }
+    return 0;
+}
+
+/* Starts the publisher thread. */
+static bool start_thread(void) {
+    g_thread = CreateThread(NULL, 0, publisher_main, NULL, 0, NULL);
+    return g_thread != NULL;
+}
+
+/* Stops and joins the publisher thread if one runs. */
+static void stop_thread(void) {
+    if (g_thread != NULL) {
+        atomic_store_explicit(&g_stop, true, memory_order_release);
+        WaitForSingleObject(g_thread, INFINITE);
+        CloseHandle(g_thread);
+        g_thread = NULL;
+    }
+}
+
+#endif
+
+/* Writes nanos and the update period under the page's seqlock. */
+static void write_page(ut_shared_page_t *page, int64_t nanos, int64_t interval_ns) {
+    unsigned seq = atomic_load_explicit(&page->seq, memory_order_relaxed);
+    atomic_store_explicit(&page->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&page->nanos, nanos, memory_order_relaxed);
+    atomic_store_explicit(&page->interval_ns, interval_ns, memory_order_relaxed);
+
+    atomic_store_explicit(&page->seq, seq + 2, memory_order_release);
+}
+
+/* Reads one page field under the seqlock; gives up after UT_SHARED_MAX_RETRIES odd or torn
+   reads so a publisher that died mid-write cannot stall readers. */
+static bool read_page(ut_shared_page_t *page, atomic_int_fast64_t *field, int64_t *value) {
+    for (int i = 0; i < UT_SHARED_MAX_RETRIES; i++) {
+        unsigned seq = atomic_load_explicit(&page->seq, memory_order_acquire);
+        int64_t v = atomic_load_explicit(field, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        if (!(seq & 1u) && seq == atomic_load_explicit(&page->seq, memory_order_relaxed)) {
+            *value = v;
+            return true;
+        }
+    }
+    UT_STAT_ADD(UT_STAT_SHARED_FALLBACKS, 1);
+    return false;
+}
+
+/* Maps the named shared segment, creating it and starting an update thread for a publisher. */
+ut_error_t ut_internal_shared_attach(const char *name, bool publisher, int64_t interval_ns) {
+#if defined(UT_SHARED_POSIX) || defined(UT_SHARED_WINDOWS)
+    size_t len = strlen(name);
+    if (len < 2 || len > UT_SHARED_NAME_MAX || name[0] != '/' || strchr(name + 1, '/') != NULL) {
+        return UT_ERR_INVALID_FORMAT;
+    }
+    if (atomic_load_explicit(&g_page, memory_order_acquire) != NULL) {
+        return UT_ERR_UNAVAILABLE;
+    }
+
+    ut_shared_page_t *page;
+    ut_error_t err = map_segment(name, publisher, &page);
+    if (err != UT_OK) {
+        return err;
+    }
+
+    if (!atomic_is_lock_free(&page->last_monotonic)) {
+        g_publisher = false;
+        unmap_segment(page);
+        return UT_ERR_UNAVAILABLE;
+    }
+    if (publisher && atomic_load_explicit(&page->magic, memory_order_acquire) != UT_SHARED_MAGIC) {
+        page->layout = UT_SHARED_LAYOUT;
+        page->size = (uint32_t)sizeof(ut_shared_page_t);
+        atomic_store_explicit(&page->magic, UT_SHARED_MAGIC, memory_order_release);
+    }
+    if (atomic_load_explicit(&page->magic, memory_order_acquire) != UT_SHARED_MAGIC ||
+        page->layout != UT_SHARED_LAYOUT || page->size != sizeof(ut_shared_page_t)) {
+        g_publisher = false;
+        unmap_segment(page);
+        return UT_ERR_INVALID_FORMAT;
+    }
+
+#if defined(UT_SHARED_POSIX)
+    memcpy(g_name, name, len + 1);
+#endif
+    g_publisher = publisher;
+    g_interval_ns = interval_ns;
+    atomic_store_explicit(&g_stop, false, memory_order_relaxed);
+    if (publisher) {
+        write_page(page, ut_internal_clock_read(UT_CLOCK_PRECISE), interval_ns);
+    }
+    atomic_store_explicit(&g_page, page, memory_order_release);
+
+    if (publisher && interval_ns > 0 && !start_thread()) {
+        ut_internal_shared_detach();
+        return UT_ERR_UNAVAILABLE;
+    }
+
+    ut_internal_monotonic_use(&page->last_monotonic);
+    ut_internal_clock_probe_reset(UT_CLOCK_SHARED);
+    return UT_OK;
+#else
+    (void)name;
+    (void)publisher;
+    (void)interval_ns;
+    return UT_ERR_UNAVAILABLE;
+#endif
+}
+
+/* Stops the update thread, unmaps the shared segment and, for a publisher, removes its name. */
+void ut_internal_shared_detach(void) {
+#if defined(UT_SHARED_POSIX) || defined(UT_SHARED_WINDOWS)
+    ut_shared_page_t *page = atomic_load_explicit(&g_page, memory_order_acquire);
+    if (page == NULL) {
+        return;
+    }
+
+    stop_thread();
+    ut_internal_monotonic_use(NULL);
+    atomic_store_explicit(&g_page, NULL, memory_order_release);
+    unmap_segment(page);
+    g_publisher = false;
+    ut_internal_clock_probe_reset(UT_CLOCK_SHARED);
+#endif
+}
+
+/* Publishes the precise clock to the shared time page; returns false unless attached as a publisher. */
+bool ut_internal_shared_publish(void) {
+    ut_shared_page_t *page = atomic_load_explicit(&g_page, memory_order_acquire);
+    if (page == NULL || !g_publisher) {
+        return false;
+    }
+
+    while (atomic_flag_test_and_set_explicit(&g_publish_lock, memory_order_acquire)) {
+    }
+    write_page(page, ut_internal_clock_read(UT_CLOCK_PRECISE), g_interval_ns);
+    atomic_flag_clear_explicit(&g_publish_lock, memory_order_release);
+    return true;
+}
+
+/* Returns true while a shared segment is attached. */
+bool ut_internal_shared_available(void) {
+    return atomic_load_explicit(&g_page, memory_order_acquire) != NULL;
+}
+
+/* Reads the shared time page, falling back to the precise clock when no segment is attached
+   or the page stays mid-update. */
+int64_t ut_internal_shared_now(void) {
+    ut_shared_page_t *page = atomic_load_explicit(&g_page, memory_order_acquire);
+    int64_t nanos;
+    if (page == NULL || !read_page(page, &page->nanos, &nanos)) {
+        return ut_internal_clock_read(UT_CLOCK_PRECISE);
+    }
+    return nanos;
+}
+
+/* Returns the publisher's update period in nanoseconds, or 0 when unknown. */
+int64_t ut_internal_shared_resolution(void) {
+    ut_shared_page_t *page = atomic_load_explicit(&g_page, memory_order_acquire);
+    int64_t interval;
+    if (page == NULL || !read_page(page, &page->interval_ns, &interval)) {
+        return 0;
+    }
+    return interval;
+}
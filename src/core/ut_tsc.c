@@ -0,0 +1,223 @@
+/**
+ * Invariant TSC (x86) and CNTVCT (ARM64) wall clock, calibrated against CLOCK_REALTIME.
+ */
+
+#include "ut_internal.h"
+#include <stdatomic.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define UT_TSC_X86 1
+    #include <cpuid.h>
+    #include <x86intrin.h>
+#elif (defined(_M_X64) || defined(_M_IX86)) && defined(_MSC_VER)
+    #define UT_TSC_X86 1
+    #include <intrin.h>
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+    #define UT_TSC_ARM64 1
+#endif
+
+#define UT_TSC_SHIFT 32
+#define UT_TSC_CALIBRATION_NS 5000000LL
+#define UT_TSC_REANCHOR_NS 1000000000LL
+#define UT_TSC_MAX_DRIFT_PPM 1000
+
+enum {
+    TSC_UNINIT = 0,
+    TSC_INITIALIZING,
+    TSC_READY,
+    TSC_UNAVAILABLE
+};
+
+static atomic_int g_tsc_state = ATOMIC_VAR_INIT(TSC_UNINIT);
+static atomic_flag g_tsc_reanchor_lock = ATOMIC_FLAG_INIT;
+static atomic_uint g_tsc_seq = ATOMIC_VAR_INIT(0);
+static atomic_uint_fast64_t g_tsc_base_ticks = ATOMIC_VAR_INIT(0);
+static atomic_int_fast64_t g_tsc_base_nanos = ATOMIC_VAR_INIT(0);
+static atomic_uint_fast64_t g_tsc_mult = ATOMIC_VAR_INIT(0);
+static atomic_uint_fast64_t g_tsc_reanchor_ticks = ATOMIC_VAR_INIT(0);
+
+/* Returns true when the CPU exposes a constant-rate counter that keeps running in all power states. */
+static bool counter_is_invariant(void) {
+#if defined(UT_TSC_X86) && defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0x80000000);
+    if ((unsigned)info[0] < 0x80000007u) {
+        return false;
+    }
+    __cpuid(info, 0x80000007);
+    return (info[3] & (1 << 8)) != 0;
+#elif defined(UT_TSC_X86)
+    unsigned eax, ebx, ecx, edx;
+    if (__get_cpuid_max(0x80000000u, NULL) < 0x80000007u) {
+        return false;
+    }
+    __cpuid(0x80000007u, eax, ebx, ecx, edx);
+    return (edx & (1u << 8)) != 0;
+#elif defined(UT_TSC_ARM64)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/* Reads the raw hardware counter. */
+static uint64_t read_counter(void) {
+#if defined(UT_TSC_X86)
+    return (uint64_t)__rdtsc();
+#elif defined(UT_TSC_ARM64)
+    uint64_t value;
+    __asm__ __volatile__("isb\n\tmrs %0, cntvct_el0" : "=r"(value) :: "memory");
+    return value;
+#else
+    return 0;
+#endif
+}
+
+/* Reads the wall clock bracketed by two counter reads and returns the midpoint counter value. */
+static uint64_t sample_pair(int64_t *nanos) {
+    uint64_t before = read_counter();
+    *nanos = ut_internal_clock_read(UT_CLOCK_PRECISE);
+    uint64_t after = read_counter();
+    return before + (after - before) / 2;
+}
+
+/* Scales a tick delta to nanoseconds with the 32.32 fixed-point multiplier without overflowing. */
+static uint64_t scale_ticks(uint64_t ticks, uint64_t mult) {
+    uint64_t high = (ticks >> UT_TSC_SHIFT) * mult;
+    uint64_t low = ((ticks & 0xFFFFFFFFu) * mult) >> UT_TSC_SHIFT;
+    return high + low;
+}
+
+/* Returns the 32.32 fixed-point nanoseconds-per-tick multiplier for an observed interval. */
+static uint64_t multiplier_for(int64_t nanos, uint64_t ticks) {
+    return (uint64_t)((double)nanos / (double)ticks * 4294967296.0);
+}
+
+/* Publishes a new anchor under the seqlock; callers must hold the re-anchor lock or be the initializer. */
+static void publish_anchor(uint64_t ticks, int64_t nanos, uint64_t mult) {
+    unsigned seq = atomic_load_explicit(&g_tsc_seq, memory_order_relaxed);
+    atomic_store_explicit(&g_tsc_seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&g_tsc_base_ticks, ticks, memory_order_relaxed);
+    atomic_store_explicit(&g_tsc_base_nanos, nanos, memory_order_relaxed);
+    atomic_store_explicit(&g_tsc_mult, mult, memory_order_relaxed);
+    atomic_store_explicit(&g_tsc_reanchor_ticks,
+                          (uint64_t)((double)UT_TSC_REANCHOR_NS * 4294967296.0 / (double)mult),
+                          memory_order_relaxed);
+
+    atomic_store_explicit(&g_tsc_seq, seq + 2, memory_order_release);
+}
+
+/* Measures the counter frequency over a short busy wait and publishes the first anchor. */
+static bool calibrate(void) {
+    if (!counter_is_invariant()) {
+        return false;
+    }
+
+    int64_t start_nanos, end_nanos;
+    uint64_t start_ticks = sample_pair(&start_nanos);
+    uint64_t end_ticks;
+    do {
+        end_ticks = sample_pair(&end_nanos);
+    } while (end_nanos - start_nanos < UT_TSC_CALIBRATION_NS && end_nanos >= start_nanos);
+
+    if (end_ticks <= start_ticks || end_nanos <= start_nanos) {
+        return false;
+    }
+
+    publish_anchor(end_ticks, end_nanos, multiplier_for(end_nanos - start_nanos, end_ticks - start_ticks));
+    return true;
+}
+
+/* Re-reads CLOCK_REALTIME, moves the anchor and refines the multiplier unless the clock was stepped. */
+static void reanchor(uint64_t prev_ticks, int64_t prev_nanos, uint64_t prev_mult) {
+    if (atomic_flag_test_and_set_explicit(&g_tsc_reanchor_lock, memory_order_acquire)) {
+        return;
+    }
+
+    if (atomic_load_explicit(&g_tsc_base_ticks, memory_order_relaxed) == prev_ticks) {
+        int64_t nanos;
+        uint64_t ticks = sample_pair(&nanos);
+        uint64_t mult = prev_mult;
+        if (ticks > prev_ticks && nanos > prev_nanos) {
+            uint64_t refined = multiplier_for(nanos - prev_nanos, ticks - prev_ticks);
+            uint64_t drift = refined > prev_mult ? refined - prev_mult : prev_mult - refined;
+            if (drift <= prev_mult / 1000000u * UT_TSC_MAX_DRIFT_PPM) {
+                mult = refined;
+            }
+        }
+        publish_anchor(ticks, nanos, mult);
+    }
+
+    atomic_flag_clear_explicit(&g_tsc_reanchor_lock, memory_order_release);
+}
+
+/* Returns true once the counter is calibrated, initializing it on first use. */
+static bool ensure_ready(void) {
+    int state = atomic_load_explicit(&g_tsc_state, memory_order_acquire);
+    if (state == TSC_READY) {
+        return true;
+    }
+    if (state != TSC_UNINIT) {
+        return false;
+    }
+
+    int expected = TSC_UNINIT;
+    if (!atomic_compare_exchange_strong(&g_tsc_state, &expected, TSC_INITIALIZING)) {
+        return expected == TSC_READY;
+    }
+
+    bool ok = calibrate();
+    atomic_store_explicit(&g_tsc_state, ok ? TSC_READY : TSC_UNAVAILABLE, memory_order_release);
+    return ok;
+}
+
+/* Returns true if the counter is invariant and calibrated; the first call performs calibration. */
+bool ut_internal_tsc_available(void) {
+    if (ensure_ready()) {
+        return true;
+    }
+    while (atomic_load_explicit(&g_tsc_state, memory_order_acquire) == TSC_INITIALIZING) {
+    }
+    return atomic_load_explicit(&g_tsc_state, memory_order_acquire) == TSC_READY;
+}
+
+/* Returns the counter period in nanoseconds, rounded up, or 0 when the counter is unavailable. */
+int64_t ut_internal_tsc_resolution(void) {
+    if (!ut_internal_tsc_available()) {
+        return 0;
+    }
+    uint64_t mult = atomic_load_explicit(&g_tsc_mult, memory_order_relaxed);
+    return (int64_t)((mult + 0xFFFFFFFFu) >> UT_TSC_SHIFT);
+}
+
+/* Reads the calibrated counter as nanoseconds since epoch, falling back to CLOCK_REALTIME. */
+int64_t ut_internal_tsc_now(void) {
+    if (!ensure_ready()) {
+        return ut_internal_clock_read(UT_CLOCK_PRECISE);
+    }
+
+    uint64_t base_ticks, mult, limit;
+    int64_t base_nanos;
+    unsigned seq;
+    do {
+        seq = atomic_load_explicit(&g_tsc_seq, memory_order_acquire);
+        base_ticks = atomic_load_explicit(&g_tsc_base_ticks, memory_order_relaxed);
+        base_nanos = atomic_load_explicit(&g_tsc_base_nanos, memory_order_relaxed);
+        mult = atomic_load_explicit(&g_tsc_mult, memory_order_relaxed);
+        limit = atomic_load_explicit(&g_tsc_reanchor_ticks, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+    } while ((seq & 1u) || seq != atomic_load_explicit(&g_tsc_seq, memory_order_relaxed));
+
+    uint64_t ticks = read_counter();
+    if (ticks < base_ticks) {
+        return base_nanos - (int64_t)scale_ticks(base_ticks - ticks, mult);
+    }
+
+    uint64_t delta = ticks - base_ticks;
+    if (delta > limit) {
+        reanchor(base_ticks, base_nanos, mult);
+    }
+    return base_nanos + (int64_t)scale_ticks(delta, mult);
+}
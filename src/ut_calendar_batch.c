@@ -0,0 +1,191 @@
+/**
+ * @file ut_calendar_batch.c
+ * @brief Implementation of ut_truncate_batch(), ut_iso_week_batch() and
+ *        ut_to_japanese_era_batch().
+ */
+
+
+#include "universal_timestamp.h"
+#include "core/ut_internal.h"
+#include <string.h>
+
+#define UT_NANOS_PER_DAY 86400000000000LL
+
+/* Floors nanoseconds to whole days since epoch. */
+static inline int64_t floor_days(int64_t nanos) {
+    return nanos / UT_NANOS_PER_DAY - (nanos % UT_NANOS_PER_DAY < 0);
+}
+
+/* Floors every element to a multiple of step; inlined per unit so step is a constant. */
+static inline void floor_fixed(const ut_timestamp_t *in, size_t n, int64_t step, ut_timestamp_t *out) {
+    for (size_t i = 0; i < n; i++) {
+        int64_t value = in[i].nanos;
+        int64_t rem = value % step;
+        rem += step & -(int64_t)(rem < 0);
+        out[i].nanos = value < INT64_MIN + rem ? INT64_MIN : value - rem;
+    }
+}
+
+/* Floors every element to 00:00 on its ISO Monday without calling into the civil routines. */
+static void floor_weeks(const ut_timestamp_t *in, size_t n, ut_timestamp_t *out) {
+    for (size_t i = 0; i < n; i++) {
+        int64_t days = floor_days(in[i].nanos);
+        int64_t dow = (days + 3) % 7;
+        dow += 7 & -(int64_t)(dow < 0);
+        int64_t monday = days - dow;
+        out[i].nanos = monday < INT64_MIN / UT_NANOS_PER_DAY ? INT64_MIN : monday * UT_NANOS_PER_DAY;
+    }
+}
+
+/* Sets [*lo, *hi) to the day range of the month or year containing days. */
+static void calendar_span(int64_t days, ut_unit_t unit, int64_t *lo, int64_t *hi) {
+    int year, month, day;
+    ut_internal_civil_from_days(days, &year, &month, &day);
+
+    if (unit == UT_UNIT_MONTH) {
+        *lo = ut_internal_days_from_civil(year, month, 1);
+        *hi = month == 12 ? ut_internal_days_from_civil(year + 1, 1, 1)
+                          : ut_internal_days_from_civil(year, month + 1, 1);
+    } else {
+        *lo = ut_internal_days_from_civil(year, 1, 1);
+        *hi = ut_internal_days_from_civil(year + 1, 1, 1);
+    }
+}
+
+/* Floors every element to its month or year, reusing the span of the previous row while it still applies. */
+static void floor_calendar(const ut_timestamp_t *in, size_t n, ut_unit_t unit, ut_timestamp_t *out) {
+    int64_t lo = 1, hi = 0, start = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        int64_t days = floor_days(in[i].nanos);
+        if (days < lo || days >= hi) {
+            calendar_span(days, unit, &lo, &hi);
+            start = ut_internal_days_to_nanos(lo);
+        }
+        out[i].nanos = start;
+    }
+}
+
+/**
+ * @brief Truncate an array of timestamps to a unit.
+ */
+
+ut_error_t ut_truncate_batch(const ut_timestamp_t *in, size_t n, ut_unit_t unit,
+                             ut_timestamp_t *out) {
+    if (n == 0) {
+        return UT_OK;
+    }
+    if (in == NULL || out == NULL) {
+        return UT_ERR_NULL_POINTER;
+    }
+
+    switch (unit) {
+        case UT_UNIT_NANOSECOND:
+            if (out != in) {
+                memmove(out, in, n * sizeof(*out));
+            }
+            break;
+        case UT_UNIT_MICROSECOND: floor_fixed(in, n, 1000LL, out); break;
+        case UT_UNIT_MILLISECOND: floor_fixed(in, n, 1000000LL, out); break;
+        case UT_UNIT_SECOND:      floor_fixed(in, n, 1000000000LL, out); break;
+        case UT_UNIT_MINUTE:      floor_fixed(in, n, 60000000000LL, out); break;
+        case UT_UNIT_HOUR:        floor_fixed(in, n, 3600000000000LL, out); break;
+        case UT_UNIT_DAY:         floor_fixed(in, n, UT_NANOS_PER_DAY, out); break;
+        case UT_UNIT_WEEK:        floor_weeks(in, n, out); break;
+        case UT_UNIT_MONTH:
+        case UT_UNIT_YEAR:        floor_calendar(in, n, unit, out); break;
+        default:
+            return UT_ERR_OUT_OF_RANGE;
+    }
+
+    return UT_OK;
+}
+
+/**
+ * @brief Get ISO week date components for an array of timestamps.
+ */
+
+ut_error_t ut_iso_week_batch(const ut_timestamp_t *in, size_t n,
+                             int *years, int *weeks, int *days) {
+    if (n == 0) {
+        return UT_OK;
+    }
+    if (in == NULL || years == NULL || weeks == NULL || days == NULL) {
+        return UT_ERR_NULL_POINTER;
+    }
+
+    int64_t monday = 1;
+    int year = 0, week = 0, weekday;
+
+    for (size_t i = 0; i < n; i++) {
+        int64_t d = floor_days(in[i].nanos);
+        if (d < monday || d >= monday + 7) {
+            ut_internal_iso_week_from_days(d, &year, &week, &weekday);
+            monday = d - (weekday - 1);
+        }
+        years[i] = year;
+        weeks[i] = week;
+        days[i] = (int)(d - monday) + 1;
+    }
+
+    return UT_OK;
+}
+
+/**
+ * @brief Get Japanese era and year for an array of timestamps.
+ */
+
+ut_error_t ut_to_japanese_era_batch(const ut_timestamp_t *in, size_t n,
+                                    ut_japanese_era_t *eras, int *era_years,
+                                    ut_error_t *errs) {
+    if (n == 0) {
+        return UT_OK;
+    }
+    if (in == NULL || eras == NULL || era_years == NULL) {
+        return UT_ERR_NULL_POINTER;
+    }
+
+    ut_error_t first = UT_OK;
+    int64_t lo = 1, hi = 0;
+    ut_japanese_era_t era = UT_ERA_REIWA;
+    int era_year = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        int64_t nanos = in[i].nanos;
+
+        if (nanos < lo || nanos >= hi) {
+            int start_year;
+            int64_t era_start, era_end;
+
+            if (!ut_internal_era_find(nanos, &era, &start_year, &era_start, &era_end)) {
+                era_years[i] = 0;
+                if (errs != NULL) {
+                    errs[i] = UT_ERR_OUT_OF_RANGE;
+                }
+                if (first == UT_OK) {
+                    first = UT_ERR_OUT_OF_RANGE;
+                }
+                lo = 1;
+                hi = 0;
+                continue;
+            }
+
+            int year, month, day;
+            ut_internal_civil_from_days(floor_days(nanos), &year, &month, &day);
+            int64_t year_start = ut_internal_days_to_nanos(ut_internal_days_from_civil(year, 1, 1));
+            int64_t year_end = ut_internal_days_to_nanos(ut_internal_days_from_civil(year + 1, 1, 1));
+
+            era_year = year - start_year + 1;
+            lo = year_start > era_start ? year_start : era_start;
+            hi = year_end < era_end ? year_end : era_end;
+        }
+
+        eras[i] = era;
+        era_years[i] = era_year;
+        if (errs != NULL) {
+            errs[i] = UT_OK;
+        }
+    }
+
+    return first;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file ut_clock_source.c
+ * @brief Implementation of ut_now_with(), ut_set_clock_source(),
+ *        ut_get_clock_source() and ut_get_clock_info().
+ */
+
+
+#include "universal_timestamp.h"
+#include "core/ut_internal.h"
+
+/**
+ * @brief Get the current UTC timestamp from a specific clock source.
+ */
+
+ut_timestamp_t ut_now_with(ut_clock_source_t source) {
+    ut_timestamp_t ts = {ut_internal_clock_read(source)};
+    return ts;
+}
+
+/**
+ * @brief Select the clock source used by ut_now() and ut_now_monotonic().
+ */
+
+ut_error_t ut_set_clock_source(ut_clock_source_t source) {
+    if (source < UT_CLOCK_PRECISE || source > UT_CLOCK_SHARED) {
+        return UT_ERR_OUT_OF_RANGE;
+    }
+    if (source == UT_CLOCK_TSC) {
+        ut_internal_tsc_available();
+    }
+
+    ut_internal_clock_set_default(source);
+    return UT_OK;
+}
+
+/**
+ * @brief Get the clock source used by ut_now() and ut_now_monotonic().
+ */
+
+ut_clock_source_t ut_get_clock_source(void) {
+    return ut_internal_clock_default();
+}
+
+/**
+ * @brief Describe the resolution, precision and cost of a clock source.
+ */
+
+ut_error_t ut_get_clock_info(ut_clock_source_t source, ut_clock_info_t *out) {
+    if (out == NULL) {
+        return UT_ERR_NULL_POINTER;
+    }
+    if (source < UT_CLOCK_PRECISE || source > UT_CLOCK_SHARED) {
+        return UT_ERR_OUT_OF_RANGE;
+    }
+
+    ut_internal_clock_probe(source, out);
+    return UT_OK;
+}
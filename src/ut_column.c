@@ -0,0 +1,174 @@
+/**
+ * @file ut_column.c
+ * @brief Implementation of the delta/zig-zag varint binary column codec.
+ */
+
+
+#include "universal_timestamp.h"
+#include "core/ut_internal.h"
+#include <string.h>
+
+#define UT_COLUMN_MAGIC0 'U'
+#define UT_COLUMN_MAGIC1 'T'
+#define UT_VARINT_MAX_LEN 10
+#define UT_CONTINUATION_BITS 0x8080808080808080ULL
+
+/* Maps signed deltas to unsigned so that small magnitudes get short varints. */
+static uint64_t zigzag(uint64_t delta) {
+    return (delta << 1) ^ (0 - (delta >> 63));
+}
+
+/* Returns the number of bytes put_varint() writes for v. */
+static size_t varint_len(uint64_t v) {
+    size_t n = 1;
+    while (v >= 0x80) {
+        v >>= 7;
+        n++;
+    }
+    return n;
+}
+
+/* Writes v as an LEB128 varint at p and returns its length. */
+static size_t put_varint(uint8_t *p, uint64_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        p[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+/* Returns UT_OK when in starts with a header this version can read. */
+static ut_error_t check_header(const uint8_t *in, size_t len) {
+    if (len < UT_COLUMN_HEADER_LEN || in[0] != UT_COLUMN_MAGIC0 || in[1] != UT_COLUMN_MAGIC1 ||
+        in[2] != UT_COLUMN_VERSION || in[3] != 0) {
+        return UT_ERR_INVALID_FORMAT;
+    }
+    return UT_OK;
+}
+
+/**
+ * @brief Encode timestamps as a binary column.
+ */
+
+ut_error_t ut_encode_column(const ut_timestamp_t *in, size_t n,
+                            uint8_t *out, size_t out_size, size_t *written) {
+    ut_column_encoder_t enc;
+    ut_column_encoder_init(&enc);
+    return ut_column_encode_append(&enc, in, n, out, out_size, written);
+}
+
+/**
+ * @brief Reset an incremental column encoder.
+ */
+
+void ut_column_encoder_init(ut_column_encoder_t *enc) {
+    if (enc != NULL) {
+        enc->prev = 0;
+        enc->started = false;
+    }
+}
+
+/**
+ * @brief Append timestamps to a column being built incrementally.
+ */
+
+ut_error_t ut_column_encode_append(ut_column_encoder_t *enc, const ut_timestamp_t *in, size_t n,
+                                   uint8_t *out, size_t out_size, size_t *written) {
+    if (written != NULL) {
+        *written = 0;
+    }
+    if (enc == NULL || written == NULL || (n > 0 && in == NULL) || (out == NULL && out_size > 0)) {
+        return UT_ERR_NULL_POINTER;
+    }
+
+    size_t header = enc->started ? 0 : UT_COLUMN_HEADER_LEN;
+    if (out_size < header || out_size - header < n * UT_VARINT_MAX_LEN) {
+        size_t need = header;
+        uint64_t prev = (uint64_t)enc->prev;
+        for (size_t i = 0; i < n; i++) {
+            need += varint_len(zigzag((uint64_t)in[i].nanos - prev));
+            prev = (uint64_t)in[i].nanos;
+        }
+        if (need > out_size) {
+            return UT_ERR_BUFFER_TOO_SMALL;
+        }
+    }
+
+    uint8_t *p = out;
+    if (header > 0) {
+        p[0] = UT_COLUMN_MAGIC0;
+        p[1] = UT_COLUMN_MAGIC1;
+        p[2] = UT_COLUMN_VERSION;
+        p[3] = 0;
+        p += UT_COLUMN_HEADER_LEN;
+    }
+
+    uint64_t prev = (uint64_t)enc->prev;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t value = (uint64_t)in[i].nanos;
+        p += put_varint(p, zigzag(value - prev));
+        prev = value;
+    }
+
+    enc->prev = (int64_t)prev;
+    enc->started = true;
+    *written = (size_t)(p - out);
+    return UT_OK;
+}
+
+/**
+ * @brief Count the timestamps in an encoded column without decoding them.
+ */
+
+ut_error_t ut_column_count(const uint8_t *in, size_t len, size_t *count) {
+    if (count != NULL) {
+        *count = 0;
+    }
+    if (in == NULL || count == NULL) {
+        return UT_ERR_NULL_POINTER;
+    }
+    ut_error_t err = check_header(in, len);
+    if (err != UT_OK) {
+        return err;
+    }
+
+    size_t pos = UT_COLUMN_HEADER_LEN;
+    size_t values = 0;
+
+    for (; pos + 8 <= len; pos += 8) {
+        uint64_t word;
+        memcpy(&word, in + pos, sizeof(word));
+        values += (size_t)((((~word & UT_CONTINUATION_BITS) >> 7) * 0x0101010101010101ULL) >> 56);
+    }
+    for (; pos < len; pos++) {
+        values += (in[pos] & 0x80) == 0;
+    }
+
+    if (len > UT_COLUMN_HEADER_LEN && (in[len - 1] & 0x80) != 0) {
+        return UT_ERR_INVALID_FORMAT;
+    }
+    *count = values;
+    return UT_OK;
+}
+
+/**
+ * @brief Decode a binary column produced by ut_encode_column().
+ */
+
+ut_error_t ut_decode_column(const uint8_t *in, size_t len,
+                            ut_timestamp_t *out, size_t capacity, size_t *count) {
+    if (count != NULL) {
+        *count = 0;
+    }
+    if (in == NULL || count == NULL || (out == NULL && capacity > 0)) {
+        return UT_ERR_NULL_POINTER;
+    }
+    ut_error_t err = check_header(in, len);
+    if (err != UT_OK) {
+        return err;
+    }
+
+    return ut_internal_column_decode(in, len, UT_COLUMN_HEADER_LEN, out, capacity, count);
+}
@@ -0,0 +1,121 @@
+/**
+ * @file ut_duration.c
+ * @brief Implementation of ut_duration_t arithmetic and truncation.
+ */
+
+
+#include "universal_timestamp.h"
+#include "core/ut_internal.h"
+
+/**
+ * @brief Build a duration from a count of units, saturating on overflow.
+ */
+
+ut_duration_t ut_duration_from(int64_t count, ut_unit_t unit) {
+    int64_t step = ut_internal_unit_nanos(unit);
+    ut_duration_t d = {step == 0 ? 0 : ut_internal_saturating_mul(count, step)};
+    return d;
+}
+
+/**
+ * @brief Convert a duration to whole units, truncating toward zero.
+ */
+
+int64_t ut_duration_to(ut_duration_t d, ut_unit_t unit) {
+    int64_t step = ut_internal_unit_nanos(unit);
+    return step == 0 ? 0 : d.nanos / step;
+}
+
+/**
+ * @brief Add a duration to a timestamp, clamping at the representable range.
+ */
+
+ut_timestamp_t ut_add_saturating(ut_timestamp_t ts, ut_duration_t d) {
+    ut_timestamp_t out = {ut_internal_saturating_add(ts.nanos, d.nanos)};
+    return out;
+}
+
+/**
+ * @brief Subtract a duration from a timestamp, clamping at the representable range.
+ */
+
+ut_timestamp_t ut_sub_saturating(ut_timestamp_t ts, ut_duration_t d) {
+    ut_timestamp_t out = {ut_internal_saturating_sub(ts.nanos, d.nanos)};
+    return out;
+}
+
+/**
+ * @brief Get the duration a - b, clamping at the representable range.
+ */
+
+ut_duration_t ut_diff_saturating(ut_timestamp_t a, ut_timestamp_t b) {
+    ut_duration_t out = {ut_internal_saturating_sub(a.nanos, b.nanos)};
+    return out;
+}
+
+/**
+ * @brief Add a duration to a timestamp, reporting overflow.
+ */
+
+ut_error_t ut_add_checked(ut_timestamp_t ts, ut_duration_t d, ut_timestamp_t *out) {
+    if (out == NULL) {
+        return UT_ERR_NULL_POINTER;
+    }
+    if (ut_internal_add_overflows(ts.nanos, d.nanos)) {
+        return UT_ERR_OUT_OF_RANGE;
+    }
+
+    out->nanos = ts.nanos + d.nanos;
+    return UT_OK;
+}
+
+/**
+ * @brief Subtract a duration from a timestamp, reporting overflow.
+ */
+
+ut_error_t ut_sub_checked(ut_timestamp_t ts, ut_duration_t d, ut_timestamp_t *out) {
+    if (out == NULL) {
+        return UT_ERR_NULL_POINTER;
+    }
+    if (ut_internal_sub_overflows(ts.nanos, d.nanos)) {
+        return UT_ERR_OUT_OF_RANGE;
+    }
+
+    out->nanos = ts.nanos - d.nanos;
+    return UT_OK;
+}
+
+/**
+ * @brief Get the duration a - b, reporting overflow.
+ */
+
+ut_error_t ut_diff_checked(ut_timestamp_t a, ut_timestamp_t b, ut_duration_t *out) {
+    if (out == NULL) {
+        return UT_ERR_NULL_POINTER;
+    }
+    if (ut_internal_sub_overflows(a.nanos, b.nanos)) {
+        return UT_ERR_OUT_OF_RANGE;
+    }
+
+    out->nanos = a.nanos - b.nanos;
+    return UT_OK;
+}
+
+/**
+ * @brief Round a timestamp down to a multiple of a unit.
+ */
+
+ut_timestamp_t ut_truncate(ut_timestamp_t ts, ut_unit_t unit) {
+    ut_timestamp_t out;
+
+    if (unit == UT_UNIT_WEEK || unit == UT_UNIT_MONTH || unit == UT_UNIT_YEAR) {
+        int64_t days;
+        int day_seconds, frac;
+        ut_internal_split_nanos(ts.nanos, &days, &day_seconds, &frac);
+        out.nanos = ut_internal_days_to_nanos(ut_internal_calendar_floor_days(days, unit));
+    } else {
+        out.nanos = ut_internal_floor_to(ts.nanos, ut_internal_unit_nanos(unit));
+    }
+
+    return out;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file ut_format_batch.c
+ * @brief Implementation of ut_format_batch() and ut_format_batch_packed().
+ */
+
+
+#include "universal_timestamp.h"
+#include "core/ut_internal.h"
+#include <string.h>
+
+/**
+ * @brief Format an array of timestamps into fixed-size slots.
+ */
+
+ut_error_t ut_format_batch(const ut_timestamp_t *in, size_t n,
+                           char *out, size_t stride, bool include_nanos) {
+    if (n == 0) {
+        return UT_OK;
+    }
+    if (in == NULL || out == NULL) {
+        return UT_ERR_NULL_POINTER;
+    }
+    if (stride < UT_MAX_STRING_LEN) {
+        return UT_ERR_BUFFER_TOO_SMALL;
+    }
+
+    ut_internal_day_cache_t cache = UT_DAY_CACHE_INIT;
+
+    for (size_t i = 0; i < n; i++) {
+        ut_internal_render_cached(&cache, in[i].nanos, out + i * stride, include_nanos, NULL);
+    }
+
+    return UT_OK;
+}
+
+/**
+ * @brief Format an array of timestamps into one packed, delimited buffer.
+ */
+
+ut_error_t ut_format_batch_packed(const ut_timestamp_t *in, size_t n,
+                                  char *out, size_t out_size, char delim,
+                                  bool include_nanos, size_t *offsets,
+                                  size_t *out_len) {
+    if (out_len != NULL) {
+        *out_len = 0;
+    }
+    if (n > 0 && (in == NULL || out == NULL)) {
+        return UT_ERR_NULL_POINTER;
+    }
+
+    ut_internal_day_cache_t cache = UT_DAY_CACHE_INIT;
+    size_t pos = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        if (offsets != NULL) {
+            offsets[i] = pos;
+        }
+
+        size_t remaining = out_size - pos;
+        size_t len;
+
+        if (remaining >= UT_MAX_STRING_LEN) {
+            char *end = ut_internal_render_cached(&cache, in[i].nanos, out + pos,
+                                                  include_nanos, NULL);
+            len = (size_t)(end - (out + pos));
+        } else {
+            char tmp[UT_MAX_STRING_LEN];
+            char *end = ut_internal_render_cached(&cache, in[i].nanos, tmp,
+                                                  include_nanos, NULL);
+            len = (size_t)(end - tmp);
+            if (len + 1 > remaining) {
+                if (out_len != NULL) {
+                    *out_len = pos;
+                }
+                return UT_ERR_BUFFER_TOO_SMALL;
+            }
+            memcpy(out + pos, tmp, len);
+        }
+
+        out[pos + len] = delim;
+        pos += len + 1;
+    }
+
+    if (offsets != NULL) {
+        offsets[n] = pos;
+    }
+    if (out_len != NULL) {
+        *out_len = pos;
+    }
+
+    return UT_OK;
+}
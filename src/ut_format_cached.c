@@ -0,0 +1,79 @@
+/**
+ * @file ut_format_cached.c
+ * @brief Implementation of ut_format_cached() and its cache statistics.
+ */
+
+
+#include "universal_timestamp.h"
+#include "core/ut_internal.h"
+#include <stdatomic.h>
+
+#define UT_CACHE_FLUSH_INTERVAL 64
+
+static UT_THREAD_LOCAL ut_internal_day_cache_t t_cache = UT_DAY_CACHE_INIT;
+static UT_THREAD_LOCAL uint32_t t_pending_hits = 0;
+static UT_THREAD_LOCAL uint32_t t_pending_misses = 0;
+
+static atomic_uint_fast64_t g_cache_hits = ATOMIC_VAR_INIT(0);
+static atomic_uint_fast64_t g_cache_misses = ATOMIC_VAR_INIT(0);
+
+/* Publishes this thread's pending hit/miss counts to the shared totals. */
+static void flush_pending(void) {
+    if (t_pending_hits != 0) {
+        atomic_fetch_add_explicit(&g_cache_hits, t_pending_hits, memory_order_relaxed);
+        t_pending_hits = 0;
+    }
+    if (t_pending_misses != 0) {
+        atomic_fetch_add_explicit(&g_cache_misses, t_pending_misses, memory_order_relaxed);
+        t_pending_misses = 0;
+    }
+}
+
+/**
+ * @brief Format a timestamp using the calling thread's day cache.
+ */
+
+int ut_format_cached(ut_timestamp_t ts, char *buf, size_t buf_size, bool include_nanos) {
+    if (buf == NULL || buf_size < UT_MAX_STRING_LEN) {
+        return -1;
+    }
+
+    bool hit;
+    char *end = ut_internal_render_cached(&t_cache, ts.nanos, buf, include_nanos, &hit);
+
+    if (hit) {
+        t_pending_hits++;
+    } else {
+        t_pending_misses++;
+    }
+    if (t_pending_hits + t_pending_misses >= UT_CACHE_FLUSH_INTERVAL) {
+        flush_pending();
+    }
+
+    return (int)(end - buf);
+}
+
+/**
+ * @brief Read the process-wide ut_format_cached() hit and miss counters.
+ */
+
+void ut_get_format_cache_stats(ut_format_cache_stats_t *out) {
+    if (out == NULL) {
+        return;
+    }
+
+    flush_pending();
+    out->hits = atomic_load_explicit(&g_cache_hits, memory_order_relaxed);
+    out->misses = atomic_load_explicit(&g_cache_misses, memory_order_relaxed);
+}
+
+/**
+ * @brief Reset the ut_format_cached() hit and miss counters to zero.
+ */
+
+void ut_reset_format_cache_stats(void) {
+    t_pending_hits = 0;
+    t_pending_misses = 0;
+    atomic_store_explicit(&g_cache_hits, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_cache_misses, 0, memory_order_relaxed);
+}
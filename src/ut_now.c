@@ -1,110 +1,21 @@
 /**
  * @file ut_now.c
- * @brief Implementation of ut_now() and ut_now_monotonic() functions.
+ * @brief Implementation of ut_now(), ut_now_monotonic() and ut_now_monotonic_n().
  */
 
 
+/* The out-of-line accessors below are always exported, whatever mode the consumer picks. */
+#undef UT_INLINE_ACCESSORS
+
 #include "universal_timestamp.h"
-#include <time.h>
-#include <stdatomic.h>
-
-/* Platform detection */
-#if defined(_WIN32) || defined(_WIN64)
-    #define UT_PLATFORM_WINDOWS 1
-    #include <windows.h>
-#elif defined(__EMSCRIPTEN__)
-    #define UT_PLATFORM_EMSCRIPTEN 1
-    #include <emscripten.h>
-#elif defined(__APPLE__) && defined(__MACH__)
-    #define UT_PLATFORM_APPLE 1
-    #include <TargetConditionals.h>
-    #if TARGET_OS_IPHONE
-        #define UT_PLATFORM_IOS 1
-    #else
-        #define UT_PLATFORM_MACOS 1
-    #endif
-#elif defined(__ANDROID__)
-    #define UT_PLATFORM_ANDROID 1
-#elif defined(__linux__)
-    #define UT_PLATFORM_LINUX 1
-#elif defined(__FreeBSD__)
-    #define UT_PLATFORM_FREEBSD 1
-#elif defined(__OpenBSD__)
-    #define UT_PLATFORM_OPENBSD 1
-#elif defined(__NetBSD__)
-    #define UT_PLATFORM_NETBSD 1
-#elif defined(__DragonFly__)
-    #define UT_PLATFORM_DRAGONFLY 1
-#elif defined(__sun) && defined(__SVR4)
-    #define UT_PLATFORM_SOLARIS 1
-#elif defined(_AIX)
-    #define UT_PLATFORM_AIX 1
-#elif defined(__hpux)
-    #define UT_PLATFORM_HPUX 1
-#elif defined(__QNX__) || defined(__QNXNTO__)
-    #define UT_PLATFORM_QNX 1
-#elif defined(__HAIKU__)
-    #define UT_PLATFORM_HAIKU 1
-#elif defined(__CYGWIN__)
-    #define UT_PLATFORM_CYGWIN 1
-#elif defined(__MINGW32__) || defined(__MINGW64__)
-    #define UT_PLATFORM_MINGW 1
-#elif defined(__vxworks)
-    #define UT_PLATFORM_VXWORKS 1
-#elif defined(__Fuchsia__)
-    #define UT_PLATFORM_FUCHSIA 1
-#endif
-
-/* POSIX availability check */
-#if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 199309L
-    #define UT_HAS_POSIX_CLOCK 1
-#elif defined(UT_PLATFORM_APPLE) || defined(UT_PLATFORM_LINUX) || \
-      defined(UT_PLATFORM_FREEBSD) || defined(UT_PLATFORM_OPENBSD) || \
-      defined(UT_PLATFORM_NETBSD) || defined(UT_PLATFORM_DRAGONFLY) || \
-      defined(UT_PLATFORM_ANDROID) || defined(UT_PLATFORM_SOLARIS) || \
-      defined(UT_PLATFORM_AIX) || defined(UT_PLATFORM_HPUX) || \
-      defined(UT_PLATFORM_QNX) || defined(UT_PLATFORM_HAIKU) || \
-      defined(UT_PLATFORM_CYGWIN) || defined(UT_PLATFORM_VXWORKS) || \
-      defined(UT_PLATFORM_FUCHSIA)
-    #define UT_HAS_POSIX_CLOCK 1
-#endif
-
-static atomic_int_fast64_t g_last_monotonic = ATOMIC_VAR_INIT(0);
-static ut_regression_callback_t g_regression_callback = NULL;
-
-#if defined(UT_PLATFORM_WINDOWS)
-/* Windows epoch (1601-01-01) to Unix epoch (1970-01-01) in 100-nanosecond intervals */
-static const int64_t WINDOWS_TICK = 10000000LL;
-static const int64_t WINDOWS_TO_UNIX_EPOCH = 11644473600LL;
-#endif
+#include "core/ut_internal.h"
 
 /**
  * @brief Get the current UTC timestamp.
  */
 
 ut_timestamp_t ut_now(void) {
-    ut_timestamp_t ts;
-
-#if defined(UT_PLATFORM_WINDOWS)
-    FILETIME ft;
-    GetSystemTimePreciseAsFileTime(&ft);
-    int64_t wintime = ((int64_t)ft.dwHighDateTime << 32) | ft.dwLowDateTime;
-    int64_t unix_100ns = wintime - (WINDOWS_TO_UNIX_EPOCH * WINDOWS_TICK);
-    ts.nanos = unix_100ns * 100LL;
-
-#elif defined(UT_PLATFORM_EMSCRIPTEN)
-    double ms = emscripten_get_now();
-    ts.nanos = (int64_t)(ms * 1000000.0);
-
-#elif defined(UT_HAS_POSIX_CLOCK)
-    struct timespec spec;
-    clock_gettime(CLOCK_REALTIME, &spec);
-    ts.nanos = (int64_t)spec.tv_sec * 1000000000LL + spec.tv_nsec;
-
-#else
-    ts.nanos = (int64_t)time(NULL) * 1000000000LL;
-#endif
-
+    ut_timestamp_t ts = {ut_internal_clock_now()};
     return ts;
 }
 
@@ -113,35 +24,68 @@ ut_timestamp_t ut_now(void) {
  */
 
 ut_timestamp_t ut_now_monotonic(void) {
-    ut_timestamp_t current = ut_now();
-
-    int64_t last = atomic_load(&g_last_monotonic);
-    int64_t new_val;
-
-    do {
-        if (current.nanos <= last) {
-            new_val = last + 1;
-
-            if (g_regression_callback != NULL) {
-                ut_timestamp_t expected = {last + 1};
-                ut_timestamp_t adjusted = {new_val};
-                g_regression_callback(expected, current, adjusted);
-            }
-        } else {
-            new_val = current.nanos;
-        }
-    } while (!atomic_compare_exchange_weak(&g_last_monotonic, &last, new_val));
-
-    ut_timestamp_t result = {new_val};
+    ut_timestamp_t result = {ut_internal_monotonic_advance(ut_internal_monotonic_counter(),
+                                                           ut_internal_clock_now(), 0, 0, 1)};
     return result;
 }
 
+/**
+ * @brief Reserve n consecutive monotonic timestamps with one atomic update.
+ */
+
+ut_error_t ut_now_monotonic_n(ut_timestamp_t *out, size_t n) {
+    if (n == 0) {
+        return UT_OK;
+    }
+    if (out == NULL) {
+        return UT_ERR_NULL_POINTER;
+    }
+
+    int64_t first = ut_internal_monotonic_advance(ut_internal_monotonic_counter(),
+                                                  ut_internal_clock_now(), 0, 0, n);
+    for (size_t i = 0; i < n; i++) {
+        out[i].nanos = first + (int64_t)i;
+    }
+
+    return UT_OK;
+}
+
 /**
  * @brief Set a callback for clock regression events.
  */
 
 void ut_set_regression_callback(ut_regression_callback_t callback) {
-    g_regression_callback = callback;
+    ut_internal_set_regression_callback(callback);
+}
+
+/**
+ * @brief Choose how clock regressions are delivered.
+ */
+
+ut_error_t ut_set_regression_delivery(ut_regression_delivery_t mode, int64_t interval_ns) {
+    if ((int)mode < UT_REGRESSION_SYNC || (int)mode > UT_REGRESSION_ASYNC || interval_ns < 0) {
+        return UT_ERR_OUT_OF_RANGE;
+    }
+    return ut_internal_regression_delivery(mode, interval_ns);
+}
+
+/**
+ * @brief Remove queued clock regressions, oldest first.
+ */
+
+size_t ut_drain_regression_events(ut_regression_event_t *out, size_t capacity) {
+    if (out == NULL) {
+        return 0;
+    }
+    return ut_internal_regression_drain(out, capacity);
+}
+
+/**
+ * @brief Count regressions dropped because the queue was full.
+ */
+
+uint64_t ut_get_regression_overflow(void) {
+    return ut_internal_regression_overflow();
 }
 
 /**
@@ -175,6 +119,9 @@ const char *ut_error_string(ut_error_t err) {
         case UT_ERR_FRACTION_TOO_LONG: return "Fractional seconds too long";
         case UT_ERR_LEAP_SECOND:      return "Leap second not supported";
         case UT_ERR_NULL_POINTER:     return "Null pointer";
+        case UT_ERR_BUFFER_TOO_SMALL: return "Buffer too small";
+        case UT_ERR_OUT_OF_MEMORY:    return "Out of memory";
+        case UT_ERR_UNAVAILABLE:      return "Resource unavailable";
         default:                      return "Unknown error";
     }
 }
@@ -192,27 +139,5 @@ ut_calendar_t ut_get_calendar(void) {
  */
 
 ut_precision_t ut_get_clock_precision(void) {
-    const int NUM_SAMPLES = 100;
-    int64_t samples[100];
-    
-    for (int i = 0; i < NUM_SAMPLES; i++) {
-        ut_timestamp_t ts = ut_now();
-        samples[i] = ts.nanos;
-    }
-    
-    int has_nanos = 0;
-    int has_micros = 0;
-    int has_millis = 0;
-    
-    for (int i = 0; i < NUM_SAMPLES; i++) {
-        int64_t n = samples[i];
-        if (n % 1000 != 0) has_nanos = 1;
-        if (n % 1000000 != 0) has_micros = 1;
-        if (n % 1000000000 != 0) has_millis = 1;
-    }
-    
-    if (has_nanos) return UT_PRECISION_NANOSECOND;
-    if (has_micros) return UT_PRECISION_MICROSECOND;
-    if (has_millis) return UT_PRECISION_MILLISECOND;
-    return UT_PRECISION_SECOND;
+    return ut_internal_clock_probe_precision(ut_internal_clock_default());
 }
@@ -0,0 +1,146 @@
+/**
+ * @file ut_parse_batch.c
+ * @brief Implementation of ut_parse_batch(), ut_parse_delimited() and ut_parse_offsets().
+ */
+
+
+#include "universal_timestamp.h"
+#include "core/ut_internal.h"
+#include <string.h>
+
+/* Parses one length-delimited record, storing its result and error code. */
+static ut_error_t parse_record(const char *str, size_t len, ut_timestamp_t *out,
+                               ut_error_t *err_slot, bool strict) {
+    ut_error_t err = UT_STAT_PARSE(strict ? ut_internal_parse_strict_fast(str, len, out)
+                                          : ut_internal_parse_scalar(str, len, out, false));
+    if (err != UT_OK) {
+        out->nanos = 0;
+    }
+    if (err_slot != NULL) {
+        *err_slot = err;
+    }
+    return err;
+}
+
+/**
+ * @brief Parse an array of timestamp strings in one call.
+ */
+
+ut_error_t ut_parse_batch(const char *const *strs, const size_t *lens, size_t n,
+                          ut_timestamp_t *out, ut_error_t *errs, bool strict) {
+    if (n == 0) {
+        return UT_OK;
+    }
+    if (strs == NULL || out == NULL) {
+        return UT_ERR_NULL_POINTER;
+    }
+
+    ut_error_t first = UT_OK;
+
+    for (size_t i = 0; i < n; i++) {
+        ut_error_t err;
+        if (strs[i] == NULL) {
+            out[i].nanos = 0;
+            err = UT_ERR_NULL_POINTER;
+            if (errs != NULL) {
+                errs[i] = err;
+            }
+        } else {
+            size_t len = lens != NULL ? lens[i] : strlen(strs[i]);
+            err = parse_record(strs[i], len, &out[i], errs != NULL ? &errs[i] : NULL, strict);
+        }
+        if (first == UT_OK) {
+            first = err;
+        }
+    }
+
+    return first;
+}
+
+/**
+ * @brief Parse delimiter-separated timestamps from one contiguous buffer.
+ */
+
+ut_error_t ut_parse_delimited(const char *buf, size_t len, char delim,
+                              ut_timestamp_t *out, ut_error_t *errs,
+                              size_t capacity, size_t *count, bool strict) {
+    if (count != NULL) {
+        *count = 0;
+    }
+    if (len == 0) {
+        return UT_OK;
+    }
+    if (buf == NULL || out == NULL) {
+        return UT_ERR_NULL_POINTER;
+    }
+
+    ut_error_t first = UT_OK;
+    size_t records = 0;
+    const char *p = buf;
+    const char *end = buf + len;
+
+    while (p < end) {
+        if (records == capacity) {
+            first = UT_ERR_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        const char *stop = memchr(p, delim, (size_t)(end - p));
+        const char *next = stop != NULL ? stop + 1 : end;
+        if (stop == NULL) {
+            stop = end;
+        }
+        if (delim == '\n' && stop > p && stop[-1] == '\r') {
+            stop--;
+        }
+
+        ut_error_t err = parse_record(p, (size_t)(stop - p), &out[records],
+                                      errs != NULL ? &errs[records] : NULL, strict);
+        if (first == UT_OK) {
+            first = err;
+        }
+        records++;
+        p = next;
+    }
+
+    if (count != NULL) {
+        *count = records;
+    }
+    return first;
+}
+
+/**
+ * @brief Parse timestamps located by an offsets array within one buffer.
+ */
+
+ut_error_t ut_parse_offsets(const char *buf, const size_t *offsets, size_t n,
+                            ut_timestamp_t *out, ut_error_t *errs, bool strict) {
+    if (n == 0) {
+        return UT_OK;
+    }
+    if (buf == NULL || offsets == NULL || out == NULL) {
+        return UT_ERR_NULL_POINTER;
+    }
+
+    ut_error_t first = UT_OK;
+
+    for (size_t i = 0; i < n; i++) {
+        size_t start = offsets[i];
+        size_t stop = offsets[i + 1] > start ? offsets[i + 1] : start;
+
+        if (stop > start && (buf[stop - 1] == '\n' || buf[stop - 1] == '\0')) {
+            stop--;
+            if (buf[stop] == '\n' && stop > start && buf[stop - 1] == '\r') {
+                stop--;
+            }
+        }
+
+        ut_error_t err = parse_record(buf + start, stop - start, &out[i],
+                                      errs != NULL ? &errs[i] : NULL, strict);
+        if (first == UT_OK) {
+            first = err;
+        }
+    }
+
+    return first;
+}
@@ -0,0 +1,37 @@
+/**
+ * @file ut_shared_clock.c
+ * @brief Implementation of ut_shared_clock_init(), ut_shared_clock_publish()
+ *        and ut_shared_clock_shutdown().
+ */
+
+
+#include "universal_timestamp.h"
+#include "core/ut_internal.h"
+
+/**
+ * @brief Attach to a shared-memory time page and monotonic counter.
+ */
+
+ut_error_t ut_shared_clock_init(const char *name, ut_shared_role_t role, int64_t interval_ns) {
+    if ((role != UT_SHARED_READER && role != UT_SHARED_PUBLISHER) || interval_ns < 0) {
+        return UT_ERR_OUT_OF_RANGE;
+    }
+    return ut_internal_shared_attach(name != NULL ? name : UT_SHARED_DEFAULT_NAME,
+                                     role == UT_SHARED_PUBLISHER, interval_ns);
+}
+
+/**
+ * @brief Publish the current precise time to the attached time page.
+ */
+
+ut_error_t ut_shared_clock_publish(void) {
+    return ut_internal_shared_publish() ? UT_OK : UT_ERR_UNAVAILABLE;
+}
+
+/**
+ * @brief Detach from the shared segment.
+ */
+
+void ut_shared_clock_shutdown(void) {
+    ut_internal_shared_detach();
+}
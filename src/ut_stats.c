@@ -0,0 +1,135 @@
+/**
+ * @file ut_stats.c
+ * @brief Implementation of ut_get_stats(), ut_reset_stats() and ut_format_stats().
+ */
+
+
+#include "universal_timestamp.h"
+#include "core/ut_internal.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *const k_result_labels[UT_STATS_RESULT_COUNT] = {
+    "ok", "invalid_format", "invalid_date", "out_of_range", "unsupported_offset",
+    "fraction_too_long", "leap_second", "null_pointer", "buffer_too_small",
+    "out_of_memory", "unavailable"
+};
+
+static const char *const k_source_labels[] = {"precise", "coarse", "tsc", "shared"};
+
+/* Output cursor for ut_format_stats(); overflowed is set once buf runs out. */
+typedef struct {
+    char *buf;
+    size_t size;
+    size_t len;
+    bool overflowed;
+} stats_writer_t;
+
+/* Appends formatted text, recording overflow instead of truncating silently. */
+static void put(stats_writer_t *w, const char *fmt, ...) {
+    if (w->overflowed) {
+        return;
+    }
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(w->buf + w->len, w->size - w->len, fmt, args);
+    va_end(args);
+    if (n < 0 || (size_t)n >= w->size - w->len) {
+        w->overflowed = true;
+        return;
+    }
+    w->len += (size_t)n;
+}
+
+/* Appends one counter family with its HELP and TYPE lines. */
+static void put_counter(stats_writer_t *w, const char *name, const char *help, uint64_t value) {
+    put(w, "# HELP %s %s\n# TYPE %s counter\n%s %llu\n",
+        name, help, name, name, (unsigned long long)value);
+}
+
+/* Returns the exposition label for a clock source. */
+static const char *source_label(ut_clock_source_t source) {
+    return (unsigned)source < sizeof(k_source_labels) / sizeof(k_source_labels[0])
+        ? k_source_labels[source] : "unknown";
+}
+
+/**
+ * @brief Read the library-wide statistics counters.
+ */
+
+ut_error_t ut_get_stats(ut_stats_t *out) {
+    if (out == NULL) {
+        return UT_ERR_NULL_POINTER;
+    }
+    memset(out, 0, sizeof(*out));
+
+    ut_clock_info_t info;
+    out->clock_source = ut_get_clock_source();
+    if (ut_get_clock_info(out->clock_source, &info) == UT_OK) {
+        out->clock_effective = info.effective;
+        out->clock_cost_ns = info.cost_ns;
+    }
+
+    uint64_t totals[UT_STAT_COUNT];
+    if (!ut_internal_stats_read(totals)) {
+        return UT_ERR_UNAVAILABLE;
+    }
+    out->monotonic_calls = totals[UT_STAT_MONOTONIC_CALLS];
+    out->monotonic_bumps = totals[UT_STAT_MONOTONIC_BUMPS];
+    out->monotonic_cas_retries = totals[UT_STAT_CAS_RETRIES];
+    out->shared_fallbacks = totals[UT_STAT_SHARED_FALLBACKS];
+    for (int i = 0; i < UT_STATS_RESULT_COUNT; i++) {
+        out->parse_results[i] = totals[UT_STAT_PARSE + i];
+    }
+    return UT_OK;
+}
+
+/**
+ * @brief Restart the statistics counters from zero.
+ */
+
+void ut_reset_stats(void) {
+    ut_internal_stats_reset();
+}
+
+/**
+ * @brief Render statistics in the Prometheus text exposition format.
+ */
+
+int ut_format_stats(const ut_stats_t *stats, char *buf, size_t buf_size) {
+    if (stats == NULL || buf == NULL || buf_size == 0) {
+        return -1;
+    }
+
+    stats_writer_t w = {buf, buf_size, 0, false};
+    put_counter(&w, "ut_monotonic_calls_total",
+                "Monotonic timestamp reservations.", stats->monotonic_calls);
+    put_counter(&w, "ut_monotonic_bumps_total",
+                "Reservations that found the clock at or behind the last value.",
+                stats->monotonic_bumps);
+    put_counter(&w, "ut_monotonic_cas_retries_total",
+                "Failed compare-and-swap attempts on a monotonic counter.",
+                stats->monotonic_cas_retries);
+    put_counter(&w, "ut_shared_fallbacks_total",
+                "Shared time page reads that fell back to the precise clock.",
+                stats->shared_fallbacks);
+
+    put(&w, "# HELP ut_parse_total Parse attempts by result.\n# TYPE ut_parse_total counter\n");
+    for (int i = 0; i < UT_STATS_RESULT_COUNT; i++) {
+        put(&w, "ut_parse_total{result=\"%s\"} %llu\n",
+            k_result_labels[i], (unsigned long long)stats->parse_results[i]);
+    }
+
+    put(&w, "# HELP ut_clock_cost_ns Measured cost of one clock reading.\n"
+            "# TYPE ut_clock_cost_ns gauge\n"
+            "ut_clock_cost_ns{source=\"%s\",effective=\"%s\"} %.2f\n",
+        source_label(stats->clock_source), source_label(stats->clock_effective),
+        stats->clock_cost_ns);
+
+    if (w.overflowed) {
+        buf[0] = '\0';
+        return -1;
+    }
+    return (int)w.len;
+}
@@ -1,8 +1,20 @@
 #include "universal_timestamp.h"
+#include "core/ut_internal.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <pthread.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/wait.h>
+    #include <time.h>
+    #include <unistd.h>
+    #define UT_TEST_FORK 1
+#endif
+
 static int tests_run = 0;
 static int tests_failed = 0;
 
@@ -140,6 +152,8 @@ static void test_error_strings(void) {
     ASSERT("OK string", strcmp(ut_error_string(UT_OK), "Success") == 0);
     ASSERT("INVALID_FORMAT string", strlen(ut_error_string(UT_ERR_INVALID_FORMAT)) > 0);
     ASSERT("INVALID_DATE string", strlen(ut_error_string(UT_ERR_INVALID_DATE)) > 0);
+    ASSERT("OUT_OF_MEMORY string", strcmp(ut_error_string(UT_ERR_OUT_OF_MEMORY), "Out of memory") == 0);
+    ASSERT("UNAVAILABLE string", strcmp(ut_error_string(UT_ERR_UNAVAILABLE), "Resource unavailable") == 0);
 }
 
 static void test_calendar(void) {
@@ -319,6 +333,1541 @@ static void test_error_conditions(void) {
     ASSERT("invalid hour", err == UT_ERR_OUT_OF_RANGE);
 }
 
+static bool legacy_is_leap(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
+}
+
+static int legacy_days_in_month(int year, int month) {
+    static const int dim[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return (month == 2 && legacy_is_leap(year)) ? 29 : dim[month];
+}
+
+static int64_t legacy_days_from_epoch(int year, int month, int day) {
+    int64_t days = 0;
+    if (year >= 1970) {
+        for (int y = 1970; y < year; y++) days += legacy_is_leap(y) ? 366 : 365;
+    } else {
+        for (int y = year; y < 1970; y++) days -= legacy_is_leap(y) ? 366 : 365;
+    }
+    for (int m = 1; m < month; m++) days += legacy_days_in_month(year, m);
+    return days + day - 1;
+}
+
+static void legacy_civil_from_days(int64_t days, int *year, int *month, int *day) {
+    int y = 1970;
+    if (days >= 0) {
+        while (days >= (legacy_is_leap(y) ? 366 : 365)) {
+            days -= legacy_is_leap(y) ? 366 : 365;
+            y++;
+        }
+    } else {
+        while (days < 0) {
+            y--;
+            days += legacy_is_leap(y) ? 366 : 365;
+        }
+    }
+    int m = 1;
+    while (days >= legacy_days_in_month(y, m)) {
+        days -= legacy_days_in_month(y, m);
+        m++;
+    }
+    *year = y;
+    *month = m;
+    *day = (int)days + 1;
+}
+
+static void test_civil_engine_equivalence(void) {
+    printf("\n--- test_civil_engine_equivalence ---\n");
+
+    int year_mismatch = 0;
+    for (int y = 0; y <= 9999; y++) {
+        int64_t legacy = legacy_days_from_epoch(y, 1, 1);
+        int ly, lm, ld, cy, cm, cd;
+        legacy_civil_from_days(legacy, &ly, &lm, &ld);
+        ut_internal_civil_from_days(legacy, &cy, &cm, &cd);
+        if (ut_internal_days_from_civil(y, 1, 1) != legacy ||
+            cy != ly || cm != lm || cd != ld) {
+            year_mismatch++;
+        }
+    }
+    ASSERT_EQ_INT("year starts 0000-9999 match legacy loops", year_mismatch, 0);
+
+    int day_mismatch = 0;
+    int64_t days = legacy_days_from_epoch(0, 1, 1);
+    int y = 0, m = 1, d = 1;
+    long checked = 0;
+    while (y <= 9999) {
+        int cy, cm, cd;
+        ut_internal_civil_from_days(days, &cy, &cm, &cd);
+        if (ut_internal_days_from_civil(y, m, d) != days ||
+            cy != y || cm != m || cd != d) {
+            day_mismatch++;
+        }
+        checked++;
+        days++;
+        if (++d > legacy_days_in_month(y, m)) {
+            d = 1;
+            if (++m > 12) {
+                m = 1;
+                y++;
+            }
+        }
+    }
+    ASSERT_EQ_INT("every day 0000-01-01..9999-12-31 matches", day_mismatch, 0);
+    ASSERT_EQ_INT("day count covers full range", checked, 3652425L);
+    ASSERT_EQ_INT("9999-12-31 day index", ut_internal_days_from_civil(9999, 12, 31), 2932896LL);
+
+    int nanos_mismatch = 0;
+    const int64_t nanos_per_day = 86400LL * 1000000000LL;
+    for (int64_t day = -106000; day <= 106000; day++) {
+        int64_t start = day * nanos_per_day;
+        int year, month, dd, hour, minute, second, frac;
+        int ly, lm, ld;
+        legacy_civil_from_days(day, &ly, &lm, &ld);
+
+        ut_internal_from_nanos(start, &year, &month, &dd, &hour, &minute, &second, &frac);
+        if (year != ly || month != lm || dd != ld || hour != 0 || minute != 0 ||
+            second != 0 || frac != 0) {
+            nanos_mismatch++;
+        }
+        if (ut_internal_to_nanos(ly, lm, ld, 0, 0, 0, 0) != start) {
+            nanos_mismatch++;
+        }
+
+        ut_internal_from_nanos(start - 1, &year, &month, &dd, &hour, &minute, &second, &frac);
+        legacy_civil_from_days(day - 1, &ly, &lm, &ld);
+        if (year != ly || month != lm || dd != ld || hour != 23 || minute != 59 ||
+            second != 59 || frac != 999999999) {
+            nanos_mismatch++;
+        }
+    }
+    ASSERT_EQ_INT("nanos decomposition matches around day boundaries", nanos_mismatch, 0);
+}
+
+static int reference_format(int64_t nanos, char *buf, size_t size, bool include_nanos) {
+    int year, month, day, hour, minute, second, frac;
+    ut_internal_from_nanos(nanos, &year, &month, &day, &hour, &minute, &second, &frac);
+    if (include_nanos && frac > 0) {
+        char frac_buf[16];
+        snprintf(frac_buf, sizeof(frac_buf), "%09d", frac);
+        int digits = 9;
+        while (digits > 1 && frac_buf[digits - 1] == '0') digits--;
+        frac_buf[digits] = '\0';
+        return snprintf(buf, size, "%04d-%02d-%02dT%02d:%02d:%02d.%sZ",
+                        year, month, day, hour, minute, second, frac_buf);
+    }
+    return snprintf(buf, size, "%04d-%02d-%02dT%02d:%02d:%02dZ",
+                    year, month, day, hour, minute, second);
+}
+
+static void test_format_matches_snprintf(void) {
+    printf("\n--- test_format_matches_snprintf ---\n");
+
+    static const int64_t edges[] = {
+        0, 1, -1, 10, 100000000, 999999999, -999999999, 1000000000,
+        1734146001123456789LL, 1734146001000000001LL, 1734146001100000000LL,
+        INT64_MAX, INT64_MIN, INT64_MAX - 1, INT64_MIN + 1
+    };
+
+    int mismatches = 0;
+    char expected[64];
+    char actual[UT_MAX_STRING_LEN];
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    for (int i = 0; i < 200000; i++) {
+        int64_t nanos;
+        if (i < (int)(sizeof(edges) / sizeof(edges[0]))) {
+            nanos = edges[i];
+        } else {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            nanos = (int64_t)state;
+            if (i % 3 == 0) nanos -= nanos % 1000000;
+            if (i % 5 == 0) nanos -= nanos % 1000000000;
+        }
+        for (int with_nanos = 0; with_nanos <= 1; with_nanos++) {
+            int exp_len = reference_format(nanos, expected, sizeof(expected), with_nanos);
+            int len = ut_format(ut_from_unix_nanos(nanos), actual, sizeof(actual), with_nanos);
+            if (len != exp_len || strcmp(actual, expected) != 0) {
+                mismatches++;
+            }
+        }
+    }
+    ASSERT_EQ_INT("ut_format byte-identical to snprintf reference", mismatches, 0);
+}
+
+static void test_clock_sources(void) {
+    printf("\n--- test_clock_sources ---\n");
+
+    int64_t precise = ut_now_with(UT_CLOCK_PRECISE).nanos;
+    int64_t coarse = ut_now_with(UT_CLOCK_COARSE).nanos;
+    int64_t diff = coarse - precise;
+    ASSERT("coarse within 1s of precise", diff > -1000000000LL && diff < 1000000000LL);
+    ASSERT("tsc source readable", ut_now_with(UT_CLOCK_TSC).nanos > 1700000000000000000LL);
+
+    ut_clock_info_t info;
+    ut_error_t err = ut_get_clock_info(UT_CLOCK_PRECISE, &info);
+    ASSERT("precise info ok", err == UT_OK);
+    ASSERT("precise info effective", info.source == UT_CLOCK_PRECISE && info.effective == UT_CLOCK_PRECISE);
+    ASSERT("precise info cost measured", info.cost_ns >= 0.0);
+    ASSERT("precise info precision", info.precision >= UT_PRECISION_NANOSECOND);
+
+    err = ut_get_clock_info(UT_CLOCK_COARSE, &info);
+#if defined(__APPLE__)
+    ASSERT("coarse info ok", err == UT_OK && info.effective == UT_CLOCK_PRECISE);
+#else
+    ASSERT("coarse info ok", err == UT_OK && info.effective == UT_CLOCK_COARSE);
+#endif
+    ASSERT("coarse resolution non-negative", info.resolution_ns >= 0);
+
+    ASSERT("clock info null", ut_get_clock_info(UT_CLOCK_PRECISE, NULL) == UT_ERR_NULL_POINTER);
+    ASSERT("clock info bad source", ut_get_clock_info((ut_clock_source_t)42, &info) == UT_ERR_OUT_OF_RANGE);
+}
+
+#if defined(UT_TEST_FORK)
+
+/* Thread body for test_clock_probe(): reads the coarse probe while other threads race to run it. */
+static void *probe_worker(void *arg) {
+    ut_get_clock_info(UT_CLOCK_COARSE, (ut_clock_info_t *)arg);
+    return NULL;
+}
+
+/* Thread body for test_clock_probe(): resets the coarse probe while readers copy it. */
+static void *probe_resetter(void *arg) {
+    (void)arg;
+    for (int i = 0; i < 200; i++) {
+        ut_internal_clock_probe_reset(UT_CLOCK_COARSE);
+    }
+    return NULL;
+}
+
+#endif
+
+static void test_clock_probe(void) {
+    printf("\n--- test_clock_probe ---\n");
+
+    ut_clock_info_t first, again;
+    ut_get_clock_info(UT_CLOCK_PRECISE, &first);
+    ut_get_clock_info(UT_CLOCK_PRECISE, &again);
+    ASSERT("probe cached", memcmp(&first, &again, sizeof(first)) == 0);
+    ASSERT("precise step observed", first.step_ns > 0);
+    ASSERT("precise probe monotonic", first.regressions == 0);
+    ASSERT("precision from cache", ut_get_clock_precision() == first.precision);
+
+    int64_t start = ut_now_with(UT_CLOCK_PRECISE).nanos;
+    for (int i = 0; i < 1000; i++) {
+        ut_get_clock_precision();
+    }
+    int64_t elapsed = ut_now_with(UT_CLOCK_PRECISE).nanos - start;
+    ASSERT("cached precision is cheap", elapsed < 1000000LL);
+    printf("  precise: %.1f ns/call, %lld ns step, precision %d\n",
+           first.cost_ns, (long long)first.step_ns, first.precision);
+
+    ut_internal_clock_probe_reset(UT_CLOCK_COARSE);
+#if defined(UT_TEST_FORK)
+    pthread_t threads[4];
+    ut_clock_info_t infos[4];
+    for (int i = 0; i < 4; i++) {
+        pthread_create(&threads[i], NULL, probe_worker, &infos[i]);
+    }
+    for (int i = 0; i < 4; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    bool same = true;
+    for (int i = 1; i < 4; i++) {
+        same = same && memcmp(&infos[0], &infos[i], sizeof(infos[0])) == 0;
+    }
+    ASSERT("concurrent probe runs once", same);
+
+    pthread_t resetter;
+    pthread_create(&resetter, NULL, probe_resetter, NULL);
+    for (int i = 0; i < 4; i++) {
+        pthread_create(&threads[i], NULL, probe_worker, &infos[i]);
+    }
+    pthread_join(resetter, NULL);
+    for (int i = 0; i < 4; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    bool valid = true;
+    for (int i = 0; i < 4; i++) {
+        valid = valid && infos[i].source == UT_CLOCK_COARSE;
+    }
+    ASSERT("probe survives concurrent reset", valid);
+#endif
+    ut_get_clock_info(UT_CLOCK_COARSE, &first);
+    ASSERT("coarse step non-negative", first.step_ns >= 0);
+    ASSERT("coarse precision valid", first.precision >= UT_PRECISION_NANOSECOND &&
+           first.precision <= UT_PRECISION_SECOND);
+}
+
+static void test_tsc_clock(void) {
+    printf("\n--- test_tsc_clock ---\n");
+
+    ASSERT("default source precise", ut_get_clock_source() == UT_CLOCK_PRECISE);
+    ASSERT("set tsc source", ut_set_clock_source(UT_CLOCK_TSC) == UT_OK);
+    ASSERT("tsc source selected", ut_get_clock_source() == UT_CLOCK_TSC);
+
+    ut_clock_info_t info;
+    ut_get_clock_info(UT_CLOCK_TSC, &info);
+    ASSERT("tsc effective source", info.effective == UT_CLOCK_TSC || info.effective == UT_CLOCK_PRECISE);
+    printf("  tsc active: %s, %.1f ns/call\n", info.effective == UT_CLOCK_TSC ? "yes" : "no", info.cost_ns);
+
+    int64_t max_skew = 0;
+    for (int i = 0; i < 1000; i++) {
+        int64_t tsc = ut_now().nanos;
+        int64_t precise = ut_now_with(UT_CLOCK_PRECISE).nanos;
+        int64_t skew = tsc > precise ? tsc - precise : precise - tsc;
+        if (skew > max_skew) {
+            max_skew = skew;
+        }
+    }
+    ASSERT("tsc tracks realtime within 1ms", max_skew < 1000000LL);
+
+    bool ordered = true;
+    ut_timestamp_t prev = ut_now_monotonic();
+    for (int i = 0; i < 10000; i++) {
+        ut_timestamp_t cur = ut_now_monotonic();
+        if (cur.nanos <= prev.nanos) {
+            ordered = false;
+        }
+        prev = cur;
+    }
+    ASSERT("tsc monotonic ordering", ordered);
+    ASSERT("precision under tsc", ut_get_clock_precision() != UT_PRECISION_ERROR);
+
+    ASSERT("set bad source", ut_set_clock_source((ut_clock_source_t)9) == UT_ERR_OUT_OF_RANGE);
+    ASSERT("restore precise source", ut_set_clock_source(UT_CLOCK_PRECISE) == UT_OK);
+}
+
+static int regressions;
+
+static void count_regression(ut_timestamp_t expected, ut_timestamp_t actual, ut_timestamp_t adjusted) {
+    (void)expected;
+    (void)actual;
+    (void)adjusted;
+    regressions++;
+}
+
+static void test_monotonic_batch(void) {
+    printf("\n--- test_monotonic_batch ---\n");
+
+    ut_timestamp_t ids[4096];
+    ut_timestamp_t before = ut_now_monotonic();
+
+    ut_error_t err = ut_now_monotonic_n(ids, 4096);
+    ASSERT("monotonic_n ok", err == UT_OK);
+    ASSERT("monotonic_n after previous", ids[0].nanos > before.nanos);
+
+    bool consecutive = true;
+    for (int i = 1; i < 4096; i++) {
+        if (ids[i].nanos != ids[i - 1].nanos + 1) {
+            consecutive = false;
+        }
+    }
+    ASSERT("monotonic_n consecutive", consecutive);
+    ASSERT("monotonic after batch", ut_now_monotonic().nanos > ids[4095].nanos);
+
+    ut_set_clock_source(UT_CLOCK_COARSE);
+    ut_set_regression_callback(count_regression);
+    bool once_per_batch = true;
+    for (int i = 0; i < 8; i++) {
+        regressions = 0;
+        ut_now_monotonic_n(ids, 4096);
+        if (regressions > 1) {
+            once_per_batch = false;
+        }
+    }
+    ut_set_regression_callback(NULL);
+    ut_set_clock_source(UT_CLOCK_PRECISE);
+    ASSERT("regression callback at most once per batch", once_per_batch);
+
+    ASSERT("monotonic_n zero", ut_now_monotonic_n(NULL, 0) == UT_OK);
+    ASSERT("monotonic_n null", ut_now_monotonic_n(NULL, 3) == UT_ERR_NULL_POINTER);
+}
+
+static void test_regression_queue(void) {
+    printf("\n--- test_regression_queue ---\n");
+
+    ASSERT("bad delivery mode",
+           ut_set_regression_delivery((ut_regression_delivery_t)7, 0) == UT_ERR_OUT_OF_RANGE);
+    ASSERT("negative drain interval",
+           ut_set_regression_delivery(UT_REGRESSION_ASYNC, -1) == UT_ERR_OUT_OF_RANGE);
+
+    ut_set_clock_source(UT_CLOCK_COARSE);
+    ut_set_regression_callback(count_regression);
+    ASSERT("queue mode", ut_set_regression_delivery(UT_REGRESSION_QUEUE, 0) == UT_OK);
+
+    regressions = 0;
+    for (int i = 0; i < 100; i++) {
+        ut_now_monotonic();
+    }
+    ut_regression_event_t events[UT_REGRESSION_QUEUE_CAPACITY];
+    size_t n = ut_drain_regression_events(events, UT_REGRESSION_QUEUE_CAPACITY);
+    ASSERT("queued regressions drained", n > 0 && n <= 100);
+    ASSERT("queue mode skips callback", regressions == 0);
+
+    bool fields_ok = true;
+    for (size_t i = 0; i < n; i++) {
+        if (events[i].adjusted.nanos <= events[i].actual.nanos ||
+            events[i].expected.nanos != events[i].adjusted.nanos ||
+            (i > 0 && events[i].adjusted.nanos <= events[i - 1].adjusted.nanos)) {
+            fields_ok = false;
+        }
+    }
+    ASSERT("queued event fields", fields_ok);
+    ASSERT("queue empty after drain", ut_drain_regression_events(events, 1) == 0);
+    ASSERT("drain null", ut_drain_regression_events(NULL, 4) == 0);
+
+    uint64_t overflow = ut_get_regression_overflow();
+    for (int i = 0; i < 1000000 && ut_get_regression_overflow() == overflow; i++) {
+        ut_now_monotonic();
+    }
+    ASSERT("overflow counted", ut_get_regression_overflow() > overflow);
+    size_t total = 0;
+    while ((n = ut_drain_regression_events(events, 100)) > 0) {
+        total += n;
+    }
+    ASSERT("full queue holds capacity", total == UT_REGRESSION_QUEUE_CAPACITY);
+
+    ASSERT("async mode", ut_set_regression_delivery(UT_REGRESSION_ASYNC, 100000) == UT_OK);
+    for (int i = 0; i < 100; i++) {
+        ut_now_monotonic();
+    }
+    ASSERT("restore sync delivery", ut_set_regression_delivery(UT_REGRESSION_SYNC, 0) == UT_OK);
+    ASSERT("async delivered to callback", regressions > 0);
+    ASSERT("async left queue empty", ut_drain_regression_events(events, 1) == 0);
+
+    regressions = 0;
+    for (int i = 0; i < 100; i++) {
+        ut_now_monotonic();
+    }
+    ASSERT("sync fires callback", regressions > 0);
+
+    ut_set_regression_callback(NULL);
+    ut_set_clock_source(UT_CLOCK_PRECISE);
+}
+
+static void test_monotonic_gen(void) {
+    printf("\n--- test_monotonic_gen ---\n");
+
+    ut_monotonic_gen_t *gen = NULL;
+    ut_error_t err = ut_monotonic_gen_create(0, 0, &gen);
+    ASSERT("plain generator created", err == UT_OK && gen != NULL);
+
+    bool ordered = true;
+    ut_timestamp_t prev = ut_monotonic_gen_next(gen);
+    for (int i = 0; i < 10000; i++) {
+        ut_timestamp_t cur = ut_monotonic_gen_next(gen);
+        if (cur.nanos <= prev.nanos) {
+            ordered = false;
+        }
+        prev = cur;
+    }
+    ASSERT("plain generator strictly increasing", ordered);
+    ut_monotonic_gen_destroy(gen);
+
+    ut_monotonic_gen_t *a = NULL;
+    ut_monotonic_gen_t *b = NULL;
+    ut_monotonic_gen_create(3, 4, &a);
+    ut_monotonic_gen_create(12, 4, &b);
+
+    bool sharded_ok = true;
+    int64_t last_a = 0;
+    for (int i = 0; i < 1000; i++) {
+        int64_t va = ut_monotonic_gen_next(a).nanos;
+        int64_t vb = ut_monotonic_gen_next(b).nanos;
+        if ((va & 15) != 3 || (vb & 15) != 12 || va == vb || va <= last_a) {
+            sharded_ok = false;
+        }
+        last_a = va;
+    }
+    ASSERT("sharded generators keep shard id and order", sharded_ok);
+    ut_monotonic_gen_destroy(a);
+    ut_monotonic_gen_destroy(b);
+
+    ASSERT("shard id too large", ut_monotonic_gen_create(16, 4, &gen) == UT_ERR_OUT_OF_RANGE && gen == NULL);
+    ASSERT("shard bits too large", ut_monotonic_gen_create(0, UT_MONOTONIC_MAX_SHARD_BITS + 1, &gen) == UT_ERR_OUT_OF_RANGE);
+    ASSERT("null generator out", ut_monotonic_gen_create(0, 0, NULL) == UT_ERR_NULL_POINTER);
+    ASSERT("null generator next", ut_monotonic_gen_next(NULL).nanos == 0);
+    ut_monotonic_gen_destroy(NULL);
+}
+
+#if defined(UT_TEST_FORK)
+
+/* Orders int64 values for qsort(). */
+static int compare_nanos(const void *a, const void *b) {
+    int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+#endif
+
+static void test_shared_clock(void) {
+    printf("\n--- test_shared_clock ---\n");
+
+#if defined(UT_TEST_FORK)
+    enum { N = 4000 };
+    static int64_t values[2 * N];
+    char name[64];
+    snprintf(name, sizeof(name), "/uts-test-%ld", (long)getpid());
+    ut_clock_info_t info;
+
+    ASSERT("name without slash rejected", ut_shared_clock_init("uts", UT_SHARED_READER, 0) == UT_ERR_INVALID_FORMAT);
+    ASSERT("unknown role rejected", ut_shared_clock_init(name, (ut_shared_role_t)7, 0) == UT_ERR_OUT_OF_RANGE);
+    ASSERT("reader needs a segment", ut_shared_clock_init(name, UT_SHARED_READER, 0) == UT_ERR_UNAVAILABLE);
+    int open_fd = shm_open(name, O_RDWR | O_CREAT, 0600);
+    bool opened = open_fd >= 0 && fchmod(open_fd, 0666) == 0 && ftruncate(open_fd, 4096) == 0;
+    ASSERT("world-writable segment rejected", opened &&
+           ut_shared_clock_init(name, UT_SHARED_READER, 0) == UT_ERR_UNAVAILABLE);
+    if (open_fd >= 0) {
+        close(open_fd);
+        shm_unlink(name);
+    }
+    ASSERT("publish needs a publisher", ut_shared_clock_publish() == UT_ERR_UNAVAILABLE);
+    ASSERT("detached source falls back", ut_get_clock_info(UT_CLOCK_SHARED, &info) == UT_OK &&
+           info.effective == UT_CLOCK_PRECISE);
+
+    int ready[2], results[2];
+    if (pipe(ready) != 0 || pipe(results) != 0) {
+        ASSERT("pipes created", false);
+        return;
+    }
+
+    pid_t child = fork();
+    if (child == 0) {
+        char go;
+        int64_t out[N];
+        bool ok = read(ready[0], &go, 1) == 1 && ut_shared_clock_init(name, UT_SHARED_READER, 0) == UT_OK;
+        for (int i = 0; i < N; i++) {
+            out[i] = ok ? ut_now_monotonic().nanos : 0;
+        }
+        ssize_t written = write(results[1], out, sizeof(out));
+        ut_shared_clock_shutdown();
+        _exit(ok && written == (ssize_t)sizeof(out) ? 0 : 1);
+    }
+
+    int64_t before = ut_now_monotonic().nanos;
+    ASSERT("publisher attaches", ut_shared_clock_init(name, UT_SHARED_PUBLISHER, 0) == UT_OK);
+    ASSERT("second attach rejected", ut_shared_clock_init(name, UT_SHARED_READER, 0) == UT_ERR_UNAVAILABLE);
+    ASSERT("counter carried into segment", ut_now_monotonic().nanos > before);
+    struct stat st;
+    int fd = shm_open(name, O_RDONLY, 0);
+    ASSERT("segment private to owner", fd >= 0 && fstat(fd, &st) == 0 && (st.st_mode & 077) == 0);
+    if (fd >= 0) {
+        close(fd);
+    }
+
+    int64_t t0 = ut_now().nanos;
+    ASSERT("manual publish", ut_shared_clock_publish() == UT_OK);
+    int64_t page = ut_now_with(UT_CLOCK_SHARED).nanos;
+    ASSERT("page holds published time", page >= t0 && page <= ut_now().nanos);
+    ASSERT("page unchanged between publishes", ut_now_with(UT_CLOCK_SHARED).nanos == page);
+    ASSERT("attached source reported", ut_get_clock_info(UT_CLOCK_SHARED, &info) == UT_OK &&
+           info.effective == UT_CLOCK_SHARED);
+
+    /* The seqlock word follows the segment's 64-byte header; an odd value is a write in progress. */
+    fd = shm_open(name, O_RDWR, 0);
+    void *map = fd >= 0 ? mmap(NULL, 4096, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    if (map != MAP_FAILED) {
+        volatile unsigned *seq = (volatile unsigned *)((char *)map + 64);
+        unsigned saved = *seq;
+        ut_stats_t stats_before, stats_after;
+        ut_get_stats(&stats_before);
+        *seq = saved | 1u;
+        int64_t floor = ut_now_with(UT_CLOCK_PRECISE).nanos;
+        int64_t stuck = ut_now_with(UT_CLOCK_SHARED).nanos;
+        ASSERT("odd seq falls back to precise", stuck >= floor && stuck > page);
+        ut_get_stats(&stats_after);
+#if defined(UT_ENABLE_STATS)
+        ASSERT("fallback counted", stats_after.shared_fallbacks == stats_before.shared_fallbacks + 1);
+#else
+        ASSERT("fallback not counted", stats_after.shared_fallbacks == 0);
+#endif
+        *seq = saved;
+        ASSERT("page readable after seq restored", ut_now_with(UT_CLOCK_SHARED).nanos == page);
+        munmap(map, 4096);
+    } else {
+        ASSERT("segment mapped by test", false);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+
+    ASSERT("ready signal sent", write(ready[1], "g", 1) == 1);
+    for (int i = 0; i < N; i++) {
+        values[i] = ut_now_monotonic().nanos;
+    }
+    size_t got = 0;
+    while (got < sizeof(int64_t) * N) {
+        ssize_t r = read(results[0], (char *)(values + N) + got, sizeof(int64_t) * N - got);
+        if (r <= 0) {
+            break;
+        }
+        got += (size_t)r;
+    }
+    int status = 1;
+    waitpid(child, &status, 0);
+    ASSERT("reader process attached", got == sizeof(int64_t) * N && WIFEXITED(status) &&
+           WEXITSTATUS(status) == 0);
+
+    bool increasing = true;
+    for (int i = 1; i < 2 * N; i++) {
+        if (i != N && values[i] <= values[i - 1]) {
+            increasing = false;
+        }
+    }
+    ASSERT("each process strictly increasing", increasing);
+    int64_t last_child = values[2 * N - 1];
+    qsort(values, 2 * N, sizeof(values[0]), compare_nanos);
+    bool unique = true;
+    for (int i = 1; i < 2 * N; i++) {
+        unique = unique && values[i] != values[i - 1];
+    }
+    ASSERT("no value issued to both processes", unique);
+    ASSERT("publisher continues past reader", ut_now_monotonic().nanos > last_child);
+
+    ut_shared_clock_shutdown();
+    ASSERT("name removed on publisher shutdown", ut_shared_clock_init(name, UT_SHARED_READER, 0) ==
+           UT_ERR_UNAVAILABLE);
+    ASSERT("local counter continues past shared", ut_now_monotonic().nanos > values[2 * N - 1]);
+
+    ASSERT("threaded publisher attaches", ut_shared_clock_init(name, UT_SHARED_PUBLISHER, 1000000) == UT_OK);
+    int64_t first = ut_now_with(UT_CLOCK_SHARED).nanos;
+    struct timespec pause = {0, 20000000};
+    nanosleep(&pause, NULL);
+    ASSERT("publisher thread advances page", ut_now_with(UT_CLOCK_SHARED).nanos > first);
+    ASSERT("resolution is the interval", ut_get_clock_info(UT_CLOCK_SHARED, &info) == UT_OK &&
+           info.resolution_ns == 1000000);
+    ut_shared_clock_shutdown();
+    ut_shared_clock_shutdown();
+    ASSERT("shutdown is idempotent", ut_shared_clock_publish() == UT_ERR_UNAVAILABLE);
+
+    close(ready[0]);
+    close(ready[1]);
+    close(results[0]);
+    close(results[1]);
+#else
+    ASSERT("shared clock unsupported without fork", true);
+#endif
+}
+
+static void test_format_cached(void) {
+    printf("\n--- test_format_cached ---\n");
+
+    char expected[UT_MAX_STRING_LEN];
+    char actual[UT_MAX_STRING_LEN];
+    bool all_match = true;
+    int64_t nanos = -86400000000000LL * 3 - 1;
+
+    for (int i = 0; i < 20000; i++) {
+        ut_timestamp_t ts = ut_from_unix_nanos(nanos);
+        int a = ut_format(ts, expected, sizeof(expected), true);
+        int b = ut_format_cached(ts, actual, sizeof(actual), true);
+        if (a != b || strcmp(expected, actual) != 0) {
+            all_match = false;
+        }
+        nanos += (i % 7 == 0) ? 86400000000000LL / 3 : 1234567891LL;
+    }
+    ASSERT("cached output matches ut_format", all_match);
+
+    ut_format_cache_stats_t stats;
+    ut_reset_format_cache_stats();
+    ut_format_cached(ut_from_unix_nanos(1734146001000000000LL), actual, sizeof(actual), true);
+    ut_format_cached(ut_from_unix_nanos(1734146002000000000LL), actual, sizeof(actual), true);
+    ut_format_cached(ut_from_unix_nanos(1734146003000000000LL), actual, sizeof(actual), true);
+    ut_format_cached(ut_from_unix_nanos(1734246001000000000LL), actual, sizeof(actual), true);
+    ut_get_format_cache_stats(&stats);
+    ASSERT_EQ_INT("cache hits", stats.hits, 2);
+    ASSERT_EQ_INT("cache misses", stats.misses, 2);
+    ASSERT_EQ_STR("cached day change", actual, "2024-12-15T07:00:01Z");
+
+    ut_reset_format_cache_stats();
+    ut_get_format_cache_stats(&stats);
+    ASSERT("stats reset", stats.hits == 0 && stats.misses == 0);
+
+    ASSERT("cached small buffer rejected", ut_format_cached(ut_from_unix_nanos(0), actual, 10, true) == -1);
+}
+
+static void test_format_batch(void) {
+    printf("\n--- test_format_batch ---\n");
+
+    enum { N = 500 };
+    ut_timestamp_t in[N];
+    int64_t t = 1734134390000000000LL;
+    for (int i = 0; i < N; i++) {
+        in[i] = ut_from_unix_nanos(t);
+        t += (i % 7 == 0) ? 3600000000123LL : 1500000000LL;
+    }
+    in[N - 1] = ut_from_unix_nanos(-1);
+
+    static char slots[N][40];
+    ut_error_t err = ut_format_batch(in, N, &slots[0][0], 40, true);
+    ASSERT("format_batch succeeds", err == UT_OK);
+
+    int mismatches = 0;
+    char expected[UT_MAX_STRING_LEN];
+    for (int i = 0; i < N; i++) {
+        ut_format(in[i], expected, sizeof(expected), true);
+        if (strcmp(slots[i], expected) != 0) mismatches++;
+    }
+    ASSERT_EQ_INT("format_batch matches ut_format", mismatches, 0);
+
+    static char packed[N * (UT_MAX_STRING_LEN - 1)];
+    size_t offsets[N + 1];
+    size_t len = 0;
+    err = ut_format_batch_packed(in, N, packed, sizeof(packed), '\n', false, offsets, &len);
+    ASSERT("format_batch_packed succeeds", err == UT_OK);
+    ASSERT("packed length recorded", len == offsets[N]);
+
+    mismatches = 0;
+    for (int i = 0; i < N; i++) {
+        int elen = ut_format(in[i], expected, sizeof(expected), false);
+        size_t span = offsets[i + 1] - offsets[i] - 1;
+        if (span != (size_t)elen || memcmp(packed + offsets[i], expected, span) != 0 ||
+            packed[offsets[i + 1] - 1] != '\n') {
+            mismatches++;
+        }
+    }
+    ASSERT_EQ_INT("packed elements match ut_format", mismatches, 0);
+
+    char exact[21 + 21];
+    err = ut_format_batch_packed(in, 2, exact, sizeof(exact), '\0', false, NULL, &len);
+    ASSERT("exact-size packed buffer accepted", err == UT_OK && len == 42);
+    ut_format(in[1], expected, sizeof(expected), false);
+    ASSERT_EQ_STR("NUL-delimited second element", exact + 21, expected);
+
+    err = ut_format_batch_packed(in, 2, exact, sizeof(exact) - 1, '\0', false, NULL, &len);
+    ASSERT("short packed buffer rejected", err == UT_ERR_BUFFER_TOO_SMALL);
+    ASSERT("partial length reported", len == 21);
+
+    err = ut_format_batch(in, N, &slots[0][0], 16, true);
+    ASSERT("small stride rejected", err == UT_ERR_BUFFER_TOO_SMALL);
+
+    err = ut_format_batch(NULL, N, &slots[0][0], 40, true);
+    ASSERT("null input rejected", err == UT_ERR_NULL_POINTER);
+}
+
+static void test_parse_strict_simd_matches_scalar(void) {
+    printf("\n--- test_parse_strict_simd_matches_scalar ---\n");
+
+    static const char *seeds[] = {
+        "2024-12-14T03:13:21Z",
+        "2024-12-14T03:13:21.123456789Z",
+        "1970-01-01T00:00:00.5Z",
+        "2000-02-29T23:59:59.000000001Z",
+        "1900-02-29T00:00:00Z",
+        "2024-12-14T03:13:21.1234567890Z",
+        "2024-12-14T03:13:21+00:00",
+        "1677-09-21T00:12:43.145224192Z",
+        "2262-04-11T23:47:16.854775807Z",
+    };
+    static const char alphabet[] = "0123456789-:TZz.+ /9";
+
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    int mismatches = 0;
+    int accepted = 0;
+    char buf[40];
+
+    for (int i = 0; i < 400000; i++) {
+        const char *seed = seeds[i % (sizeof(seeds) / sizeof(seeds[0]))];
+        size_t len = strlen(seed);
+        memcpy(buf, seed, len + 1);
+
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        int edits = (int)(state % 3);
+        for (int e = 0; e < edits; e++) {
+            size_t at = (size_t)((state >> (8 + e * 8)) % len);
+            buf[at] = alphabet[(state >> (32 + e * 5)) % (sizeof(alphabet) - 1)];
+        }
+        if ((state >> 60) == 0) {
+            buf[(state >> 40) % (len + 1)] = '\0';
+        }
+
+        ut_timestamp_t fast = {0}, scalar = {0};
+        ut_error_t fast_err = ut_parse_strict(buf, &fast);
+        ut_error_t scalar_err = ut_internal_parse_scalar(buf, strlen(buf), &scalar, true);
+        if (fast_err != scalar_err || (fast_err == UT_OK && fast.nanos != scalar.nanos)) {
+            mismatches++;
+        }
+        if (fast_err == UT_OK) accepted++;
+    }
+
+    ASSERT_EQ_INT("strict fast path matches scalar oracle", mismatches, 0);
+    ASSERT("fuzz corpus exercises accepted inputs", accepted > 10000);
+}
+
+static void test_parse_batch(void) {
+    printf("\n--- test_parse_batch ---\n");
+
+    const char *strs[] = {
+        "2024-12-14T03:13:21Z",
+        "2024-12-14T03:13:21.5Z",
+        "2024-02-30T00:00:00Z",
+        NULL,
+        "2024-12-14T03:13:21",
+    };
+    ut_timestamp_t out[5];
+    ut_error_t errs[5];
+
+    ut_error_t err = ut_parse_batch(strs, NULL, 5, out, errs, true);
+    ASSERT("batch reports first failure", err == UT_ERR_INVALID_DATE);
+    ASSERT_EQ_INT("batch element 0", out[0].nanos, 1734146001000000000LL);
+    ASSERT_EQ_INT("batch element 1", out[1].nanos, 1734146001500000000LL);
+    ASSERT("batch element 2 invalid date", errs[2] == UT_ERR_INVALID_DATE && out[2].nanos == 0);
+    ASSERT("batch element 3 null", errs[3] == UT_ERR_NULL_POINTER);
+    ASSERT("batch element 4 strict missing Z", errs[4] == UT_ERR_INVALID_FORMAT);
+
+    err = ut_parse_batch(strs + 4, NULL, 1, out, errs, false);
+    ASSERT("lenient batch accepts missing Z", err == UT_OK && errs[0] == UT_OK);
+
+    const char record[] = "2024-12-14T03:13:21Zjunk";
+    const char *slice = record;
+    size_t slice_len = 20;
+    err = ut_parse_batch(&slice, &slice_len, 1, out, NULL, true);
+    ASSERT("explicit length ignores trailing bytes", err == UT_OK && out[0].nanos == 1734146001000000000LL);
+
+    const char lines[] = "2024-12-14T03:13:21Z\r\n1970-01-01T00:00:00Z\nnope\n2024-12-14T03:13:21.25Z\n";
+    ut_timestamp_t ts[8];
+    ut_error_t line_errs[8];
+    size_t count = 0;
+    err = ut_parse_delimited(lines, sizeof(lines) - 1, '\n', ts, line_errs, 8, &count, true);
+    ASSERT_EQ_INT("delimited record count", count, 4);
+    ASSERT("delimited first failure reported", err == UT_ERR_INVALID_FORMAT);
+    ASSERT("CRLF record parsed", line_errs[0] == UT_OK && ts[0].nanos == 1734146001000000000LL);
+    ASSERT("second record epoch", line_errs[1] == UT_OK && ts[1].nanos == 0);
+    ASSERT("bad record flagged", line_errs[2] == UT_ERR_INVALID_FORMAT);
+    ASSERT_EQ_INT("last record fraction", ts[3].nanos, 1734146001250000000LL);
+
+    err = ut_parse_delimited(lines, sizeof(lines) - 1, '\n', ts, NULL, 2, &count, true);
+    ASSERT("capacity overflow reported", err == UT_ERR_BUFFER_TOO_SMALL && count == 2);
+
+    enum { N = 64 };
+    ut_timestamp_t in[N];
+    for (int i = 0; i < N; i++) {
+        in[i] = ut_from_unix_nanos(1734146001000000000LL + (int64_t)i * 86399123456789LL);
+    }
+    char packed[N * (UT_MAX_STRING_LEN - 1)];
+    size_t offsets[N + 1];
+    ut_format_batch_packed(in, N, packed, sizeof(packed), '\n', true, offsets, NULL);
+
+    ut_timestamp_t back[N];
+    err = ut_parse_offsets(packed, offsets, N, back, NULL, true);
+    int mismatches = 0;
+    for (int i = 0; i < N; i++) {
+        if (back[i].nanos != in[i].nanos) mismatches++;
+    }
+    ASSERT("offsets parse of packed output succeeds", err == UT_OK);
+    ASSERT_EQ_INT("offsets round trip", mismatches, 0);
+
+    err = ut_parse_offsets(packed, NULL, N, back, NULL, true);
+    ASSERT("null offsets rejected", err == UT_ERR_NULL_POINTER);
+}
+
+static void test_parse_length_delimited(void) {
+    printf("\n--- test_parse_length_delimited ---\n");
+
+    ut_timestamp_t ts;
+    ut_error_t err;
+    const char record[] = "2024-12-14T03:13:21.5Z,GET,/index.html";
+
+    err = ut_parse_strict_n(record, 22, &ts);
+    ASSERT("strict_n parses slice", err == UT_OK);
+    ASSERT_EQ_INT("strict_n value", ts.nanos, 1734146001500000000LL);
+
+    err = ut_parse_strict_n(record, 23, &ts);
+    ASSERT("strict_n rejects trailing byte", err == UT_ERR_INVALID_FORMAT);
+
+    err = ut_parse_strict_n(record, 10, &ts);
+    ASSERT("strict_n rejects short slice", err == UT_ERR_INVALID_FORMAT);
+
+    err = ut_parse_lenient_n("2024-12-14T03:13:21xyz", 19, &ts);
+    ASSERT("lenient_n parses slice without Z", err == UT_OK && ts.nanos == 1734146001000000000LL);
+
+    err = ut_parse_strict_n(NULL, 20, &ts);
+    ASSERT("strict_n null rejected", err == UT_ERR_NULL_POINTER);
+
+    size_t used = 0;
+    const char json[] = "2024-12-14T03:13:21.5Z\",\"level\":\"info\"}";
+    err = ut_parse_prefix(json, sizeof(json) - 1, &ts, &used, true);
+    ASSERT("prefix strict parses", err == UT_OK);
+    ASSERT_EQ_INT("prefix strict consumed", used, 22);
+
+    err = ut_parse_prefix("2024-12-14T03:13:21,foo", 23, &ts, &used, true);
+    ASSERT("prefix strict still requires Z", err == UT_ERR_INVALID_FORMAT);
+
+    err = ut_parse_prefix("2024-12-14T03:13:21,foo", 23, &ts, &used, false);
+    ASSERT("prefix lenient stops at delimiter", err == UT_OK);
+    ASSERT_EQ_INT("prefix lenient consumed", used, 19);
+
+    err = ut_parse_prefix("2024-12-14T03:13:21+00:00 rest", 30, &ts, &used, false);
+    ASSERT("prefix lenient consumes offset", err == UT_OK);
+    ASSERT_EQ_INT("prefix offset consumed", used, 25);
+
+    err = ut_parse_prefix("2024-12-14T03:13:21.123Z", 24, &ts, &used, true);
+    ASSERT("prefix of whole string", err == UT_OK && used == 24);
+
+    err = ut_parse_prefix("2024-12-14", 10, &ts, &used, false);
+    ASSERT("prefix too short rejected", err == UT_ERR_INVALID_FORMAT && used == 0);
+}
+
+static void test_parse_flexible(void) {
+    printf("\n--- test_parse_flexible ---\n");
+
+    static const struct {
+        const char *input;
+        unsigned flags;
+        ut_error_t err;
+        int64_t nanos;
+        ut_parse_form_t form;
+        int32_t offset;
+    } cases[] = {
+        {"2024-12-14T12:00:00Z", 0, UT_OK, 1734177600000000000LL, UT_FORM_EXTENDED, 0},
+        {"2024-12-14T12:00:00", 0, UT_OK, 1734177600000000000LL, UT_FORM_EXTENDED, 0},
+        {"2024-12-14T12:00:00,25z", 0, UT_OK, 1734177600250000000LL, UT_FORM_EXTENDED, 0},
+        {"2024-12-14T12:00:00.1234567891Z", 0, UT_OK, 1734177600123456789LL, UT_FORM_EXTENDED, 0},
+        {"2024-12-14T12:00:00-0000", 0, UT_OK, 1734177600000000000LL, UT_FORM_EXTENDED, 0},
+        {"2024-12-14T13:00:00+01:00", 0, UT_ERR_UNSUPPORTED_OFFSET, 0, UT_FORM_EXTENDED, 0},
+        {"2024-12-14T13:00:00+01:00", UT_FLEX_OFFSETS, UT_OK, 1734177600000000000LL, UT_FORM_EXTENDED, 3600},
+        {"2024-12-14T06:30:00-05:30", UT_FLEX_OFFSETS, UT_OK, 1734177600000000000LL, UT_FORM_EXTENDED, -19800},
+        {"2024-12-14T14:00:00+0200", UT_FLEX_OFFSETS, UT_OK, 1734177600000000000LL, UT_FORM_EXTENDED, 7200},
+        {"2024-12-14T21:00:00+09", UT_FLEX_OFFSETS, UT_OK, 1734177600000000000LL, UT_FORM_EXTENDED, 32400},
+        {"2024-12-15T00:30:00+12:30", UT_FLEX_OFFSETS, UT_OK, 1734177600000000000LL, UT_FORM_EXTENDED, 45000},
+        {"2024-12-14T12:00:00+24:00", UT_FLEX_OFFSETS, UT_ERR_OUT_OF_RANGE, 0, UT_FORM_EXTENDED, 0},
+        {"2024-12-14T12:00:00+1:00", UT_FLEX_OFFSETS, UT_ERR_INVALID_FORMAT, 0, UT_FORM_EXTENDED, 0},
+        {"2024-12-14T12:00:00+01:0", UT_FLEX_OFFSETS, UT_ERR_INVALID_FORMAT, 0, UT_FORM_EXTENDED, 0},
+        {"2024-12-14 12:00:00Z", 0, UT_ERR_INVALID_FORMAT, 0, UT_FORM_EXTENDED, 0},
+        {"2024-12-14 12:00:00Z", UT_FLEX_SPACE, UT_OK, 1734177600000000000LL, UT_FORM_EXTENDED, 0},
+        {"2024-12-14t12:00:00", UT_FLEX_SPACE, UT_OK, 1734177600000000000LL, UT_FORM_EXTENDED, 0},
+        {"2024-12-14 13:00:00 +01:00", UT_FLEX_SPACE | UT_FLEX_OFFSETS, UT_OK, 1734177600000000000LL, UT_FORM_EXTENDED, 3600},
+        {"2024-12-14 12:00:00 ", UT_FLEX_ALL, UT_ERR_INVALID_FORMAT, 0, UT_FORM_EXTENDED, 0},
+        {"20241214T120000Z", 0, UT_ERR_INVALID_FORMAT, 0, UT_FORM_EXTENDED, 0},
+        {"20241214T120000Z", UT_FLEX_BASIC, UT_OK, 1734177600000000000LL, UT_FORM_BASIC, 0},
+        {"20241214T130000.5+0100", UT_FLEX_BASIC | UT_FLEX_OFFSETS, UT_OK, 1734177600500000000LL, UT_FORM_BASIC, 3600},
+        {"20241214 120000", UT_FLEX_BASIC | UT_FLEX_SPACE, UT_OK, 1734177600000000000LL, UT_FORM_BASIC, 0},
+        {"20241214T1200Z", UT_FLEX_BASIC, UT_ERR_INVALID_FORMAT, 0, UT_FORM_BASIC, 0},
+        {"20240230T000000Z", UT_FLEX_BASIC, UT_ERR_INVALID_DATE, 0, UT_FORM_BASIC, 0},
+        {"1734177600", 0, UT_ERR_INVALID_FORMAT, 0, UT_FORM_EXTENDED, 0},
+        {"1734177600", UT_FLEX_EPOCH, UT_OK, 1734177600000000000LL, UT_FORM_EPOCH_SECONDS, 0},
+        {"1734177600.25", UT_FLEX_EPOCH, UT_OK, 1734177600250000000LL, UT_FORM_EPOCH_SECONDS, 0},
+        {"1734177600123", UT_FLEX_EPOCH, UT_OK, 1734177600123000000LL, UT_FORM_EPOCH_MILLIS, 0},
+        {"1734177600123.5", UT_FLEX_EPOCH, UT_OK, 1734177600123500000LL, UT_FORM_EPOCH_MILLIS, 0},
+        {"1734177600123456", UT_FLEX_EPOCH, UT_OK, 1734177600123456000LL, UT_FORM_EPOCH_MICROS, 0},
+        {"1734177600123456789", UT_FLEX_EPOCH, UT_OK, 1734177600123456789LL, UT_FORM_EPOCH_NANOS, 0},
+        {"-1.5", UT_FLEX_EPOCH, UT_OK, -1500000000LL, UT_FORM_EPOCH_SECONDS, 0},
+        {"+0", UT_FLEX_EPOCH, UT_OK, 0, UT_FORM_EPOCH_SECONDS, 0},
+        {"9223372036854775807", UT_FLEX_EPOCH, UT_OK, INT64_MAX, UT_FORM_EPOCH_NANOS, 0},
+        {"-9223372036854775808", UT_FLEX_EPOCH, UT_OK, INT64_MIN, UT_FORM_EPOCH_NANOS, 0},
+        {"9223372036854775808", UT_FLEX_EPOCH, UT_ERR_OUT_OF_RANGE, 0, UT_FORM_EPOCH_NANOS, 0},
+        {"99999999999", UT_FLEX_EPOCH, UT_ERR_OUT_OF_RANGE, 0, UT_FORM_EPOCH_SECONDS, 0},
+        {"12345678901234567890", UT_FLEX_EPOCH, UT_ERR_OUT_OF_RANGE, 0, UT_FORM_EPOCH_SECONDS, 0},
+        {"1734177600.", UT_FLEX_EPOCH, UT_ERR_INVALID_FORMAT, 0, UT_FORM_EPOCH_SECONDS, 0},
+        {"17341776x", UT_FLEX_EPOCH, UT_ERR_INVALID_FORMAT, 0, UT_FORM_EPOCH_SECONDS, 0},
+        {"-", UT_FLEX_EPOCH, UT_ERR_INVALID_FORMAT, 0, UT_FORM_EPOCH_SECONDS, 0},
+        {"2262-04-11T23:47:16.854775807Z", 0, UT_OK, INT64_MAX, UT_FORM_EXTENDED, 0},
+        {"2262-04-11T23:47:16.854775808Z", 0, UT_ERR_OUT_OF_RANGE, 0, UT_FORM_EXTENDED, 0},
+        {"2262-04-12T00:47:16.854775807+01:00", UT_FLEX_OFFSETS, UT_OK, INT64_MAX, UT_FORM_EXTENDED, 3600},
+        {"1677-09-21T00:12:43.145224192Z", 0, UT_OK, INT64_MIN, UT_FORM_EXTENDED, 0},
+        {"1677-09-21T00:12:43.145224191Z", 0, UT_ERR_OUT_OF_RANGE, 0, UT_FORM_EXTENDED, 0},
+        {"9999-12-31T23:59:59Z", 0, UT_ERR_OUT_OF_RANGE, 0, UT_FORM_EXTENDED, 0},
+        {"2024-12-14T12:00:60Z", 0, UT_ERR_LEAP_SECOND, 0, UT_FORM_EXTENDED, 0},
+        {"2024-12-14T24:00:00Z", 0, UT_ERR_OUT_OF_RANGE, 0, UT_FORM_EXTENDED, 0},
+        {"2024-02-30T00:00:00Z", 0, UT_ERR_INVALID_DATE, 0, UT_FORM_EXTENDED, 0},
+        {"", UT_FLEX_ALL, UT_ERR_INVALID_FORMAT, 0, UT_FORM_EXTENDED, 0},
+    };
+
+    bool all_ok = true;
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        ut_timestamp_t ts = {0};
+        ut_parse_info_t info;
+        ut_error_t err = ut_parse_flexible(cases[i].input, strlen(cases[i].input),
+                                           cases[i].flags, &ts, &info);
+        bool ok = err == cases[i].err &&
+                  (err != UT_OK || (ts.nanos == cases[i].nanos && info.form == cases[i].form &&
+                                    info.offset_seconds == cases[i].offset));
+        if (!ok) {
+            printf("  flexible \"%s\" flags %u: err %d nanos %lld form %d offset %d\n",
+                   cases[i].input, cases[i].flags, (int)err, (long long)ts.nanos,
+                   (int)info.form, (int)info.offset_seconds);
+            all_ok = false;
+        }
+    }
+    ASSERT("flexible forms", all_ok);
+
+    bool agrees = true;
+    const char *lenient_inputs[] = {
+        "2024-12-14T12:00:00Z", "2024-12-14T12:00:00.5", "2024-12-14T12:00:00+00:00",
+        "2024-12-14T12:00:00.1234567891z", "2023-02-29T00:00:00Z", "2024-12-14T12:00:00+01:00",
+        "2024-12-14X12:00:00Z", "2024-12-14T12:00:00Zjunk"
+    };
+    for (size_t i = 0; i < sizeof(lenient_inputs) / sizeof(lenient_inputs[0]); i++) {
+        ut_timestamp_t a = {0}, b = {0};
+        size_t len = strlen(lenient_inputs[i]);
+        ut_error_t ea = ut_parse_lenient_n(lenient_inputs[i], len, &a);
+        ut_error_t eb = ut_parse_flexible(lenient_inputs[i], len, 0, &b, NULL);
+        if (ea != eb || a.nanos != b.nanos) {
+            agrees = false;
+        }
+    }
+    ASSERT("flexible without flags agrees on lenient inputs", agrees);
+
+    ut_timestamp_t lenient_ts;
+    ut_timestamp_t flexible_ts;
+    ASSERT("comma mark beyond lenient", ut_parse_lenient("2024-12-14T12:00:00,5Z", &lenient_ts) == UT_ERR_INVALID_FORMAT &&
+           ut_parse_flexible("2024-12-14T12:00:00,5Z", 22, 0, &flexible_ts, NULL) == UT_OK);
+    ASSERT("basic zero offset beyond lenient", ut_parse_lenient("2024-12-14T12:00:00+0000", &lenient_ts) == UT_ERR_INVALID_FORMAT &&
+           ut_parse_flexible("2024-12-14T12:00:00+0000", 24, 0, &flexible_ts, NULL) == UT_OK);
+
+    ut_parse_info_t info;
+    ut_timestamp_t ts;
+    ut_parse_flexible("2024-12-14T12:00:00", 19, 0, &ts, &info);
+    ASSERT("unzoned input reported", !info.zoned);
+    ut_parse_flexible("2024-12-14T12:00:00Z", 20, 0, &ts, &info);
+    ASSERT("zoned input reported", info.zoned);
+
+    const char *record = "1734177600,GET";
+    ASSERT("flexible length-delimited", ut_parse_flexible(record, 10, UT_FLEX_EPOCH, &ts, NULL) == UT_OK &&
+           ts.nanos == 1734177600000000000LL);
+    char *exact = malloc(4);
+    memcpy(exact, "2024", 4);
+    ASSERT("flexible unterminated 4-digit epoch", ut_parse_flexible(exact, 4, UT_FLEX_ALL, &ts, NULL) == UT_OK &&
+           ts.nanos == 2024000000000LL);
+    free(exact);
+
+    const char *full = "20241214T120000.5+01:00";
+    bool truncations_ok = true;
+    for (size_t n = 1; n <= strlen(full); n++) {
+        char *prefix = malloc(n);
+        memcpy(prefix, full, n);
+        ut_error_t err = ut_parse_flexible(prefix, n, UT_FLEX_ALL, &ts, NULL);
+        truncations_ok = truncations_ok && err >= UT_OK && err < UT_STATS_RESULT_COUNT;
+        free(prefix);
+    }
+    ASSERT("flexible unterminated prefixes", truncations_ok);
+    ASSERT("flexible null str", ut_parse_flexible(NULL, 0, 0, &ts, NULL) == UT_ERR_NULL_POINTER);
+    ASSERT("flexible null out", ut_parse_flexible("1", 1, UT_FLEX_EPOCH, NULL, NULL) == UT_ERR_NULL_POINTER);
+}
+
+static void test_duration_arithmetic(void) {
+    printf("\n--- test_duration_arithmetic ---\n");
+
+    ut_duration_t minute = ut_duration_from(1, UT_UNIT_MINUTE);
+    ASSERT_EQ_INT("minute in nanos", minute.nanos, 60000000000LL);
+    ASSERT_EQ_INT("duration_to truncates", ut_duration_to(ut_duration_from(90, UT_UNIT_SECOND), UT_UNIT_MINUTE), 1);
+    ASSERT_EQ_INT("duration_to negative toward zero", ut_duration_to(ut_duration_from(-90, UT_UNIT_SECOND), UT_UNIT_MINUTE), -1);
+    ASSERT_EQ_INT("duration_from saturates", ut_duration_from(INT64_MAX / 2, UT_UNIT_DAY).nanos, INT64_MAX);
+    ASSERT_EQ_INT("duration_from saturates negative", ut_duration_from(INT64_MIN / 2, UT_UNIT_DAY).nanos, INT64_MIN);
+
+    ut_timestamp_t ts = ut_from_unix_nanos(1734146001000000000LL);
+    ASSERT_EQ_INT("add saturating", ut_add_saturating(ts, minute).nanos, 1734146061000000000LL);
+    ASSERT_EQ_INT("sub saturating", ut_sub_saturating(ts, minute).nanos, 1734145941000000000LL);
+    ASSERT_EQ_INT("diff saturating", ut_diff_saturating(ut_add_saturating(ts, minute), ts).nanos, minute.nanos);
+
+    ut_timestamp_t max = ut_from_unix_nanos(INT64_MAX);
+    ut_timestamp_t min = ut_from_unix_nanos(INT64_MIN);
+    ASSERT_EQ_INT("add clamps high", ut_add_saturating(max, minute).nanos, INT64_MAX);
+    ASSERT_EQ_INT("sub clamps low", ut_sub_saturating(min, minute).nanos, INT64_MIN);
+    ASSERT_EQ_INT("diff clamps high", ut_diff_saturating(max, min).nanos, INT64_MAX);
+    ASSERT_EQ_INT("diff clamps low", ut_diff_saturating(min, max).nanos, INT64_MIN);
+
+    ut_timestamp_t out = ts;
+    ASSERT("add checked ok", ut_add_checked(ts, minute, &out) == UT_OK && out.nanos == ts.nanos + minute.nanos);
+    out = ts;
+    ASSERT("add checked overflow", ut_add_checked(max, minute, &out) == UT_ERR_OUT_OF_RANGE && out.nanos == ts.nanos);
+    ASSERT("sub checked overflow", ut_sub_checked(min, minute, &out) == UT_ERR_OUT_OF_RANGE);
+    ASSERT("sub checked ok", ut_sub_checked(ts, minute, &out) == UT_OK && out.nanos == ts.nanos - minute.nanos);
+
+    ut_duration_t span;
+    ut_timestamp_t before_ts = ut_sub_saturating(ts, minute);
+    ASSERT("diff checked overflow", ut_diff_checked(max, min, &span) == UT_ERR_OUT_OF_RANGE);
+    ASSERT("diff checked overflow from minimum", ut_diff_checked(ts, min, &span) == UT_ERR_OUT_OF_RANGE);
+    ASSERT("diff checked ok", ut_diff_checked(ts, before_ts, &span) == UT_OK && span.nanos == minute.nanos);
+    ASSERT("checked null", ut_add_checked(ts, minute, NULL) == UT_ERR_NULL_POINTER);
+}
+
+static void test_truncate(void) {
+    printf("\n--- test_truncate ---\n");
+
+    ut_timestamp_t ts = ut_from_unix_nanos(1734146001123456789LL);
+    ASSERT_EQ_INT("truncate second", ut_truncate(ts, UT_UNIT_SECOND).nanos, 1734146001000000000LL);
+    ASSERT_EQ_INT("truncate minute", ut_truncate(ts, UT_UNIT_MINUTE).nanos, 1734145980000000000LL);
+    ASSERT_EQ_INT("truncate day", ut_truncate(ts, UT_UNIT_DAY).nanos, 1734134400000000000LL);
+    ASSERT_EQ_INT("truncate nanosecond no-op", ut_truncate(ts, UT_UNIT_NANOSECOND).nanos, ts.nanos);
+
+    ut_timestamp_t before_epoch = ut_from_unix_nanos(-1);
+    ASSERT_EQ_INT("truncate pre-epoch floors", ut_truncate(before_epoch, UT_UNIT_SECOND).nanos, -1000000000LL);
+    ASSERT_EQ_INT("truncate pre-epoch day", ut_truncate(before_epoch, UT_UNIT_DAY).nanos, -86400000000000LL);
+    ASSERT_EQ_INT("truncate exact boundary", ut_truncate(ut_from_unix_nanos(-86400000000000LL), UT_UNIT_DAY).nanos,
+                  -86400000000000LL);
+    ASSERT_EQ_INT("truncate clamps at minimum", ut_truncate(ut_from_unix_nanos(INT64_MIN), UT_UNIT_DAY).nanos, INT64_MIN);
+}
+
+static void test_calendar_truncate(void) {
+    printf("\n--- test_calendar_truncate ---\n");
+
+    ut_timestamp_t ts;
+    ut_parse_strict("2024-12-14T03:13:21.5Z", &ts);
+
+    ut_timestamp_t expect;
+    ut_parse_strict("2024-12-09T00:00:00Z", &expect);
+    ASSERT_EQ_INT("truncate week to monday", ut_truncate(ts, UT_UNIT_WEEK).nanos, expect.nanos);
+    ut_parse_strict("2024-12-01T00:00:00Z", &expect);
+    ASSERT_EQ_INT("truncate month", ut_truncate(ts, UT_UNIT_MONTH).nanos, expect.nanos);
+    ut_parse_strict("2024-01-01T00:00:00Z", &expect);
+    ASSERT_EQ_INT("truncate year", ut_truncate(ts, UT_UNIT_YEAR).nanos, expect.nanos);
+
+    ut_parse_strict("1969-12-29T00:00:00Z", &expect);
+    ASSERT_EQ_INT("pre-epoch week", ut_truncate(ut_from_unix_nanos(-1), UT_UNIT_WEEK).nanos, expect.nanos);
+    ut_parse_strict("1969-12-01T00:00:00Z", &expect);
+    ASSERT_EQ_INT("pre-epoch month", ut_truncate(ut_from_unix_nanos(-1), UT_UNIT_MONTH).nanos, expect.nanos);
+    ASSERT_EQ_INT("year clamps at minimum", ut_truncate(ut_from_unix_nanos(INT64_MIN), UT_UNIT_YEAR).nanos, INT64_MIN);
+
+    ASSERT_EQ_INT("week duration", ut_duration_from(1, UT_UNIT_WEEK).nanos, 604800000000000LL);
+    ASSERT_EQ_INT("month has no duration", ut_duration_from(3, UT_UNIT_MONTH).nanos, 0);
+    ASSERT_EQ_INT("duration_to month is zero", ut_duration_to(ut_duration_from(90, UT_UNIT_DAY), UT_UNIT_MONTH), 0);
+
+    int y, w, d;
+    ut_to_iso_week(ut_from_unix_nanos(-43200000000000LL), &y, &w, &d);
+    ASSERT("1969-12-31T12:00 is 1970-W01-3", y == 1970 && w == 1 && d == 3);
+    ut_to_iso_week(ut_from_unix_nanos(-1), &y, &w, &d);
+    ASSERT_EQ_INT("last nanosecond of 1969 is wednesday", d, 3);
+}
+
+static void test_calendar_batch(void) {
+    printf("\n--- test_calendar_batch ---\n");
+
+    enum { N = 4096 };
+    static ut_timestamp_t in[N];
+    static ut_timestamp_t out[N];
+    static int years[N], weeks[N], days[N];
+
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < N; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        if (i < N / 2) {
+            in[i].nanos = (int64_t)state;
+        } else {
+            in[i].nanos = -4000000000000000000LL + (int64_t)(state % 8000000000000000000ULL);
+        }
+    }
+    in[0].nanos = INT64_MIN;
+    in[1].nanos = INT64_MAX;
+    in[2].nanos = -1;
+    in[3].nanos = 0;
+    for (int i = 4; i < 64; i++) {
+        in[i].nanos = 1734146001000000000LL + (int64_t)(i - 4) * 43200000000000LL;
+    }
+
+    const ut_unit_t units[] = {
+        UT_UNIT_NANOSECOND, UT_UNIT_MICROSECOND, UT_UNIT_MILLISECOND, UT_UNIT_SECOND,
+        UT_UNIT_MINUTE, UT_UNIT_HOUR, UT_UNIT_DAY, UT_UNIT_WEEK, UT_UNIT_MONTH, UT_UNIT_YEAR
+    };
+    bool truncate_matches = true;
+    for (size_t u = 0; u < sizeof(units) / sizeof(units[0]); u++) {
+        if (ut_truncate_batch(in, N, units[u], out) != UT_OK) {
+            truncate_matches = false;
+        }
+        for (int i = 0; i < N; i++) {
+            if (out[i].nanos != ut_truncate(in[i], units[u]).nanos) {
+                truncate_matches = false;
+            }
+        }
+    }
+    ASSERT("truncate_batch matches ut_truncate for every unit", truncate_matches);
+
+    ASSERT("iso_week_batch ok", ut_iso_week_batch(in, N, years, weeks, days) == UT_OK);
+    bool iso_matches = true;
+    for (int i = 0; i < N; i++) {
+        int y, w, d;
+        ut_to_iso_week(in[i], &y, &w, &d);
+        if (y != years[i] || w != weeks[i] || d != days[i]) {
+            iso_matches = false;
+        }
+    }
+    ASSERT("iso_week_batch matches ut_to_iso_week", iso_matches);
+
+    ut_timestamp_t inplace[2] = {{1734146001123456789LL}, {-1}};
+    ut_truncate_batch(inplace, 2, UT_UNIT_SECOND, inplace);
+    ASSERT("truncate_batch in place", inplace[0].nanos == 1734146001000000000LL && inplace[1].nanos == -1000000000LL);
+
+    ASSERT("truncate_batch empty", ut_truncate_batch(NULL, 0, UT_UNIT_DAY, NULL) == UT_OK);
+    ASSERT("truncate_batch null", ut_truncate_batch(in, 1, UT_UNIT_DAY, NULL) == UT_ERR_NULL_POINTER);
+    ASSERT("truncate_batch bad unit", ut_truncate_batch(in, 1, (ut_unit_t)99, out) == UT_ERR_OUT_OF_RANGE);
+    ASSERT("iso_week_batch null", ut_iso_week_batch(in, 1, years, NULL, days) == UT_ERR_NULL_POINTER);
+}
+
+static void test_japanese_era_batch(void) {
+    printf("\n--- test_japanese_era_batch ---\n");
+
+    static const char *const firsts[] = {
+        "2019-05-01T00:00:00Z", "1989-01-08T00:00:00Z", "1926-12-25T00:00:00Z",
+        "1912-07-30T00:00:00Z", "1868-01-25T00:00:00Z"
+    };
+    bool boundaries_ok = true;
+    for (int i = 0; i < 5; i++) {
+        ut_timestamp_t ts;
+        ut_japanese_era_t era;
+        int year;
+        ut_parse_strict(firsts[i], &ts);
+        if (ut_to_japanese_era(ts, &era, &year) != UT_OK || era != (ut_japanese_era_t)i || year != 1) {
+            boundaries_ok = false;
+        }
+        ts.nanos -= 1;
+        if (i < 4 && (ut_to_japanese_era(ts, &era, &year) != UT_OK || era != (ut_japanese_era_t)(i + 1))) {
+            boundaries_ok = false;
+        }
+    }
+    ASSERT("era boundaries match civil dates", boundaries_ok);
+
+    enum { N = 4096 };
+    static ut_timestamp_t in[N];
+    static ut_japanese_era_t eras[N];
+    static int years[N];
+    static ut_error_t errs[N];
+
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    for (int i = 0; i < N; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        in[i].nanos = (int64_t)state;
+    }
+    for (int i = 0; i < 256; i++) {
+        in[i].nanos = 1546300800000000000LL + (int64_t)i * 86400000000000LL;
+    }
+    in[256].nanos = INT64_MIN;
+    in[257].nanos = INT64_MAX;
+
+    ut_error_t first = ut_to_japanese_era_batch(in, N, eras, years, errs);
+    ASSERT("era batch reports pre-Meiji rows", first == UT_ERR_OUT_OF_RANGE);
+
+    bool matches = true;
+    for (int i = 0; i < N; i++) {
+        ut_japanese_era_t era;
+        int year;
+        ut_error_t err = ut_to_japanese_era(in[i], &era, &year);
+        if (err != errs[i] || (err == UT_OK && (era != eras[i] || year != years[i])) ||
+            (err != UT_OK && years[i] != 0)) {
+            matches = false;
+        }
+    }
+    ASSERT("era batch matches ut_to_japanese_era", matches);
+    ASSERT("era batch null", ut_to_japanese_era_batch(in, 1, NULL, years, NULL) == UT_ERR_NULL_POINTER);
+    ASSERT("era batch empty", ut_to_japanese_era_batch(NULL, 0, NULL, NULL, NULL) == UT_OK);
+}
+
+static void test_register_japanese_era(void) {
+    printf("\n--- test_register_japanese_era ---\n");
+
+    ut_japanese_era_t next;
+    ASSERT("register invalid date", ut_register_japanese_era(2200, 2, 30, "Test", &next) == UT_ERR_INVALID_DATE);
+    ASSERT("register before newest", ut_register_japanese_era(2019, 5, 1, "Test", &next) == UT_ERR_OUT_OF_RANGE);
+    ASSERT("register unrepresentable", ut_register_japanese_era(2300, 1, 1, "Test", &next) == UT_ERR_OUT_OF_RANGE);
+    ASSERT("register long name",
+           ut_register_japanese_era(2200, 1, 1, "AnEraNameThatIsFarTooLong", &next) == UT_ERR_BUFFER_TOO_SMALL);
+    ASSERT("register null", ut_register_japanese_era(2200, 1, 1, NULL, &next) == UT_ERR_NULL_POINTER);
+
+    ut_error_t err = ut_register_japanese_era(2200, 1, 1, "Testera", &next);
+    ASSERT("register new era", err == UT_OK && next == UT_ERA_MEIJI + 1);
+    ASSERT_EQ_STR("registered name", ut_japanese_era_name(next), "Testera");
+
+    ut_timestamp_t ts;
+    ut_japanese_era_t era;
+    int year;
+    ut_parse_strict("2201-06-01T00:00:00Z", &ts);
+    ASSERT("new era applies", ut_to_japanese_era(ts, &era, &year) == UT_OK && era == next && year == 2);
+    ut_parse_strict("2199-12-31T23:59:59Z", &ts);
+    ASSERT("reiwa ends before new era", ut_to_japanese_era(ts, &era, &year) == UT_OK &&
+           era == UT_ERA_REIWA && year == 181);
+
+    int added = 1;
+    while (ut_register_japanese_era(2200 + added, 1, 1, "Filler", &era) == UT_OK) {
+        added++;
+    }
+    ASSERT_EQ_INT("table holds capacity eras", added + 5, UT_JAPANESE_ERA_CAPACITY);
+    ASSERT("register when full", ut_register_japanese_era(2250, 1, 1, "Full", &era) == UT_ERR_OUT_OF_MEMORY);
+}
+
+static void test_column_codec(void) {
+    printf("\n--- test_column_codec ---\n");
+
+    enum { N = 1000 };
+    static ut_timestamp_t in[N];
+    static ut_timestamp_t out[N];
+    static uint8_t wire[UT_COLUMN_MAX_ENCODED_LEN(N)];
+    static uint8_t parts[UT_COLUMN_MAX_ENCODED_LEN(N)];
+
+    int64_t t = 1734177600000000000LL;
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < N; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        t += (int64_t)(state % 2000000) - 100000;
+        in[i].nanos = t;
+    }
+    in[10].nanos = INT64_MIN;
+    in[11].nanos = INT64_MAX;
+    in[12].nanos = 0;
+
+    size_t len = 0, n = 0;
+    ASSERT("encode succeeds", ut_encode_column(in, N, wire, sizeof(wire), &len) == UT_OK);
+    ASSERT("header written", wire[0] == 'U' && wire[1] == 'T' && wire[2] == UT_COLUMN_VERSION);
+    ASSERT("clustered data compresses", len < (size_t)N * 5);
+    ASSERT("count matches", ut_column_count(wire, len, &n) == UT_OK && n == N);
+    ASSERT("decode succeeds", ut_decode_column(wire, len, out, N, &n) == UT_OK && n == N);
+    ASSERT("round trip exact", memcmp(in, out, sizeof(in)) == 0);
+
+    ut_column_encoder_t enc;
+    ut_column_encoder_init(&enc);
+    size_t total = 0;
+    for (size_t i = 0; i < N; i += 7) {
+        size_t chunk = N - i < 7 ? N - i : 7;
+        size_t used = 0;
+        ut_column_encode_append(&enc, in + i, chunk, parts + total, sizeof(parts) - total, &used);
+        total += used;
+    }
+    ASSERT("incremental equals one-shot", total == len && memcmp(parts, wire, len) == 0);
+
+    size_t used = 99;
+    ut_column_encoder_init(&enc);
+    ASSERT("exact-size buffer accepted", ut_column_encode_append(&enc, in, N, parts, len, &used) == UT_OK &&
+           used == len);
+    ut_column_encoder_init(&enc);
+    ASSERT("short buffer rejected", ut_column_encode_append(&enc, in, N, parts, len - 1, &used) ==
+           UT_ERR_BUFFER_TOO_SMALL && used == 0 && !enc.started);
+
+    ASSERT("empty column is header only", ut_encode_column(NULL, 0, parts, sizeof(parts), &used) == UT_OK &&
+           used == UT_COLUMN_HEADER_LEN);
+    ASSERT("empty column decodes", ut_decode_column(parts, used, NULL, 0, &n) == UT_OK && n == 0);
+
+    ASSERT("capacity exceeded", ut_decode_column(wire, len, out, 5, &n) == UT_ERR_BUFFER_TOO_SMALL && n == 5 &&
+           out[4].nanos == in[4].nanos);
+    ASSERT("truncated varint", ut_decode_column(wire, len - 1, out, N, &n) == UT_ERR_INVALID_FORMAT);
+    ASSERT("truncated count", ut_column_count(wire, len - 1, &n) == UT_ERR_INVALID_FORMAT);
+
+    const uint8_t bad_version[] = {'U', 'T', 2, 0, 0};
+    const uint8_t bad_magic[] = {'U', 'X', 1, 0, 0};
+    const uint8_t too_long[] = {'U', 'T', 1, 0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01};
+    ASSERT("version checked", ut_decode_column(bad_version, sizeof(bad_version), out, N, &n) ==
+           UT_ERR_INVALID_FORMAT);
+    ASSERT("magic checked", ut_column_count(bad_magic, sizeof(bad_magic), &n) == UT_ERR_INVALID_FORMAT);
+    ASSERT("overlong varint rejected", ut_decode_column(too_long, sizeof(too_long), out, N, &n) ==
+           UT_ERR_INVALID_FORMAT);
+    ASSERT("null rejected", ut_decode_column(NULL, 4, out, N, &n) == UT_ERR_NULL_POINTER);
+}
+
+/* Returns the ut_error_t spelled by a conformance vector, or -1. */
+static int vector_error_code(const char *name) {
+    static const char *const names[] = {
+        "OK", "INVALID_FORMAT", "INVALID_DATE", "OUT_OF_RANGE",
+        "UNSUPPORTED_OFFSET", "FRACTION_TOO_LONG", "LEAP_SECOND"
+    };
+    for (int i = 0; i < (int)(sizeof(names) / sizeof(names[0])); i++) {
+        if (strcmp(name, names[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Parses a comma-separated nanosecond list ("-" for none) into out; returns the count. */
+static size_t vector_nanos(const char *list, ut_timestamp_t *out, size_t capacity) {
+    size_t n = 0;
+    if (strcmp(list, "-") == 0) {
+        return 0;
+    }
+    for (const char *p = list; n < capacity; p++) {
+        char *end;
+        out[n++].nanos = strtoll(p, &end, 10);
+        if (*end != ',') {
+            break;
+        }
+        p = end;
+    }
+    return n;
+}
+
+/* Decodes a hex string into out; returns the byte count. */
+static size_t vector_hex(const char *hex, uint8_t *out, size_t capacity) {
+    size_t n = 0;
+    for (; hex[0] != '\0' && hex[1] != '\0' && n < capacity; hex += 2) {
+        unsigned byte;
+        sscanf(hex, "%2x", &byte);
+        out[n++] = (uint8_t)byte;
+    }
+    return n;
+}
+
+/* Checks one "op<TAB>input<TAB>expected" line; returns true when the library agrees. */
+static bool check_vector(char *line) {
+    char *input = strchr(line, '\t');
+    char *expected = input != NULL ? strchr(input + 1, '\t') : NULL;
+    if (expected == NULL) {
+        return false;
+    }
+    *input++ = '\0';
+    *expected++ = '\0';
+
+    if (strcmp(line, "strict") == 0 || strcmp(line, "lenient") == 0) {
+        ut_timestamp_t ts = {0};
+        ut_error_t err = strcmp(line, "strict") == 0 ? ut_parse_strict(input, &ts)
+                                                     : ut_parse_lenient(input, &ts);
+        int code = vector_error_code(expected);
+        if (code >= 0) {
+            return (int)err == code;
+        }
+        return err == UT_OK && ts.nanos == strtoll(expected, NULL, 10);
+    }
+    if (strcmp(line, "format") == 0 || strcmp(line, "format_short") == 0) {
+        char buf[UT_MAX_STRING_LEN];
+        ut_format(ut_from_unix_nanos(strtoll(input, NULL, 10)), buf, sizeof(buf),
+                  strcmp(line, "format") == 0);
+        return strcmp(buf, expected) == 0;
+    }
+    if (strcmp(line, "column") == 0 || strcmp(line, "column_decode") == 0) {
+        ut_timestamp_t values[16], decoded[16];
+        uint8_t bytes[128];
+        bool encode = strcmp(line, "column") == 0;
+        size_t len = vector_hex(encode ? expected : input, bytes, sizeof(bytes));
+        size_t n = 0, count = 0;
+
+        if (encode) {
+            uint8_t wire[UT_COLUMN_MAX_ENCODED_LEN(16)];
+            size_t wire_len = 0;
+            n = vector_nanos(input, values, 16);
+            if (ut_encode_column(values, n, wire, sizeof(wire), &wire_len) != UT_OK ||
+                wire_len != len || memcmp(wire, bytes, len) != 0) {
+                return false;
+            }
+        } else {
+            int code = vector_error_code(expected);
+            if (code >= 0) {
+                return (int)ut_decode_column(bytes, len, decoded, 16, &count) == code;
+            }
+            n = vector_nanos(expected, values, 16);
+        }
+        return ut_decode_column(bytes, len, decoded, 16, &count) == UT_OK && count == n &&
+               memcmp(decoded, values, n * sizeof(values[0])) == 0;
+    }
+    return false;
+}
+
+#if defined(UT_ENABLE_STATS) && defined(UT_TEST_FORK)
+
+/* Thread body for test_stats(): 1000 monotonic reservations. */
+static void *stats_worker(void *arg) {
+    (void)arg;
+    for (int i = 0; i < 1000; i++) {
+        ut_now_monotonic();
+    }
+    return NULL;
+}
+
+#endif
+
+static void test_stats(void) {
+    printf("\n--- test_stats ---\n");
+
+    ut_stats_t stats;
+    ut_timestamp_t ts;
+    ASSERT("stats null", ut_get_stats(NULL) == UT_ERR_NULL_POINTER);
+
+    ut_reset_stats();
+    for (int i = 0; i < 10; i++) {
+        ut_now_monotonic();
+    }
+    ut_parse_strict("2024-12-14T12:00:00Z", &ts);
+    ut_parse_lenient("2024-12-14T12:00:00.5Z", &ts);
+    ut_parse_strict_n("2024-12-14T12:00:00Z", 20, &ts);
+    ut_parse_strict("bogus", &ts);
+    ut_parse_strict("2024-02-30T00:00:00Z", &ts);
+    ut_parse_strict(NULL, &ts);
+
+#if defined(UT_ENABLE_STATS)
+    ASSERT("stats available", ut_get_stats(&stats) == UT_OK);
+    ASSERT("monotonic calls counted", stats.monotonic_calls == 10);
+    ASSERT("bumps within calls", stats.monotonic_bumps <= stats.monotonic_calls);
+    ASSERT("parse ok counted", stats.parse_results[UT_OK] == 3);
+    ASSERT("parse errors by code", stats.parse_results[UT_ERR_INVALID_FORMAT] == 1 &&
+           stats.parse_results[UT_ERR_INVALID_DATE] == 1 &&
+           stats.parse_results[UT_ERR_NULL_POINTER] == 0);
+
+    ut_reset_stats();
+    ut_get_stats(&stats);
+    ASSERT("reset clears counters", stats.monotonic_calls == 0 && stats.parse_results[UT_OK] == 0);
+
+#if defined(UT_TEST_FORK)
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        pthread_create(&threads[i], NULL, stats_worker, NULL);
+    }
+    for (int i = 0; i < 4; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    ut_get_stats(&stats);
+    ASSERT("exited threads aggregated", stats.monotonic_calls == 4000);
+#endif
+#else
+    ASSERT("stats compiled out", ut_get_stats(&stats) == UT_ERR_UNAVAILABLE);
+    ASSERT("compiled-out counters zero", stats.monotonic_calls == 0 && stats.parse_results[UT_OK] == 0);
+#endif
+    ASSERT("stats clock source", stats.clock_source == ut_get_clock_source() &&
+           stats.clock_cost_ns > 0.0);
+
+    char text[2048];
+    int n = ut_format_stats(&stats, text, sizeof(text));
+    ASSERT("prometheus text", n > 0 && (size_t)n == strlen(text) &&
+           strstr(text, "# TYPE ut_monotonic_calls_total counter\n") != NULL &&
+           strstr(text, "ut_parse_total{result=\"invalid_date\"} ") != NULL &&
+           strstr(text, "ut_clock_cost_ns{source=\"precise\",effective=\"precise\"} ") != NULL);
+
+    memset(&stats, 0xFF, sizeof(stats));
+    stats.clock_source = UT_CLOCK_SHARED;
+    stats.clock_effective = UT_CLOCK_PRECISE;
+    stats.clock_cost_ns = 1e12;
+    n = ut_format_stats(&stats, text, sizeof(text));
+    ASSERT("largest dump fits 2048", n > 0 && n < (int)sizeof(text) &&
+           strstr(text, "ut_monotonic_bumps_total 18446744073709551615\n") != NULL);
+    ASSERT("dump buffer too small", ut_format_stats(&stats, text, 64) == -1 && text[0] == '\0');
+    ASSERT("dump null", ut_format_stats(NULL, text, sizeof(text)) == -1);
+}
+
+static void test_conformance_vectors(void) {
+    printf("\n--- test_conformance_vectors ---\n");
+
+    const char *path = getenv("UT_CONFORMANCE_VECTORS");
+    FILE *f = fopen(path != NULL ? path : "test/conformance_vectors.txt", "r");
+    ASSERT("open conformance vectors", f != NULL);
+    if (f == NULL) {
+        return;
+    }
+
+    char line[256];
+    int cases = 0;
+    int mismatches = 0;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0' || line[0] == '#') {
+            continue;
+        }
+        char copy[256];
+        memcpy(copy, line, sizeof(copy));
+        cases++;
+        if (!check_vector(line)) {
+            mismatches++;
+            printf("  mismatch: %s\n", copy);
+        }
+    }
+    fclose(f);
+
+    ASSERT("conformance vectors present", cases > 0);
+    ASSERT_EQ_INT("conformance vectors match", mismatches, 0);
+}
+
 int main(void) {
     printf("Running universal_timestamp tests...\n");
     printf("=====================================\n");
@@ -338,6 +1887,30 @@ int main(void) {
     test_japanese_era_boundaries();
     test_iso_week_boundaries();
     test_error_conditions();
+    test_civil_engine_equivalence();
+    test_format_matches_snprintf();
+    test_clock_sources();
+    test_clock_probe();
+    test_tsc_clock();
+    test_monotonic_batch();
+    test_regression_queue();
+    test_monotonic_gen();
+    test_shared_clock();
+    test_format_cached();
+    test_format_batch();
+    test_parse_strict_simd_matches_scalar();
+    test_parse_batch();
+    test_parse_length_delimited();
+    test_parse_flexible();
+    test_duration_arithmetic();
+    test_truncate();
+    test_calendar_truncate();
+    test_calendar_batch();
+    test_japanese_era_batch();
+    test_register_japanese_era();
+    test_column_codec();
+    test_stats();
+    test_conformance_vectors();
 
     printf("\n=====================================\n");
     printf("Tests run: %d\n", tests_run);
@@ -0,0 +1,43 @@
+/**
+ * @file test_inline.c
+ * @brief Checks the UT_INLINE_ACCESSORS header variants against the shared library.
+ */
+
+#define UT_INLINE_ACCESSORS
+#include "universal_timestamp.h"
+#include <stdio.h>
+#include <string.h>
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#define ASSERT(msg, expr) do { \
+    tests_run++; \
+    if (!(expr)) { \
+        tests_failed++; \
+        printf("[FAIL] %s (line %d)\n", msg, __LINE__); \
+    } else { \
+        printf("[PASS] %s\n", msg); \
+    } \
+} while (0)
+
+int main(void) {
+    printf("\n--- test_inline_accessors ---\n");
+
+    ut_timestamp_t ts = ut_from_unix_nanos(1734177600123456789LL);
+    ASSERT("inline from/to round trip", ut_to_unix_nanos(ts) == 1734177600123456789LL);
+    ASSERT("inline calendar", ut_get_calendar() == UT_CALENDAR_GREGORIAN);
+
+    char buf[UT_MAX_STRING_LEN];
+    ASSERT("library formats inline-built timestamp",
+           ut_format(ts, buf, sizeof(buf), true) > 0 &&
+           strcmp(buf, "2024-12-14T12:00:00.123456789Z") == 0);
+
+    ut_timestamp_t parsed;
+    ASSERT("library parse agrees with inline accessor",
+           ut_parse_strict(buf, &parsed) == UT_OK && ut_to_unix_nanos(parsed) == ut_to_unix_nanos(ts));
+
+    printf("\nTests run: %d\n", tests_run);
+    printf("Failures : %d\n", tests_failed);
+    return tests_failed == 0 ? 0 : 1;
+}
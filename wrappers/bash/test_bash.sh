@@ -40,4 +40,74 @@ else
     exit 1
 fi
 
+# Test 4: Streaming parse/format
+echo "Testing streaming parse and format..."
+stream_out=$(printf '2024-12-14T12:00:00Z\nbogus\n2024-12-14T12:00:00.5Z\n' | ut_parse_stream 2>/dev/null) || true
+expected=$'1734177600000000000\n\n1734177600500000000'
+if [[ "$stream_out" != "$expected" ]]; then
+    echo "FAIL: ut_parse_stream produced '$stream_out'"
+    exit 1
+fi
+round=$(printf '%s\n' 1734177600000000000 -1 | ut_format_stream)
+if [[ "$round" != $'2024-12-14T12:00:00Z\n1969-12-31T23:59:59.999999999Z' ]]; then
+    echo "FAIL: ut_format_stream produced '$round'"
+    exit 1
+fi
+flex=$(printf '%s\n' '2024-12-14 13:00:00+01:00' 20241214T120000Z 1734177600 1734177600500 | ut_parse_stream)
+if [[ "$flex" != $'1734177600000000000\n1734177600000000000\n1734177600000000000\n1734177600500000000' ]]; then
+    echo "FAIL: flexible stream parse produced '$flex'"
+    exit 1
+fi
+echo "PASS: streaming parse/format"
+
+# Test 5: Field rewrite
+echo "Testing field rewrite..."
+rewritten=$(printf 'id,ts\n7,2024-12-14T12:00:00Z\n' | ut_rewrite_field 2 , nanos 2>/dev/null)
+if [[ "$rewritten" != $'id,ts\n7,1734177600000000000' ]]; then
+    echo "FAIL: ut_rewrite_field produced '$rewritten'"
+    exit 1
+fi
+tsv=$(printf 'a\t1734177600000000000\tz\n' | ut_rewrite_field 2 '\t' iso)
+if [[ "$tsv" != $'a\t2024-12-14T12:00:00Z\tz' ]]; then
+    echo "FAIL: TSV rewrite produced '$tsv'"
+    exit 1
+fi
+echo "PASS: field rewrite"
+
+# Test 6: Threaded file conversion
+echo "Testing file conversion..."
+tmpdir=$(mktemp -d)
+trap 'rm -rf "$tmpdir"' EXIT
+for i in $(seq 1 2000); do echo "$((1734177600000000000 + i * 1000000007))"; done > "$tmpdir/nanos.txt"
+ut_convert_file "$tmpdir/nanos.txt" "$tmpdir/iso.txt" iso 3 2>/dev/null
+ut_convert_file "$tmpdir/iso.txt" "$tmpdir/back.txt" nanos 2 2>/dev/null
+if ! cmp -s "$tmpdir/nanos.txt" "$tmpdir/back.txt"; then
+    echo "FAIL: convert round trip differs"
+    exit 1
+fi
+if [[ "$(head -1 "$tmpdir/iso.txt")" != "2024-12-14T12:00:01.000000007Z" ]]; then
+    echo "FAIL: convert produced '$(head -1 "$tmpdir/iso.txt")'"
+    exit 1
+fi
+summary=$(ut_convert_file "$tmpdir/nanos.txt" "$tmpdir/iso.txt" iso 8 2>&1)
+if [[ "$summary" != *"1 threads)"* ]]; then
+    echo "FAIL: convert summary '$summary' does not report the workers used"
+    exit 1
+fi
+echo "PASS: file conversion"
+
+# Test 7: Statistics dump
+echo "Testing stats..."
+dump=$(ut_stats 2>/dev/null) || true
+if [[ "$dump" != *"# TYPE ut_parse_total counter"* || "$dump" != *"ut_clock_cost_ns{source=\"precise\""* ]]; then
+    echo "FAIL: ut_stats produced '$dump'"
+    exit 1
+fi
+wrapped=$("$UTS_CLI_PATH" stats parse 2024-12-14T12:00:00Z 2>"$tmpdir/stats.txt")
+if [[ "$wrapped" != "1734177600000000000" ]] || ! grep -q '^ut_parse_total{result="ok"} ' "$tmpdir/stats.txt"; then
+    echo "FAIL: stats parse produced '$wrapped'"
+    exit 1
+fi
+echo "PASS: stats"
+
 echo "All Bash tests passed!"
@@ -29,7 +29,7 @@ ut_now_nanos() {
     "$UTS_CLI_PATH" now-nanos
 }
 
-# Parse ISO-8601 string to nanoseconds
+# Parse a timestamp (ISO-8601/RFC 3339 with any offset, basic format or epoch) to nanoseconds
 # Usage: nanos=$(ut_parse "2024-01-01T12:00:00Z")
 ut_parse() {
     "$UTS_CLI_PATH" parse "$1"
@@ -40,3 +40,36 @@ ut_parse() {
 ut_format() {
     "$UTS_CLI_PATH" format "$1"
 }
+
+# Parse one timestamp per stdin line to nanoseconds (one process for the whole stream)
+# Usage: ut_parse_stream < timestamps.txt > nanos.txt
+ut_parse_stream() {
+    "$UTS_CLI_PATH" parse -
+}
+
+# Format one nanosecond value per stdin line to ISO-8601
+# Usage: ut_format_stream < nanos.txt > timestamps.txt
+ut_format_stream() {
+    "$UTS_CLI_PATH" format -
+}
+
+# Convert one field of a delimited stdin stream, copying everything else
+# Usage: ut_rewrite_field 2 , nanos < access.csv > access_nanos.csv
+#        ut_rewrite_field 3 '\t' iso < events.tsv
+ut_rewrite_field() {
+    "$UTS_CLI_PATH" rewrite --field "$1" --delim "${2:-,}" --to "${3:-nanos}"
+}
+
+# Convert a whole file on worker threads (one per CPU unless a count is given)
+# Usage: ut_convert_file timestamps.txt nanos.txt nanos [threads]
+ut_convert_file() {
+    "$UTS_CLI_PATH" convert --input "$1" --output "$2" --to "${3:-nanos}" ${4:+--threads "$4"}
+}
+
+# Print library statistics in Prometheus text format; with a command, run it
+# first and write the statistics to stderr (counters need a STATS=1 build)
+# Usage: ut_stats
+#        ut_stats convert --input in.txt --output out.txt 2> stats.prom
+ut_stats() {
+    "$UTS_CLI_PATH" stats "$@"
+}
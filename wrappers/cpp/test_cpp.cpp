@@ -6,6 +6,10 @@
 #include "universal_timestamp.hpp"
 #include <iostream>
 #include <cassert>
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include <vector>
 
 int main() {
     std::cout << "C++ wrapper tests...\n";
@@ -27,6 +31,146 @@ int main() {
     assert(parsed.nanos() == 1734146001123456789LL);
     std::cout << "[PASS] parse() works correctly\n";
 
+    /* Test clock source selection */
+    uts::Timestamp coarse = uts::Timestamp::now(UT_CLOCK_COARSE);
+    assert(coarse.nanos() > 1700000000000000000LL);
+    std::cout << "[PASS] now(UT_CLOCK_COARSE) works\n";
+
+    /* Test batched monotonic reservation */
+    std::vector<uts::Timestamp> ids = uts::Timestamp::now_monotonic_batch(1000);
+    assert(ids.size() == 1000);
+    for (size_t i = 1; i < ids.size(); ++i) {
+        assert(ids[i].nanos() == ids[i - 1].nanos() + 1);
+    }
+    assert(uts::Timestamp::now_monotonic() > ids.back());
+    std::cout << "[PASS] now_monotonic_batch() works\n";
+
+    /* Test header-only strict parser against the C library */
+    const char* vectors[] = {
+        "2024-12-14T03:13:21Z", "2024-12-14T03:13:21.123456789Z", "2024-02-29T00:00:00.5Z",
+        "2023-02-29T00:00:00Z", "2024-12-14T24:00:00Z", "2024-12-14T03:13:60Z",
+        "2024-12-14T03:13:21.1234567890Z", "2024-12-14T03:13:21+00:00", "2024-12-14T03:13:21",
+        "2024-12-14t03:13:21Z", "2024-12-14T03:13:21.Z", "0000-01-01T00:00:00Z",
+        "9999-12-31T23:59:59.999999999Z", "1969-12-31T23:59:59.9Z", "2024-13-01T00:00:00Z",
+        "x024-12-14T03:13:21Z", "2024-12-14T03:13:21Zx", "2024-12-14T03:13:21+0a:00"
+    };
+    for (const char* v : vectors) {
+        ut_timestamp_t c_ts = {0};
+        ut_error_t c_err = ut_parse_strict(v, &c_ts);
+        uts::detail::Parsed r = uts::detail::parse_strict(v, std::strlen(v));
+        assert(r.error == c_err);
+        assert(c_err != UT_OK || r.nanos == c_ts.nanos);
+    }
+    assert(uts::Timestamp::from_civil(2024, 12, 14, 3, 13, 21, 500000000) ==
+           uts::Timestamp::parse("2024-12-14T03:13:21.5Z"));
+    bool civil_threw = false;
+    try {
+        uts::Timestamp::from_civil(2023, 2, 29);
+    } catch (const uts::Error& e) {
+        civil_threw = e.code() == UT_ERR_INVALID_DATE;
+    }
+    assert(civil_threw);
+    {
+        using namespace uts::literals;
+        assert("2024-12-14T03:13:21.5Z"_uts == uts::Timestamp::from_civil(2024, 12, 14, 3, 13, 21, 500000000));
+#if !UTS_HAS_CONSTEVAL
+        bool literal_threw = false;
+        try {
+            (void)"2024-12-14 03:13:21"_uts;
+        } catch (const uts::Error& e) {
+            literal_threw = e.code() == UT_ERR_INVALID_FORMAT;
+        }
+        assert(literal_threw);
+#endif
+#if UTS_HAS_CONSTEXPR14
+        constexpr uts::Timestamp cutoff = "2024-12-14T03:13:21.5Z"_uts;
+        static_assert(cutoff.nanos() == 1734146001500000000LL, "literal folds at compile time");
+        static_assert(uts::Timestamp::from_civil(1970, 1, 1).nanos() == 0, "epoch");
+        static_assert(uts::Timestamp::from_civil(1969, 12, 31, 23, 59, 59).nanos() == -1000000000LL,
+                      "pre-epoch");
+        static_assert("2000-02-29T12:00:00Z"_uts < cutoff, "constexpr comparison");
+#endif
+    }
+    std::cout << "[PASS] constexpr parser, from_civil() and _uts literal work\n";
+
+    /* Test allocation-free formatting */
+    {
+        uts::Timestamp fixed = uts::Timestamp::parse("2024-12-14T03:13:21.1234Z");
+        char buf[UT_MAX_STRING_LEN];
+        char* end = fixed.format_to(buf);
+        assert(std::string(buf, end) == "2024-12-14T03:13:21.1234Z" && *end == '\0');
+        assert(std::string(buf, fixed.format_to(buf, uts::Precision::seconds)) == "2024-12-14T03:13:21Z");
+        assert(std::string(buf, fixed.format_to(buf, uts::Precision::milliseconds)) == "2024-12-14T03:13:21.123Z");
+        assert(std::string(buf, fixed.format_to(buf, uts::Precision::microseconds)) == "2024-12-14T03:13:21.123400Z");
+        assert(std::string(buf, fixed.format_to(buf, uts::Precision::nanoseconds)) == "2024-12-14T03:13:21.123400000Z");
+
+        uts::Timestamp before_epoch(-1);
+        assert(std::string(buf, before_epoch.format_to(buf, uts::Precision::milliseconds)) == "1969-12-31T23:59:59.999Z");
+
+        std::string sink;
+        fixed.format_to(std::back_inserter(sink), uts::Precision::microseconds);
+        assert(sink == "2024-12-14T03:13:21.123400Z");
+    }
+#if UTS_HAS_STD_FORMAT
+    assert(std::format("{:ms}", uts::Timestamp(1500000000LL)) == "1970-01-01T00:00:01.500Z");
+    assert(std::format("{}", uts::Timestamp(1500000000LL)) == "1970-01-01T00:00:01.5Z");
+#endif
+#if UTS_HAS_FMT
+    assert(fmt::format("{:ms}", uts::Timestamp(1500000000LL)) == "1970-01-01T00:00:01.500Z");
+    assert(fmt::format("{:ns}", uts::Timestamp(1500000000LL)) == "1970-01-01T00:00:01.500000000Z");
+    assert(fmt::format("{}", uts::Timestamp(1500000000LL)) == "1970-01-01T00:00:01.5Z");
+    assert(fmt::format("{:s}", uts::Timestamp(1500000000LL)) == "1970-01-01T00:00:01Z");
+    std::cout << "[PASS] fmt::formatter works\n";
+#endif
+    std::cout << "[PASS] format_to() works\n";
+
+    /* Test non-throwing parse */
+    {
+        uts::ParseResult good = uts::Timestamp::try_parse("2024-12-14T03:13:21.5Z");
+        assert(good.ok() && good && good.value.nanos() == 1734146001500000000LL);
+        uts::ParseResult bad = uts::Timestamp::try_parse(std::string("2024-12-14 03:13:21Z"));
+        assert(!bad && bad.error == UT_ERR_INVALID_FORMAT && bad.value.nanos() == 0);
+        assert(uts::Timestamp::try_parse("2024-12-14T03:13:21Zjunk", 20).ok());
+        assert(uts::Timestamp::try_parse(nullptr).error == UT_ERR_NULL_POINTER);
+        assert(uts::Timestamp::try_parse_lenient("2024-12-14T03:13:21").ok());
+        assert(!uts::Timestamp::try_parse("2024-12-14T03:13:21").ok());
+        static_assert(noexcept(uts::Timestamp::try_parse("")), "try_parse must be noexcept");
+#if UTS_HAS_STRING_VIEW
+        assert(uts::Timestamp::try_parse(std::string_view("2024-12-14T03:13:21Z")).ok());
+#endif
+    }
+    std::cout << "[PASS] try_parse() works\n";
+
+    /* Test per-thread monotonic clock */
+    uts::MonotonicClock clock;
+    uts::Timestamp first = clock.next();
+    assert(clock.next() > first);
+    uts::MonotonicClock shard(5, 3);
+    assert((shard.next().nanos() & 7) == 5);
+    uts::MonotonicClock moved(std::move(shard));
+    assert((moved.next().nanos() & 7) == 5);
+    bool threw = false;
+    try {
+        uts::MonotonicClock bad(8, 3);
+    } catch (const uts::Error& e) {
+        threw = e.code() == UT_ERR_OUT_OF_RANGE;
+    }
+    assert(threw);
+    std::cout << "[PASS] MonotonicClock works\n";
+
+    /* Test length-delimited and prefix parsing */
+    const char record[] = "2024-12-14T03:13:21.123456789Z,GET,/";
+    assert(uts::Timestamp::parse(record, 30).nanos() == 1734146001123456789LL);
+    assert(uts::Timestamp::parse_lenient(record, 19).nanos() == 1734146001000000000LL);
+    size_t used = 0;
+    assert(uts::Timestamp::parse_prefix(record, sizeof(record) - 1, used) == parsed);
+    assert(used == 30);
+    assert(uts::Timestamp::parse(std::string(record, 30)) == parsed);
+#if UTS_HAS_STRING_VIEW
+    assert(uts::Timestamp::parse(std::string_view(record, 30)) == parsed);
+#endif
+    std::cout << "[PASS] length-delimited parse() and parse_prefix() work\n";
+
     /* Test round-trip */
     uts::Timestamp rt = uts::Timestamp::parse(now.format());
     std::cout << "[PASS] round-trip parse succeeds\n";
@@ -39,6 +183,87 @@ int main() {
     assert(t1 != t2);
     std::cout << "[PASS] comparison operators work\n";
 
+    /* Test Duration arithmetic and chrono interop */
+    {
+        uts::Duration minute = uts::Duration::from(1, UT_UNIT_MINUTE);
+        assert(minute == std::chrono::minutes(1));
+        assert((parsed + minute) - parsed == minute);
+        assert(parsed - minute < parsed && minute + parsed > parsed);
+        assert(parsed + std::chrono::milliseconds(877) ==
+               uts::Timestamp::parse("2024-12-14T03:13:22.000456789Z"));
+        assert(uts::Duration(std::chrono::seconds(90)).count(UT_UNIT_MINUTE) == 1);
+        assert((-uts::Duration(INT64_MIN)).nanos() == INT64_MAX);
+
+        uts::Timestamp max(INT64_MAX);
+        uts::Timestamp min(INT64_MIN);
+        assert(max + minute == max && min - minute == min);
+        assert((max - min).nanos() == INT64_MAX);
+        assert((min - max).nanos() == INT64_MIN);
+        uts::Timestamp out = parsed;
+        assert(!max.checked_add(minute, out) && out == parsed);
+        assert(!min.checked_sub(minute, out) && out == parsed);
+        assert(parsed.checked_add(minute, out) && out == parsed + minute);
+
+        uts::Timestamp walked = parsed;
+        walked += std::chrono::hours(1);
+        walked -= minute;
+        assert(walked - parsed == std::chrono::minutes(59));
+
+        assert(parsed.truncate(UT_UNIT_SECOND) == uts::Timestamp::parse("2024-12-14T03:13:21Z"));
+        assert(parsed.truncate(UT_UNIT_DAY) == uts::Timestamp::parse("2024-12-14T00:00:00Z"));
+        assert(uts::Timestamp(-1).truncate(UT_UNIT_SECOND).nanos() == -1000000000LL);
+        assert(uts::Timestamp(-1).truncate(UT_UNIT_DAY).nanos() ==
+               ut_truncate(ut_from_unix_nanos(-1), UT_UNIT_DAY).nanos);
+
+        assert(parsed.truncate(UT_UNIT_WEEK) == uts::Timestamp::parse("2024-12-09T00:00:00Z"));
+        assert(parsed.truncate(UT_UNIT_MONTH) == uts::Timestamp::parse("2024-12-01T00:00:00Z"));
+        assert(uts::Duration::from(1, UT_UNIT_WEEK) == std::chrono::hours(168));
+        assert(uts::Duration::from(1, UT_UNIT_YEAR).nanos() == 0);
+        std::vector<uts::Timestamp> rollup;
+        for (int i = 0; i < 50; ++i) {
+            rollup.push_back(parsed + std::chrono::minutes(37 * i));
+        }
+        uts::truncate_batch(rollup.data(), rollup.size(), UT_UNIT_HOUR, rollup.data());
+        for (int i = 0; i < 50; ++i) {
+            assert(rollup[i] == (parsed + std::chrono::minutes(37 * i)).truncate(UT_UNIT_HOUR));
+        }
+
+        auto sys = parsed.to_sys_time();
+        assert(sys.time_since_epoch().count() == parsed.nanos());
+        assert(uts::Timestamp::from_sys_time(sys) == parsed);
+        assert(uts::Timestamp::from_sys_time(std::chrono::time_point_cast<std::chrono::seconds>(sys)) ==
+               parsed.truncate(UT_UNIT_SECOND));
+        assert(minute.to_chrono() == std::chrono::seconds(60));
+
+        static_assert((uts::Timestamp(100) + uts::Duration(23)).nanos() == 123, "constexpr add");
+        static_assert((uts::Timestamp(INT64_MAX) + uts::Duration(1)).nanos() == INT64_MAX, "constexpr saturation");
+        static_assert((uts::Timestamp(5) - uts::Timestamp(8)).nanos() == -3, "constexpr difference");
+        static_assert(uts::Timestamp(-1).truncate(UT_UNIT_MILLISECOND).nanos() == -1000000, "constexpr truncate");
+        static_assert(noexcept(parsed + minute), "arithmetic must be noexcept");
+#if UTS_HAS_CONSTEXPR14
+        using namespace uts::literals;
+        constexpr uts::Timestamp window_end = "2024-12-14T03:13:21Z"_uts + std::chrono::seconds(5);
+        static_assert(window_end.nanos() == 1734146006000000000LL, "literal plus chrono folds");
+#endif
+    }
+    std::cout << "[PASS] Duration arithmetic, truncate() and chrono interop work\n";
+
+    /* Test format_batch() */
+    std::vector<uts::Timestamp> column;
+    for (int i = 0; i < 600; i++) {
+        column.push_back(uts::Timestamp(1734146001123456789LL + i * 977000000123LL));
+    }
+    std::vector<std::string> formatted;
+    uts::format_batch(column.begin(), column.end(), std::back_inserter(formatted));
+    assert(formatted.size() == column.size());
+    for (size_t i = 0; i < column.size(); i++) {
+        assert(formatted[i] == column[i].format());
+    }
+    std::vector<char> slots(column.size() * UT_MAX_STRING_LEN);
+    uts::format_batch(column.data(), column.size(), slots.data(), UT_MAX_STRING_LEN, false);
+    assert(std::strcmp(slots.data() + 5 * UT_MAX_STRING_LEN, column[5].format(false).c_str()) == 0);
+    std::cout << "[PASS] format_batch() matches format()\n";
+
     /* Test calendar conversions */
     assert(uts::calendar::gregorian_to_thai(2024) == 2567);
     assert(uts::calendar::thai_to_gregorian(2567) == 2024);
@@ -52,6 +277,16 @@ int main() {
     assert(era.era == UT_ERA_REIWA);
     assert(era.year == 6);
     assert(era.name() == "Reiwa");
+    {
+        uts::Timestamp rows[3] = {ts_2024, uts::Timestamp::parse("1989-01-07T12:00:00Z"),
+                                  uts::Timestamp::parse("1989-01-08T00:00:00Z")};
+        ut_japanese_era_t eras[3];
+        int years[3];
+        uts::calendar::to_japanese_era_batch(rows, 3, eras, years);
+        assert(eras[0] == UT_ERA_REIWA && years[0] == 6);
+        assert(eras[1] == UT_ERA_SHOWA && years[1] == 64);
+        assert(eras[2] == UT_ERA_HEISEI && years[2] == 1);
+    }
     std::cout << "[PASS] Japanese era conversion works\n";
 
     /* Test ISO week */
@@ -9,9 +9,62 @@
 #ifndef UNIVERSAL_TIMESTAMP_HPP
 #define UNIVERSAL_TIMESTAMP_HPP
 
+#include <chrono>
 #include <string>
 #include <stdexcept>
 #include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_MSVC_LANG)
+    #define UTS_CPLUSPLUS _MSVC_LANG
+#else
+    #define UTS_CPLUSPLUS __cplusplus
+#endif
+
+#if UTS_CPLUSPLUS >= 201703L
+    #include <string_view>
+    #define UTS_HAS_STRING_VIEW 1
+#else
+    #define UTS_HAS_STRING_VIEW 0
+#endif
+
+#if UTS_CPLUSPLUS >= 201402L
+    #define UTS_HAS_CONSTEXPR14 1
+    #define UTS_CONSTEXPR14 constexpr
+#else
+    #define UTS_HAS_CONSTEXPR14 0
+    #define UTS_CONSTEXPR14 inline
+#endif
+
+#if defined(__cpp_consteval) && __cpp_consteval >= 201811L
+    #define UTS_HAS_CONSTEVAL 1
+    #define UTS_CONSTEVAL consteval
+#else
+    #define UTS_HAS_CONSTEVAL 0
+    #define UTS_CONSTEVAL UTS_CONSTEXPR14
+#endif
+
+#if UTS_CPLUSPLUS >= 202002L && defined(__has_include)
+    #if __has_include(<format>)
+        #include <format>
+    #endif
+#endif
+
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+    #define UTS_HAS_STD_FORMAT 1
+#else
+    #define UTS_HAS_STD_FORMAT 0
+#endif
+
+#if defined(UTS_USE_FMT) || defined(FMT_VERSION)
+    #include <fmt/format.h>
+    #define UTS_HAS_FMT 1
+#else
+    #define UTS_HAS_FMT 0
+#endif
 
 extern "C" {
 #include "universal_timestamp.h"
@@ -34,6 +87,348 @@ private:
     ut_error_t code_;
 };
 
+/**
+ * @brief Fractional-second precision for format_to() and the formatters.
+ */
+
+enum class Precision {
+    automatic,      /**< Like format(): up to 9 digits, trailing zeros removed */
+    seconds,        /**< No fractional part */
+    milliseconds,   /**< Exactly 3 fractional digits */
+    microseconds,   /**< Exactly 6 fractional digits */
+    nanoseconds     /**< Exactly 9 fractional digits */
+};
+
+/**
+ * @brief Header-only civil-date math and strict parser.
+ *
+ * Mirrors the C library's rules so results are identical, but every
+ * function is constexpr from C++14 on and can be evaluated at compile time.
+ */
+
+namespace detail {
+
+struct Parsed {
+    ut_error_t error;
+    int64_t nanos;
+};
+
+UTS_CONSTEXPR14 bool is_leap_year(int year) {
+
+    return (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
+}
+
+UTS_CONSTEXPR14 int days_in_month(int year, int month) {
+
+    return month == 2 ? (is_leap_year(year) ? 29 : 28)
+         : (month == 4 || month == 6 || month == 9 || month == 11) ? 30
+         : 31;
+}
+
+UTS_CONSTEXPR14 bool valid_date(int year, int month, int day) {
+
+    return year >= 0 && year <= 9999 && month >= 1 && month <= 12 &&
+           day >= 1 && day <= days_in_month(year, month);
+}
+
+UTS_CONSTEXPR14 int64_t days_from_civil(int year, int month, int day) {
+
+    int64_t y = static_cast<int64_t>(year) - (month <= 2);
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    int64_t yoe = y - era * 400;
+    int64_t mp = (month + 9) % 12;
+    int64_t doy = (153 * mp + 2) / 5 + day - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+UTS_CONSTEXPR14 int64_t to_nanos(int year, int month, int day, int hour, int minute,
+                                  int second, int64_t frac_nanos) {
+
+    return ((days_from_civil(year, month, day) * 86400 + hour * 3600LL + minute * 60LL + second)
+            * 1000000000LL) + frac_nanos;
+}
+
+UTS_CONSTEXPR14 int parse_digits(const char* str, int n) {
+
+    int value = 0;
+    for (int i = 0; i < n; ++i) {
+        if (str[i] < '0' || str[i] > '9') {
+            return -1;
+        }
+        value = value * 10 + (str[i] - '0');
+    }
+    return value;
+}
+
+UTS_CONSTEXPR14 Parsed parse_strict(const char* str, size_t len) {
+
+    if (str == nullptr) {
+        return Parsed{UT_ERR_NULL_POINTER, 0};
+    }
+    if (len < 19) {
+        return Parsed{UT_ERR_INVALID_FORMAT, 0};
+    }
+    if (str[4] != '-' || str[7] != '-' || str[10] != 'T' || str[13] != ':' || str[16] != ':') {
+        return Parsed{UT_ERR_INVALID_FORMAT, 0};
+    }
+
+    int year = parse_digits(str, 4);
+    int month = parse_digits(str + 5, 2);
+    int day = parse_digits(str + 8, 2);
+    int hour = parse_digits(str + 11, 2);
+    int minute = parse_digits(str + 14, 2);
+    int second = parse_digits(str + 17, 2);
+
+    if (year < 0 || month < 0 || day < 0 || hour < 0 || minute < 0 || second < 0) {
+        return Parsed{UT_ERR_INVALID_FORMAT, 0};
+    }
+    if (hour > 23 || minute > 59 || second > 59) {
+        return Parsed{UT_ERR_OUT_OF_RANGE, 0};
+    }
+    if (!valid_date(year, month, day)) {
+        return Parsed{UT_ERR_INVALID_DATE, 0};
+    }
+
+    int64_t frac_nanos = 0;
+    size_t pos = 19;
+
+    if (pos < len && str[pos] == '.') {
+        size_t frac_start = ++pos;
+        while (pos < len && str[pos] >= '0' && str[pos] <= '9') {
+            ++pos;
+        }
+        size_t frac_len = pos - frac_start;
+        if (frac_len == 0) {
+            return Parsed{UT_ERR_INVALID_FORMAT, 0};
+        }
+        if (frac_len > 9) {
+            return Parsed{UT_ERR_FRACTION_TOO_LONG, 0};
+        }
+        for (size_t i = 0; i < 9; ++i) {
+            frac_nanos = frac_nanos * 10 + (i < frac_len ? str[frac_start + i] - '0' : 0);
+        }
+    }
+
+    if (pos >= len) {
+        return Parsed{UT_ERR_INVALID_FORMAT, 0};
+    }
+    if (str[pos] == '+' || str[pos] == '-') {
+        if (len - pos < 6 || str[pos + 3] != ':' ||
+            parse_digits(str + pos + 1, 2) < 0 || parse_digits(str + pos + 4, 2) < 0) {
+            return Parsed{UT_ERR_INVALID_FORMAT, 0};
+        }
+        return Parsed{UT_ERR_UNSUPPORTED_OFFSET, 0};
+    }
+    if (str[pos] != 'Z' || pos + 1 != len) {
+        return Parsed{UT_ERR_INVALID_FORMAT, 0};
+    }
+
+    return Parsed{UT_OK, to_nanos(year, month, day, hour, minute, second, frac_nanos)};
+}
+
+UTS_CONSTEXPR14 int precision_digits(Precision precision) {
+
+    return precision == Precision::milliseconds ? 3
+         : precision == Precision::microseconds ? 6
+         : precision == Precision::nanoseconds ? 9
+         : 0;
+}
+
+/**
+ * Parses a formatter spec of "", "s", "ms", "us" or "ns" up to the closing brace.
+ * Returns the position of the brace and sets ok to false for unknown specs.
+ */
+
+template <typename It>
+UTS_CONSTEXPR14 It parse_precision_spec(It begin, It end, Precision& precision, bool& ok) {
+
+    It it = begin;
+    while (it != end && *it != '}') {
+        ++it;
+    }
+
+    size_t len = static_cast<size_t>(it - begin);
+    char c0 = len > 0 ? *begin : '\0';
+    char c1 = len > 1 ? *(begin + 1) : '\0';
+
+    if (len == 0) {
+        precision = Precision::automatic;
+    } else if (len == 1 && c0 == 's') {
+        precision = Precision::seconds;
+    } else if (len == 2 && c1 == 's' && (c0 == 'm' || c0 == 'u' || c0 == 'n')) {
+        precision = c0 == 'm' ? Precision::milliseconds
+                  : c0 == 'u' ? Precision::microseconds
+                  : Precision::nanoseconds;
+    } else {
+        ok = false;
+        return it;
+    }
+
+    ok = true;
+    return it;
+}
+
+/*
+ * Overflow-aware helpers behind Duration and Timestamp arithmetic. Each is
+ * a single expression so it stays constexpr in C++11 and inlines to a few
+ * compares; results match the C library's ut_*_saturating() functions.
+ */
+
+constexpr int64_t sat_add(int64_t a, int64_t b) {
+    return (b > 0 && a > INT64_MAX - b) ? INT64_MAX
+         : (b < 0 && a < INT64_MIN - b) ? INT64_MIN
+         : a + b;
+}
+
+constexpr int64_t sat_sub(int64_t a, int64_t b) {
+    return (b < 0 && a > INT64_MAX + b) ? INT64_MAX
+         : (b > 0 && a < INT64_MIN + b) ? INT64_MIN
+         : a - b;
+}
+
+constexpr int64_t sat_mul(int64_t a, int64_t positive_b) {
+    return a > INT64_MAX / positive_b ? INT64_MAX
+         : a < INT64_MIN / positive_b ? INT64_MIN
+         : a * positive_b;
+}
+
+constexpr bool add_overflows(int64_t a, int64_t b) {
+    return (b > 0 && a > INT64_MAX - b) || (b < 0 && a < INT64_MIN - b);
+}
+
+constexpr bool sub_overflows(int64_t a, int64_t b) {
+    return (b < 0 && a > INT64_MAX + b) || (b > 0 && a < INT64_MIN + b);
+}
+
+constexpr int64_t unit_nanos(ut_unit_t unit) {
+    return unit == UT_UNIT_MICROSECOND ? 1000LL
+         : unit == UT_UNIT_MILLISECOND ? 1000000LL
+         : unit == UT_UNIT_SECOND ? 1000000000LL
+         : unit == UT_UNIT_MINUTE ? 60000000000LL
+         : unit == UT_UNIT_HOUR ? 3600000000000LL
+         : unit == UT_UNIT_DAY ? 86400000000000LL
+         : unit == UT_UNIT_WEEK ? 604800000000000LL
+         : unit == UT_UNIT_MONTH || unit == UT_UNIT_YEAR ? 0
+         : 1;
+}
+
+constexpr int64_t floor_with_rem(int64_t value, int64_t rem, int64_t step) {
+    return rem >= 0 ? value - rem
+         : value < INT64_MIN + (step + rem) ? INT64_MIN
+         : value - rem - step;
+}
+
+constexpr int64_t floor_to(int64_t value, int64_t step) {
+    return floor_with_rem(value, value % step, step);
+}
+
+}  /* namespace detail */
+
+/**
+ * @brief Signed span of time in nanoseconds, layout-compatible with ut_duration_t.
+ *
+ * All arithmetic is constexpr, inline and saturating, so it compiles to
+ * the same few instructions as hand-written int64_t math while never
+ * wrapping. Converts implicitly from any std::chrono::duration.
+ */
+
+class Duration {
+public:
+
+    /**
+     * @brief Construct from a nanosecond count.
+     */
+
+    constexpr explicit Duration(int64_t nanos = 0) : nanos_(nanos) {}
+
+    /**
+     * @brief Construct from the C struct.
+     */
+
+    constexpr explicit Duration(ut_duration_t d) : nanos_(d.nanos) {}
+
+    /**
+     * @brief Construct from a std::chrono duration, truncating below one nanosecond.
+     */
+
+    template <typename Rep, typename Period>
+    constexpr Duration(std::chrono::duration<Rep, Period> d)
+        : nanos_(static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count())) {}
+
+    /**
+     * @brief Build from a count of units, saturating on overflow.
+     */
+
+    static constexpr Duration from(int64_t count, ut_unit_t unit) {
+        return Duration(detail::unit_nanos(unit) == 0 ? 0 : detail::sat_mul(count, detail::unit_nanos(unit)));
+    }
+
+    /**
+     * @brief Get the length in nanoseconds.
+     */
+
+    constexpr int64_t nanos() const noexcept { return nanos_; }
+
+    /**
+     * @brief Get whole units, truncating toward zero.
+     */
+
+    constexpr int64_t count(ut_unit_t unit) const noexcept {
+        return detail::unit_nanos(unit) == 0 ? 0 : nanos_ / detail::unit_nanos(unit);
+    }
+
+    /**
+     * @brief Get underlying C struct.
+     */
+
+    constexpr ut_duration_t raw() const noexcept { return ut_duration_t{nanos_}; }
+
+    /**
+     * @brief Convert to std::chrono::nanoseconds.
+     */
+
+    constexpr std::chrono::nanoseconds to_chrono() const noexcept { return std::chrono::nanoseconds(nanos_); }
+
+    constexpr Duration operator-() const noexcept {
+        return Duration(nanos_ == INT64_MIN ? INT64_MAX : -nanos_);
+    }
+
+    constexpr Duration operator+(Duration other) const noexcept {
+        return Duration(detail::sat_add(nanos_, other.nanos_));
+    }
+
+    constexpr Duration operator-(Duration other) const noexcept {
+        return Duration(detail::sat_sub(nanos_, other.nanos_));
+    }
+
+    UTS_CONSTEXPR14 Duration& operator+=(Duration other) noexcept {
+        nanos_ = detail::sat_add(nanos_, other.nanos_);
+        return *this;
+    }
+
+    UTS_CONSTEXPR14 Duration& operator-=(Duration other) noexcept {
+        nanos_ = detail::sat_sub(nanos_, other.nanos_);
+        return *this;
+    }
+
+    constexpr bool operator==(Duration other) const noexcept { return nanos_ == other.nanos_; }
+    constexpr bool operator!=(Duration other) const noexcept { return nanos_ != other.nanos_; }
+    constexpr bool operator<(Duration other) const noexcept { return nanos_ < other.nanos_; }
+    constexpr bool operator<=(Duration other) const noexcept { return nanos_ <= other.nanos_; }
+    constexpr bool operator>(Duration other) const noexcept { return nanos_ > other.nanos_; }
+    constexpr bool operator>=(Duration other) const noexcept { return nanos_ >= other.nanos_; }
+
+private:
+    int64_t nanos_;
+};
+
+static_assert(sizeof(Duration) == sizeof(ut_duration_t) &&
+              std::is_standard_layout<Duration>::value,
+              "Duration must be layout-compatible with ut_duration_t");
+
+struct ParseResult;
+
 /**
  * @brief Represents a UTC timestamp with nanosecond precision.
  */
@@ -45,13 +440,49 @@ public:
      * @brief Construct from Unix nanoseconds.
      */
 
-    explicit Timestamp(int64_t nanos = 0) : ts_{nanos} {}
+    constexpr explicit Timestamp(int64_t nanos = 0) : ts_{nanos} {}
 
     /**
      * @brief Construct from the C struct.
      */
 
-    explicit Timestamp(ut_timestamp_t ts) : ts_(ts) {}
+    constexpr explicit Timestamp(ut_timestamp_t ts) : ts_(ts) {}
+
+    /**
+     * @brief Build a timestamp from UTC calendar fields.
+     *
+     * constexpr from C++14, so constant arguments fold at compile time.
+     * @throws Error (UT_ERR_INVALID_DATE or UT_ERR_OUT_OF_RANGE) on bad
+     *         fields; in a constant expression this is a compile error.
+     */
+
+    static UTS_CONSTEXPR14 Timestamp from_civil(int year, int month, int day,
+                                                int hour = 0, int minute = 0, int second = 0,
+                                                int64_t frac_nanos = 0) {
+
+        if (!detail::valid_date(year, month, day)) {
+            throw Error(UT_ERR_INVALID_DATE);
+        }
+        if (hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 59 ||
+            frac_nanos < 0 || frac_nanos > 999999999) {
+            throw Error(UT_ERR_OUT_OF_RANGE);
+        }
+
+        return Timestamp(detail::to_nanos(year, month, day, hour, minute, second, frac_nanos));
+    }
+
+    /**
+     * @brief Convert from a std::chrono::system_clock time point.
+     *
+     * system_clock counts from the Unix epoch on every mainstream
+     * implementation (guaranteed from C++20).
+     */
+
+    template <typename Dur>
+    static constexpr Timestamp from_sys_time(std::chrono::time_point<std::chrono::system_clock, Dur> tp) {
+        return Timestamp(static_cast<int64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count()));
+    }
 
     /**
      * @brief Get current UTC time.
@@ -62,6 +493,15 @@ public:
         return Timestamp(ut_now());
     }
 
+    /**
+     * @brief Get current UTC time from a specific clock source.
+     */
+
+    static Timestamp now(ut_clock_source_t source) {
+
+        return Timestamp(ut_now_with(source));
+    }
+
     /**
      * @brief Get current UTC time with monotonic guarantee.
      */
@@ -71,6 +511,65 @@ public:
         return Timestamp(ut_now_monotonic());
     }
 
+    /**
+     * @brief Reserve n consecutive monotonic timestamps into out.
+     * @throws Error if out is null and n is non-zero.
+     */
+
+    static void now_monotonic_batch(Timestamp* out, size_t n) {
+
+        ut_error_t err = ut_now_monotonic_n(reinterpret_cast<ut_timestamp_t*>(out), n);
+
+        if (err != UT_OK) {
+            throw Error(err);
+        }
+    }
+
+    /**
+     * @brief Reserve n consecutive monotonic timestamps with one atomic update.
+     */
+
+    static std::vector<Timestamp> now_monotonic_batch(size_t n) {
+
+        std::vector<Timestamp> out(n);
+        now_monotonic_batch(out.data(), n);
+        return out;
+    }
+
+    /**
+     * @brief Parse from a length-delimited buffer (strict mode).
+     * @throws Error on parse failure.
+     */
+
+    static Timestamp parse(const char* data, size_t len) {
+
+        ut_timestamp_t ts;
+        ut_error_t err = ut_parse_strict_n(data, len, &ts);
+
+        if (err != UT_OK) {
+            throw Error(err);
+        }
+
+        return Timestamp(ts);
+    }
+
+    /**
+     * @brief Parse from a null-terminated string (strict mode).
+     * @throws Error on parse failure.
+     */
+
+    static Timestamp parse(const char* str) {
+
+        ut_timestamp_t ts;
+        ut_error_t err = ut_parse_strict(str, &ts);
+
+        if (err != UT_OK) {
+            throw Error(err);
+        }
+
+        return Timestamp(ts);
+    }
+
     /**
      * @brief Parse from ISO-8601 string (strict mode).
      * @throws Error on parse failure.
@@ -78,8 +577,35 @@ public:
 
     static Timestamp parse(const std::string& str) {
 
+        return parse(str.data(), str.size());
+    }
+
+    /**
+     * @brief Parse from a length-delimited buffer (lenient mode).
+     * @throws Error on parse failure.
+     */
+
+    static Timestamp parse_lenient(const char* data, size_t len) {
+
+        ut_timestamp_t ts;
+        ut_error_t err = ut_parse_lenient_n(data, len, &ts);
+
+        if (err != UT_OK) {
+            throw Error(err);
+        }
+
+        return Timestamp(ts);
+    }
+
+    /**
+     * @brief Parse from a null-terminated string (lenient mode).
+     * @throws Error on parse failure.
+     */
+
+    static Timestamp parse_lenient(const char* str) {
+
         ut_timestamp_t ts;
-        ut_error_t err = ut_parse_strict(str.c_str(), &ts);
+        ut_error_t err = ut_parse_lenient(str, &ts);
 
         if (err != UT_OK) {
             throw Error(err);
@@ -95,8 +621,46 @@ public:
 
     static Timestamp parse_lenient(const std::string& str) {
 
+        return parse_lenient(str.data(), str.size());
+    }
+
+#if UTS_HAS_STRING_VIEW
+
+    /**
+     * @brief Parse from a string view without copying (strict mode).
+     * @throws Error on parse failure.
+     */
+
+    static Timestamp parse(std::string_view str) {
+
+        return parse(str.data(), str.size());
+    }
+
+    /**
+     * @brief Parse from a string view without copying (lenient mode).
+     * @throws Error on parse failure.
+     */
+
+    static Timestamp parse_lenient(std::string_view str) {
+
+        return parse_lenient(str.data(), str.size());
+    }
+
+#endif
+
+    /**
+     * @brief Parse a timestamp at the start of a buffer.
+     *
+     * Stops at the first byte that cannot continue the timestamp and
+     * stores the number of bytes used in consumed.
+     * @throws Error on parse failure.
+     */
+
+    static Timestamp parse_prefix(const char* data, size_t len, size_t& consumed,
+                                  bool strict = true) {
+
         ut_timestamp_t ts;
-        ut_error_t err = ut_parse_lenient(str.c_str(), &ts);
+        ut_error_t err = ut_parse_prefix(data, len, &ts, &consumed, strict);
 
         if (err != UT_OK) {
             throw Error(err);
@@ -105,6 +669,30 @@ public:
         return Timestamp(ts);
     }
 
+    /**
+     * @brief Parse without throwing (strict mode).
+     *
+     * Use on hot paths where malformed input is routine; check the
+     * result's ok() or error instead of catching uts::Error.
+     */
+
+    static ParseResult try_parse(const char* data, size_t len) noexcept;
+    static ParseResult try_parse(const char* str) noexcept;
+    static ParseResult try_parse(const std::string& str) noexcept;
+
+    /**
+     * @brief Parse without throwing (lenient mode).
+     */
+
+    static ParseResult try_parse_lenient(const char* data, size_t len) noexcept;
+    static ParseResult try_parse_lenient(const char* str) noexcept;
+    static ParseResult try_parse_lenient(const std::string& str) noexcept;
+
+#if UTS_HAS_STRING_VIEW
+    static ParseResult try_parse(std::string_view str) noexcept;
+    static ParseResult try_parse_lenient(std::string_view str) noexcept;
+#endif
+
     /**
      * @brief Format to ISO-8601 string.
      */
@@ -115,17 +703,153 @@ public:
         return std::string(buf);
     }
 
+    /**
+     * @brief Format into caller storage without allocating.
+     *
+     * out must have room for UT_MAX_STRING_LEN bytes. A null terminator is
+     * written at the returned position, which is one past the last character.
+     */
+
+    char* format_to(char* out, Precision precision = Precision::automatic) const {
+
+        if (precision == Precision::automatic) {
+            return out + ut_format(ts_, out, UT_MAX_STRING_LEN, true);
+        }
+
+        char* end = out + ut_format(ts_, out, UT_MAX_STRING_LEN, false);
+        int digits = detail::precision_digits(precision);
+
+        if (digits > 0) {
+            int64_t frac = ts_.nanos % 1000000000LL;
+            if (frac < 0) {
+                frac += 1000000000LL;
+            }
+            for (int i = digits; i < 9; ++i) {
+                frac /= 10;
+            }
+
+            char* p = end - 1;
+            *p++ = '.';
+            for (int i = digits - 1; i >= 0; --i) {
+                p[i] = static_cast<char>('0' + frac % 10);
+                frac /= 10;
+            }
+            p += digits;
+            *p++ = 'Z';
+            *p = '\0';
+            end = p;
+        }
+
+        return end;
+    }
+
+    /**
+     * @brief Format into any output iterator of char without allocating.
+     * @return Output iterator past the last written character.
+     */
+
+    template <typename OutputIt>
+    OutputIt format_to(OutputIt out, Precision precision = Precision::automatic) const {
+
+        char buf[UT_MAX_STRING_LEN];
+        char* end = format_to(static_cast<char*>(buf), precision);
+
+        for (const char* p = buf; p != end; ++p) {
+            *out++ = *p;
+        }
+
+        return out;
+    }
+
     /**
      * @brief Get underlying nanoseconds since epoch.
      */
 
-    int64_t nanos() const noexcept { return ts_.nanos; }
+    constexpr int64_t nanos() const noexcept { return ts_.nanos; }
 
     /**
      * @brief Get underlying C struct.
      */
 
-    ut_timestamp_t raw() const noexcept { return ts_; }
+    constexpr ut_timestamp_t raw() const noexcept { return ts_; }
+
+    /**
+     * @brief Convert to a std::chrono::system_clock time point.
+     */
+
+    std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> to_sys_time() const {
+        return std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds>(
+            std::chrono::nanoseconds(ts_.nanos));
+    }
+
+    /**
+     * @brief Round down to the start of the unit containing this instant.
+     *
+     * Fixed units fold at compile time; week, month and year defer to
+     * ut_truncate() for the calendar math.
+     */
+
+    constexpr Timestamp truncate(ut_unit_t unit) const noexcept {
+        return unit == UT_UNIT_WEEK || unit == UT_UNIT_MONTH || unit == UT_UNIT_YEAR
+             ? Timestamp(ut_truncate(ts_, unit))
+             : Timestamp(detail::floor_to(ts_.nanos, detail::unit_nanos(unit)));
+    }
+
+    /**
+     * @brief Add a duration without saturating.
+     * @return false (leaving out untouched) if the result would overflow.
+     */
+
+    UTS_CONSTEXPR14 bool checked_add(Duration d, Timestamp& out) const noexcept {
+
+        if (detail::add_overflows(ts_.nanos, d.nanos())) {
+            return false;
+        }
+
+        out = Timestamp(ts_.nanos + d.nanos());
+        return true;
+    }
+
+    /**
+     * @brief Subtract a duration without saturating.
+     * @return false (leaving out untouched) if the result would overflow.
+     */
+
+    UTS_CONSTEXPR14 bool checked_sub(Duration d, Timestamp& out) const noexcept {
+
+        if (detail::sub_overflows(ts_.nanos, d.nanos())) {
+            return false;
+        }
+
+        out = Timestamp(ts_.nanos - d.nanos());
+        return true;
+    }
+
+    /*
+     * Arithmetic saturates at the int64_t range, like ut_add_saturating().
+     */
+
+    constexpr Timestamp operator+(Duration d) const noexcept {
+        return Timestamp(detail::sat_add(ts_.nanos, d.nanos()));
+    }
+
+    constexpr Timestamp operator-(Duration d) const noexcept {
+        return Timestamp(detail::sat_sub(ts_.nanos, d.nanos()));
+    }
+
+    constexpr Duration operator-(const Timestamp& other) const noexcept {
+        return Duration(detail::sat_sub(ts_.nanos, other.ts_.nanos));
+    }
+
+    UTS_CONSTEXPR14 Timestamp& operator+=(Duration d) noexcept {
+        ts_.nanos = detail::sat_add(ts_.nanos, d.nanos());
+        return *this;
+    }
+
+    UTS_CONSTEXPR14 Timestamp& operator-=(Duration d) noexcept {
+        ts_.nanos = detail::sat_sub(ts_.nanos, d.nanos());
+        return *this;
+    }
 
     /**
      * @brief Convert to string (alias for format()).
@@ -133,27 +857,27 @@ public:
 
     std::string to_string() const { return format(true); }
 
-    bool operator==(const Timestamp& other) const noexcept {
+    constexpr bool operator==(const Timestamp& other) const noexcept {
         return ts_.nanos == other.ts_.nanos;
     }
 
-    bool operator!=(const Timestamp& other) const noexcept {
+    constexpr bool operator!=(const Timestamp& other) const noexcept {
         return ts_.nanos != other.ts_.nanos;
     }
 
-    bool operator<(const Timestamp& other) const noexcept {
+    constexpr bool operator<(const Timestamp& other) const noexcept {
         return ts_.nanos < other.ts_.nanos;
     }
 
-    bool operator<=(const Timestamp& other) const noexcept {
+    constexpr bool operator<=(const Timestamp& other) const noexcept {
         return ts_.nanos <= other.ts_.nanos;
     }
 
-    bool operator>(const Timestamp& other) const noexcept {
+    constexpr bool operator>(const Timestamp& other) const noexcept {
         return ts_.nanos > other.ts_.nanos;
     }
 
-    bool operator>=(const Timestamp& other) const noexcept {
+    constexpr bool operator>=(const Timestamp& other) const noexcept {
         return ts_.nanos >= other.ts_.nanos;
     }
 
@@ -161,6 +885,218 @@ private:
     ut_timestamp_t ts_;
 };
 
+/**
+ * @brief Outcome of a non-throwing parse: a value or an error code.
+ */
+
+struct ParseResult {
+    Timestamp value;    /**< Parsed timestamp (zero on failure) */
+    ut_error_t error;   /**< UT_OK on success */
+
+    constexpr bool ok() const noexcept { return error == UT_OK; }
+
+    constexpr explicit operator bool() const noexcept { return error == UT_OK; }
+};
+
+inline ParseResult Timestamp::try_parse(const char* data, size_t len) noexcept {
+
+    ut_timestamp_t ts = {0};
+    ut_error_t err = ut_parse_strict_n(data, len, &ts);
+    return ParseResult{Timestamp(err == UT_OK ? ts.nanos : 0), err};
+}
+
+inline ParseResult Timestamp::try_parse(const char* str) noexcept {
+
+    ut_timestamp_t ts = {0};
+    ut_error_t err = ut_parse_strict(str, &ts);
+    return ParseResult{Timestamp(err == UT_OK ? ts.nanos : 0), err};
+}
+
+inline ParseResult Timestamp::try_parse(const std::string& str) noexcept {
+
+    return try_parse(str.data(), str.size());
+}
+
+inline ParseResult Timestamp::try_parse_lenient(const char* data, size_t len) noexcept {
+
+    ut_timestamp_t ts = {0};
+    ut_error_t err = ut_parse_lenient_n(data, len, &ts);
+    return ParseResult{Timestamp(err == UT_OK ? ts.nanos : 0), err};
+}
+
+inline ParseResult Timestamp::try_parse_lenient(const char* str) noexcept {
+
+    ut_timestamp_t ts = {0};
+    ut_error_t err = ut_parse_lenient(str, &ts);
+    return ParseResult{Timestamp(err == UT_OK ? ts.nanos : 0), err};
+}
+
+inline ParseResult Timestamp::try_parse_lenient(const std::string& str) noexcept {
+
+    return try_parse_lenient(str.data(), str.size());
+}
+
+#if UTS_HAS_STRING_VIEW
+
+inline ParseResult Timestamp::try_parse(std::string_view str) noexcept {
+
+    return try_parse(str.data(), str.size());
+}
+
+inline ParseResult Timestamp::try_parse_lenient(std::string_view str) noexcept {
+
+    return try_parse_lenient(str.data(), str.size());
+}
+
+#endif
+
+constexpr Timestamp operator+(Duration d, const Timestamp& ts) noexcept {
+    return ts + d;
+}
+
+static_assert(sizeof(Timestamp) == sizeof(ut_timestamp_t) &&
+              std::is_standard_layout<Timestamp>::value,
+              "Timestamp must be layout-compatible with ut_timestamp_t");
+
+/**
+ * @brief Format a contiguous span of timestamps into fixed-size slots.
+ *
+ * Element i is written null-terminated at out + i * stride.
+ * @throws Error on invalid arguments or a stride below UT_MAX_STRING_LEN.
+ */
+
+inline void format_batch(const Timestamp* data, size_t n, char* out, size_t stride,
+                         bool include_nanos = true) {
+    ut_error_t err = ut_format_batch(reinterpret_cast<const ut_timestamp_t*>(data),
+                                     n, out, stride, include_nanos);
+    if (err != UT_OK) {
+        throw Error(err);
+    }
+}
+
+/**
+ * @brief Format a range of timestamps, writing one std::string per element.
+ *
+ * Accepts any input iterator over Timestamp and any output iterator
+ * accepting std::string. Work is handed to ut_format_batch() in chunks.
+ *
+ * @return Output iterator past the last written element.
+ */
+
+template <typename InputIt, typename OutputIt>
+OutputIt format_batch(InputIt first, InputIt last, OutputIt out, bool include_nanos = true) {
+    const size_t chunk = 256;
+    ut_timestamp_t in[chunk];
+    char text[chunk * UT_MAX_STRING_LEN];
+
+    while (first != last) {
+        size_t n = 0;
+        for (; n < chunk && first != last; ++n, ++first) {
+            in[n] = static_cast<const Timestamp&>(*first).raw();
+        }
+        ut_format_batch(in, n, text, UT_MAX_STRING_LEN, include_nanos);
+        for (size_t i = 0; i < n; ++i) {
+            *out++ = std::string(text + i * UT_MAX_STRING_LEN);
+        }
+    }
+
+    return out;
+}
+
+/**
+ * @brief Truncate a contiguous span of timestamps to unit; out may equal data.
+ * @throws Error on null pointers or an unknown unit.
+ */
+
+inline void truncate_batch(const Timestamp* data, size_t n, ut_unit_t unit, Timestamp* out) {
+    ut_error_t err = ut_truncate_batch(reinterpret_cast<const ut_timestamp_t*>(data), n, unit,
+                                       reinterpret_cast<ut_timestamp_t*>(out));
+    if (err != UT_OK) {
+        throw Error(err);
+    }
+}
+
+/**
+ * @brief Owning wrapper around a ut_monotonic_gen_t.
+ *
+ * Create one per thread (or per core) to mint strictly increasing
+ * timestamps without contending on a shared counter. A non-zero
+ * shard_bits reserves that many low-order bits for shard_id, making
+ * values unique across clocks with distinct IDs.
+ */
+
+class MonotonicClock {
+public:
+    /**
+     * @brief Create a generator for one shard.
+     * @throws Error on an invalid shard or allocation failure.
+     */
+
+    explicit MonotonicClock(uint32_t shard_id = 0, unsigned shard_bits = 0) : gen_(nullptr) {
+
+        ut_error_t err = ut_monotonic_gen_create(shard_id, shard_bits, &gen_);
+
+        if (err != UT_OK) {
+            throw Error(err);
+        }
+    }
+
+    ~MonotonicClock() { ut_monotonic_gen_destroy(gen_); }
+
+    MonotonicClock(const MonotonicClock&) = delete;
+    MonotonicClock& operator=(const MonotonicClock&) = delete;
+
+    MonotonicClock(MonotonicClock&& other) noexcept : gen_(other.gen_) { other.gen_ = nullptr; }
+
+    MonotonicClock& operator=(MonotonicClock&& other) noexcept {
+
+        if (this != &other) {
+            ut_monotonic_gen_destroy(gen_);
+            gen_ = other.gen_;
+            other.gen_ = nullptr;
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Get the next timestamp from this clock.
+     */
+
+    Timestamp next() { return Timestamp(ut_monotonic_gen_next(gen_)); }
+
+private:
+    ut_monotonic_gen_t* gen_;
+};
+
+/**
+ * @brief User-defined literals for timestamps.
+ */
+
+namespace literals {
+
+/**
+ * @brief Parse a strict ISO-8601 literal, e.g. "2024-12-14T03:13:21Z"_uts.
+ *
+ * In C++20 this is consteval: every use is evaluated by the compiler and
+ * a malformed literal is a compile error. In C++14/17 it is constexpr, so
+ * it folds (and rejects bad literals at compile time) when used to
+ * initialize a constexpr variable, and throws Error otherwise.
+ */
+
+UTS_CONSTEVAL Timestamp operator""_uts(const char* str, size_t len) {
+
+    detail::Parsed result = detail::parse_strict(str, len);
+
+    if (result.error != UT_OK) {
+        throw Error(result.error);
+    }
+
+    return Timestamp(result.nanos);
+}
+
+}  /* namespace literals */
+
 /**
  * @brief Calendar conversion utilities.
  */
@@ -189,6 +1125,33 @@ inline JapaneseEra to_japanese_era(const Timestamp& ts) {
     return result;
 }
 
+/**
+ * @brief Register an era starting at 00:00 UTC on the given date.
+ * @throws Error if the date, order or name is rejected or the table is full.
+ */
+
+inline ut_japanese_era_t register_japanese_era(int year, int month, int day, const std::string& name) {
+    ut_japanese_era_t era;
+    ut_error_t err = ut_register_japanese_era(year, month, day, name.c_str(), &era);
+    if (err != UT_OK) {
+        throw Error(err);
+    }
+    return era;
+}
+
+/**
+ * @brief Convert a contiguous span of timestamps to eras in one call.
+ * @throws Error on null pointers or any row before Meiji.
+ */
+
+inline void to_japanese_era_batch(const Timestamp* data, size_t n, ut_japanese_era_t* eras, int* era_years) {
+    ut_error_t err = ut_to_japanese_era_batch(reinterpret_cast<const ut_timestamp_t*>(data), n,
+                                              eras, era_years, nullptr);
+    if (err != UT_OK) {
+        throw Error(err);
+    }
+}
+
 struct IsoWeek {
     int year;
     int week;
@@ -213,4 +1176,67 @@ inline ut_precision_t get_clock_precision() {
 
 }  /* namespace uts */
 
+#if UTS_HAS_STD_FORMAT
+
+/**
+ * @brief std::format support: "{}" or "{:s}", "{:ms}", "{:us}", "{:ns}".
+ */
+
+template <>
+struct std::formatter<uts::Timestamp, char> {
+    uts::Precision precision = uts::Precision::automatic;
+
+    constexpr std::format_parse_context::iterator parse(std::format_parse_context& ctx) {
+
+        bool ok = false;
+        auto it = uts::detail::parse_precision_spec(ctx.begin(), ctx.end(), precision, ok);
+
+        if (!ok) {
+            throw std::format_error("invalid uts::Timestamp format spec");
+        }
+
+        return it;
+    }
+
+    template <typename FormatContext>
+    typename FormatContext::iterator format(const uts::Timestamp& ts, FormatContext& ctx) const {
+
+        return ts.format_to(ctx.out(), precision);
+    }
+};
+
+#endif
+
+#if UTS_HAS_FMT
+
+/**
+ * @brief {fmt} support: "{}" or "{:s}", "{:ms}", "{:us}", "{:ns}".
+ */
+
+template <>
+struct fmt::formatter<uts::Timestamp> {
+    uts::Precision precision = uts::Precision::automatic;
+
+    template <typename ParseContext>
+    UTS_CONSTEXPR14 typename ParseContext::iterator parse(ParseContext& ctx) {
+
+        bool ok = false;
+        auto it = uts::detail::parse_precision_spec(ctx.begin(), ctx.end(), precision, ok);
+
+        if (!ok) {
+            throw fmt::format_error("invalid uts::Timestamp format spec");
+        }
+
+        return it;
+    }
+
+    template <typename FormatContext>
+    auto format(const uts::Timestamp& ts, FormatContext& ctx) const -> decltype(ctx.out()) {
+
+        return ts.format_to(ctx.out(), precision);
+    }
+};
+
+#endif
+
 #endif /* UNIVERSAL_TIMESTAMP_HPP */
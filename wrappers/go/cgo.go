@@ -0,0 +1,157 @@
+//go:build cgo && !utspure
+
+package universal_timestamp
+
+/*
+#cgo CFLAGS: -I../../include
+#cgo LDFLAGS: -L../../dist -l:libuniversal_timestamp.a
+#include <stdlib.h>
+#include "universal_timestamp.h"
+*/
+import "C"
+
+import (
+	"bytes"
+	"unsafe"
+)
+
+// Implementation reports which backend this build uses: "cgo" here, or
+// "pure" when built with the utspure tag or without cgo.
+const Implementation = "cgo"
+
+// Now returns the current UTC timestamp.
+func Now() Timestamp {
+	return Timestamp(C.ut_now().nanos)
+}
+
+// NowMonotonic returns a timestamp strictly greater than any previously
+// returned by NowMonotonic or NowMonotonicBatch.
+func NowMonotonic() Timestamp {
+	return Timestamp(C.ut_now_monotonic().nanos)
+}
+
+// NowMonotonicBatch reserves n consecutive monotonic timestamps with a
+// single cgo call and a single atomic update.
+func NowMonotonicBatch(n int) []Timestamp {
+	if n <= 0 {
+		return nil
+	}
+	out := make([]Timestamp, n)
+	C.ut_now_monotonic_n((*C.ut_timestamp_t)(unsafe.Pointer(&out[0])), C.size_t(n))
+	return out
+}
+
+// NowNanos returns the current UTC timestamp as Unix nanoseconds (int64).
+func NowNanos() int64 {
+	return int64(C.ut_now().nanos)
+}
+
+// Parse parses an ISO-8601 string into a timestamp.
+// It uses strict strict parsing by default.
+func Parse(s string) (Timestamp, error) {
+	return parseC(s, true)
+}
+
+// ParseLenient parses an ISO-8601 string, also accepting a missing or
+// lowercase 'Z', zero offsets and over-long fractions.
+func ParseLenient(s string) (Timestamp, error) {
+	return parseC(s, false)
+}
+
+// parseC hands s to ut_parse_strict_n or ut_parse_lenient_n without a copy.
+func parseC(s string, strict bool) (Timestamp, error) {
+	if len(s) == 0 {
+		return 0, errInvalidTimestamp
+	}
+
+	var ts C.ut_timestamp_t
+	p := (*C.char)(unsafe.Pointer(unsafe.StringData(s)))
+	var err C.ut_error_t
+	if strict {
+		err = C.ut_parse_strict_n(p, C.size_t(len(s)), &ts)
+	} else {
+		err = C.ut_parse_lenient_n(p, C.size_t(len(s)), &ts)
+	}
+	if err != C.UT_OK {
+		return 0, errInvalidTimestamp
+	}
+	return Timestamp(ts.nanos), nil
+}
+
+// collectBatch converts C results into Go values, with a nil error for
+// every record that parsed.
+func collectBatch(out []C.ut_timestamp_t, errs []C.ut_error_t) ([]Timestamp, []error) {
+	ts := make([]Timestamp, len(out))
+	es := make([]error, len(out))
+	for i := range out {
+		ts[i] = Timestamp(out[i].nanos)
+		if errs[i] != C.UT_OK {
+			es[i] = &ParseError{Code: int(errs[i])}
+		}
+	}
+	return ts, es
+}
+
+// ParseBatch parses many ISO-8601 strings with a single cgo call.
+// The i-th error is nil when ss[i] parsed successfully.
+func ParseBatch(ss []string, strict bool) ([]Timestamp, []error) {
+	n := len(ss)
+	if n == 0 {
+		return nil, nil
+	}
+
+	// The strings are copied into one C buffer because cgo forbids passing
+	// C an array of pointers into Go memory.
+	total := 0
+	for _, s := range ss {
+		total += len(s)
+	}
+	buf := C.malloc(C.size_t(total + 1))
+	defer C.free(buf)
+	data := unsafe.Slice((*byte)(buf), total+1)
+	strs := make([]*C.char, n)
+	lens := make([]C.size_t, n)
+	pos := 0
+	for i, s := range ss {
+		strs[i] = (*C.char)(unsafe.Pointer(&data[pos]))
+		lens[i] = C.size_t(len(s))
+		pos += copy(data[pos:], s)
+	}
+
+	out := make([]C.ut_timestamp_t, n)
+	errs := make([]C.ut_error_t, n)
+	C.ut_parse_batch(&strs[0], &lens[0], C.size_t(n), &out[0], &errs[0], C.bool(strict))
+	return collectBatch(out, errs)
+}
+
+// ParseBuffer parses delim-separated timestamps from one buffer with a
+// single cgo call. A trailing delimiter does not produce an extra record.
+func ParseBuffer(data []byte, delim byte, strict bool) ([]Timestamp, []error) {
+	if len(data) == 0 {
+		return nil, nil
+	}
+
+	capacity := bytes.Count(data, []byte{delim}) + 1
+	out := make([]C.ut_timestamp_t, capacity)
+	errs := make([]C.ut_error_t, capacity)
+	var count C.size_t
+	C.ut_parse_delimited((*C.char)(unsafe.Pointer(&data[0])), C.size_t(len(data)), C.char(delim),
+		&out[0], &errs[0], C.size_t(capacity), &count, C.bool(strict))
+	return collectBatch(out[:count], errs[:count])
+}
+
+// Format formats the timestamp as an ISO-8601 string.
+func (t Timestamp) Format() string {
+	var buf [maxStringLen]byte
+	return string(AppendFormat(buf[:0], t))
+}
+
+// AppendFormat appends the ISO-8601 form of t to dst and returns the
+// extended slice. It does not allocate when dst has room for 30 bytes.
+//
+// Formatting uses the Go renderer even in this build: a cgo call would cost
+// more than the rendering and its buffer would escape to the heap. The
+// conformance tests check that the output is identical to ut_format.
+func AppendFormat(dst []byte, t Timestamp) []byte {
+	return appendISO(dst, int64(t), true)
+}
@@ -0,0 +1,84 @@
+package universal_timestamp
+
+// Binary column codec, implemented in Go for both builds. The wire format is
+// section 7 of the specification and matches ut_encode_column/ut_decode_column.
+
+const (
+	// ColumnVersion is the column format version written and accepted.
+	ColumnVersion = 1
+	// ColumnHeaderLen is the size of the column header in bytes.
+	ColumnHeaderLen = 4
+)
+
+// ColumnEncoder builds a column incrementally. The zero value is ready to
+// use; bytes from successive Append calls concatenate to one column.
+type ColumnEncoder struct {
+	prev    uint64
+	started bool
+}
+
+// Append encodes ts onto dst, writing the header on the first call, and
+// returns the extended slice.
+func (e *ColumnEncoder) Append(dst []byte, ts ...Timestamp) []byte {
+	if !e.started {
+		dst = append(dst, 'U', 'T', ColumnVersion, 0)
+		e.started = true
+	}
+	prev := e.prev
+	for _, t := range ts {
+		d := uint64(t) - prev
+		u := d<<1 ^ -(d >> 63)
+		for u >= 0x80 {
+			dst = append(dst, byte(u)|0x80)
+			u >>= 7
+		}
+		dst = append(dst, byte(u))
+		prev = uint64(t)
+	}
+	e.prev = prev
+	return dst
+}
+
+// EncodeColumn appends the column encoding of ts to dst, as
+// ut_encode_column does.
+func EncodeColumn(dst []byte, ts []Timestamp) []byte {
+	var e ColumnEncoder
+	return e.Append(dst, ts...)
+}
+
+// DecodeColumn decodes a column produced by EncodeColumn or
+// ut_encode_column. A bad header or malformed value returns a *ParseError
+// with the invalid-format code.
+func DecodeColumn(b []byte) ([]Timestamp, error) {
+	return AppendDecodeColumn(nil, b)
+}
+
+// AppendDecodeColumn is DecodeColumn appending to dst; on error it returns
+// dst extended with the values decoded before the malformed one.
+func AppendDecodeColumn(dst []Timestamp, b []byte) ([]Timestamp, error) {
+	invalid := &ParseError{Code: codeInvalidFormat}
+	if len(b) < ColumnHeaderLen || b[0] != 'U' || b[1] != 'T' || b[2] != ColumnVersion || b[3] != 0 {
+		return dst, invalid
+	}
+
+	var prev uint64
+	for pos := ColumnHeaderLen; pos < len(b); {
+		var u uint64
+		shift := uint(0)
+		for {
+			if pos == len(b) || shift > 63 || (shift == 63 && b[pos] > 1) {
+				return dst, invalid
+			}
+			c := b[pos]
+			pos++
+			u |= uint64(c&0x7f) << shift
+			if c < 0x80 {
+				break
+			}
+			shift += 7
+		}
+		prev += u>>1 ^ -(u & 1)
+		dst = append(dst, Timestamp(prev))
+	}
+	return dst, nil
+}
@@ -0,0 +1,275 @@
+package universal_timestamp
+
+import (
+	"bufio"
+	"encoding/hex"
+	"math/rand"
+	"os"
+	"strconv"
+	"strings"
+	"testing"
+)
+
+// vectorPath is the conformance file shared with the C test suite.
+const vectorPath = "../../test/conformance_vectors.txt"
+
+var vectorErrors = map[string]int{
+	"INVALID_FORMAT":     codeInvalidFormat,
+	"INVALID_DATE":       codeInvalidDate,
+	"OUT_OF_RANGE":       codeOutOfRange,
+	"UNSUPPORTED_OFFSET": codeUnsupportedOffset,
+	"FRACTION_TOO_LONG":  codeFractionTooLong,
+	"LEAP_SECOND":        codeLeapSecond,
+}
+
+// loadVectors returns the op, input and expected fields of every case.
+func loadVectors(t *testing.T) [][3]string {
+	f, err := os.Open(vectorPath)
+	if err != nil {
+		t.Fatalf("open %s: %v", vectorPath, err)
+	}
+	defer f.Close()
+
+	var cases [][3]string
+	sc := bufio.NewScanner(f)
+	for sc.Scan() {
+		line := sc.Text()
+		if line == "" || line[0] == '#' {
+			continue
+		}
+		fields := strings.SplitN(line, "\t", 3)
+		if len(fields) != 3 {
+			t.Fatalf("malformed vector %q", line)
+		}
+		cases = append(cases, [3]string{fields[0], fields[1], fields[2]})
+	}
+	if len(cases) == 0 {
+		t.Fatal("no conformance vectors")
+	}
+	return cases
+}
+
+// checkParse compares a parse result with the expected nanos or error name.
+func checkParse(t *testing.T, label, input, expected string, nanos int64, code int) {
+	if want, isErr := vectorErrors[expected]; isErr {
+		if code != want {
+			t.Errorf("%s(%q) = code %d, want %s", label, input, code, expected)
+		}
+		return
+	}
+	want, _ := strconv.ParseInt(expected, 10, 64)
+	if code != codeOK || nanos != want {
+		t.Errorf("%s(%q) = %d (code %d), want %d", label, input, nanos, code, want)
+	}
+}
+
+// vectorNanos parses a comma-separated nanosecond list, "-" meaning none.
+func vectorNanos(list string) []Timestamp {
+	if list == "-" {
+		return nil
+	}
+	var out []Timestamp
+	for _, f := range strings.Split(list, ",") {
+		v, _ := strconv.ParseInt(f, 10, 64)
+		out = append(out, Timestamp(v))
+	}
+	return out
+}
+
+// checkColumn decodes raw and compares it with want.
+func checkColumn(t *testing.T, raw []byte, want []Timestamp) {
+	got, err := DecodeColumn(raw)
+	if err != nil || len(got) != len(want) {
+		t.Errorf("DecodeColumn(%x) = %v, %v, want %v", raw, got, err, want)
+		return
+	}
+	for i := range want {
+		if got[i] != want[i] {
+			t.Errorf("DecodeColumn(%x)[%d] = %d, want %d", raw, i, got[i], want[i])
+		}
+	}
+}
+
+// TestConformanceVectors runs the shared vectors through the public API of
+// this build and through the Go port directly.
+func TestConformanceVectors(t *testing.T) {
+	for _, v := range loadVectors(t) {
+		op, input, expected := v[0], v[1], v[2]
+		switch op {
+		case "strict", "lenient":
+			strict := op == "strict"
+			ts, errs := ParseBatch([]string{input}, strict)
+			code := codeOK
+			if pe, ok := errs[0].(*ParseError); ok {
+				code = pe.Code
+			}
+			checkParse(t, Implementation+"/"+op, input, expected, int64(ts[0]), code)
+			checkBatchMatchesParse(t, input, strict)
+
+			nanos, code := parseISO(input, strict)
+			checkParse(t, "parseISO/"+op, input, expected, nanos, code)
+		case "format", "format_short":
+			nanos, _ := strconv.ParseInt(input, 10, 64)
+			if op == "format" {
+				if got := Timestamp(nanos).Format(); got != expected {
+					t.Errorf("%s Format(%d) = %q, want %q", Implementation, nanos, got, expected)
+				}
+			}
+			if got := string(appendISO(nil, nanos, op == "format")); got != expected {
+				t.Errorf("appendISO(%d, %v) = %q, want %q", nanos, op == "format", got, expected)
+			}
+		case "column":
+			values := vectorNanos(input)
+			if got := hex.EncodeToString(EncodeColumn(nil, values)); got != expected {
+				t.Errorf("EncodeColumn(%s) = %s, want %s", input, got, expected)
+			}
+			raw, _ := hex.DecodeString(expected)
+			checkColumn(t, raw, values)
+		case "column_decode":
+			raw, _ := hex.DecodeString(input)
+			if want, isErr := vectorErrors[expected]; isErr {
+				_, err := DecodeColumn(raw)
+				if pe, ok := err.(*ParseError); !ok || pe.Code != want {
+					t.Errorf("DecodeColumn(%s) = %v, want %s", input, err, expected)
+				}
+				continue
+			}
+			checkColumn(t, raw, vectorNanos(expected))
+		default:
+			t.Errorf("unknown vector op %q", op)
+		}
+	}
+}
+
+// checkBatchMatchesParse requires ParseBatch([]string{s})[0] to equal Parse(s)
+// (or ParseLenient), so a batch never accepts what a single parse rejects.
+func checkBatchMatchesParse(t *testing.T, s string, strict bool) {
+	t.Helper()
+	parse := Parse
+	if !strict {
+		parse = ParseLenient
+	}
+	want, wantErr := parse(s)
+	ts, errs := ParseBatch([]string{s}, strict)
+	if (errs[0] == nil) != (wantErr == nil) || (wantErr == nil && ts[0] != want) {
+		t.Errorf("%s ParseBatch(%q, %v) = %d/%v, single parse = %d/%v",
+			Implementation, s, strict, ts[0], errs[0], want, wantErr)
+	}
+}
+
+// TestParseBatchMatchesParse covers terminators that a buffer parser would
+// treat as record separators but a single parse rejects.
+func TestParseBatchMatchesParse(t *testing.T) {
+	for _, s := range []string{
+		"2024-12-14T12:00:00Z", "2024-12-14T12:00:00Z\n", "2024-12-14T12:00:00Z\r\n",
+		"2024-12-14T12:00:00Z\x00", "2024-12-14T12:00:00Z\x00junk", "",
+	} {
+		checkBatchMatchesParse(t, s, true)
+		checkBatchMatchesParse(t, s, false)
+	}
+}
+
+// TestPortMatchesBuild cross-checks the Go port against the active backend on
+// random values; in the cgo build this compares Go with the C library.
+func TestPortMatchesBuild(t *testing.T) {
+	rng := rand.New(rand.NewSource(1))
+	for i := 0; i < 20000; i++ {
+		nanos := rng.Int63() - rng.Int63()
+		want := Timestamp(nanos).Format()
+		if got := string(appendISO(nil, nanos, true)); got != want {
+			t.Fatalf("appendISO(%d) = %q, %s = %q", nanos, got, Implementation, want)
+		}
+
+		s := []byte(want)
+		if rng.Intn(2) == 0 {
+			s[rng.Intn(len(s))] = "0123456789-:TZz.+ "[rng.Intn(18)]
+		}
+		for _, strict := range []bool{true, false} {
+			ts, errs := ParseBatch([]string{string(s)}, strict)
+			code := codeOK
+			if pe, ok := errs[0].(*ParseError); ok {
+				code = pe.Code
+			}
+			nanos, got := parseISO(s, strict)
+			if got != code || (code == codeOK && nanos != int64(ts[0])) {
+				t.Fatalf("parseISO(%q, %v) = %d/%d, %s = %d/%d", s, strict, nanos, got, Implementation, ts[0], code)
+			}
+		}
+	}
+}
+
+func TestAppendFormatAllocs(t *testing.T) {
+	buf := make([]byte, 0, 64)
+	ts := Timestamp(1734177600123456789)
+	if got := string(AppendFormat([]byte("at "), ts)); got != "at 2024-12-14T12:00:00.123456789Z" {
+		t.Errorf("AppendFormat = %q", got)
+	}
+	allocs := testing.AllocsPerRun(1000, func() {
+		buf = AppendFormat(buf[:0], ts)
+	})
+	if allocs != 0 {
+		t.Errorf("AppendFormat allocated %.0f times per call", allocs)
+	}
+}
+
+func TestParseLenient(t *testing.T) {
+	ts, err := ParseLenient("2024-12-14T12:00:00+00:00")
+	if err != nil || ts != 1734177600000000000 {
+		t.Errorf("ParseLenient = %d, %v", ts, err)
+	}
+	if _, err := Parse("2024-12-14T12:00:00+00:00"); err == nil {
+		t.Error("Parse accepted an offset")
+	}
+	if _, err := ParseLenient(""); err == nil {
+		t.Error("ParseLenient accepted an empty string")
+	}
+}
+
+func BenchmarkAppendFormat(b *testing.B) {
+	buf := make([]byte, 0, 64)
+	for i := 0; i < b.N; i++ {
+		buf = AppendFormat(buf[:0], Timestamp(1734177600123456789+int64(i)))
+	}
+}
+
+func BenchmarkParse(b *testing.B) {
+	for i := 0; i < b.N; i++ {
+		if _, err := Parse("2024-12-14T12:00:00.123456789Z"); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func BenchmarkNowMonotonic(b *testing.B) {
+	for i := 0; i < b.N; i++ {
+		NowMonotonic()
+	}
+}
+
+// TestColumnIncremental checks that ColumnEncoder.Append in chunks produces
+// the same bytes as EncodeColumn and that they decode back.
+func TestColumnIncremental(t *testing.T) {
+	rng := rand.New(rand.NewSource(2))
+	values := make([]Timestamp, 1000)
+	v := int64(1734177600000000000)
+	for i := range values {
+		v += rng.Int63n(2000000) - 100000
+		values[i] = Timestamp(v)
+	}
+	values[10], values[11] = Timestamp(rng.Int63()), Timestamp(-rng.Int63())
+
+	whole := EncodeColumn(nil, values)
+	var e ColumnEncoder
+	var parts []byte
+	for i := 0; i < len(values); i += 7 {
+		end := i + 7
+		if end > len(values) {
+			end = len(values)
+		}
+		parts = e.Append(parts, values[i:end]...)
+	}
+	if string(parts) != string(whole) {
+		t.Fatal("incremental encoding differs from EncodeColumn")
+	}
+	checkColumn(t, whole, values)
+}
@@ -0,0 +1,282 @@
+package universal_timestamp
+
+// Go port of the C library's strict/lenient parser and renderer. The cgo
+// build keeps calling into C; this code backs the pure build and is checked
+// against the C library by the shared conformance vectors in
+// test/conformance_vectors.txt.
+
+// Error codes, matching ut_error_t.
+const (
+	codeOK = iota
+	codeInvalidFormat
+	codeInvalidDate
+	codeOutOfRange
+	codeUnsupportedOffset
+	codeFractionTooLong
+	codeLeapSecond
+	codeNullPointer
+	codeBufferTooSmall
+	codeOutOfMemory
+	codeUnavailable
+)
+
+const (
+	maxStringLen   = 32
+	nanosPerSecond = 1000000000
+	secondsPerDay  = 86400
+)
+
+// errorString mirrors ut_error_string.
+func errorString(code int) string {
+	switch code {
+	case codeOK:
+		return "Success"
+	case codeInvalidFormat:
+		return "Invalid format"
+	case codeInvalidDate:
+		return "Invalid date"
+	case codeOutOfRange:
+		return "Value out of range"
+	case codeUnsupportedOffset:
+		return "Unsupported timezone offset"
+	case codeFractionTooLong:
+		return "Fractional seconds too long"
+	case codeLeapSecond:
+		return "Leap second not supported"
+	case codeNullPointer:
+		return "Null pointer"
+	case codeBufferTooSmall:
+		return "Buffer too small"
+	case codeOutOfMemory:
+		return "Out of memory"
+	case codeUnavailable:
+		return "Resource unavailable"
+	}
+	return "Unknown error"
+}
+
+const digitPairs = "0001020304050607080910111213141516171819" +
+	"2021222324252627282930313233343536373839" +
+	"4041424344454647484950515253545556575859" +
+	"6061626364656667686970717273747576777879" +
+	"8081828384858687888990919293949596979899"
+
+func isLeapYear(year int) bool {
+	return (year%4 == 0 && year%100 != 0) || year%400 == 0
+}
+
+func daysInMonth(year, month int) int {
+	switch month {
+	case 2:
+		if isLeapYear(year) {
+			return 29
+		}
+		return 28
+	case 4, 6, 9, 11:
+		return 30
+	}
+	return 31
+}
+
+func validateDate(year, month, day int) bool {
+	return year >= 0 && year <= 9999 && month >= 1 && month <= 12 &&
+		day >= 1 && day <= daysInMonth(year, month)
+}
+
+// daysFromCivil mirrors ut_internal_days_from_civil.
+func daysFromCivil(year, month, day int) int64 {
+	y := int64(year)
+	if month <= 2 {
+		y--
+	}
+	era := y
+	if era < 0 {
+		era -= 399
+	}
+	era /= 400
+	yoe := y - era*400
+	mp := int64((month + 9) % 12)
+	doy := (153*mp+2)/5 + int64(day) - 1
+	doe := yoe*365 + yoe/4 - yoe/100 + doy
+	return era*146097 + doe - 719468
+}
+
+// civilFromDays mirrors ut_internal_civil_from_days. The day-of-era terms
+// are non-negative, so they use unsigned 32-bit arithmetic.
+func civilFromDays(days int64) (year, month, day int) {
+	z := days + 719468
+	era := z
+	if era < 0 {
+		era -= 146096
+	}
+	era /= 146097
+	doe := uint32(z - era*146097)
+	yoe := (doe - doe/1460 + doe/36524 - doe/146096) / 365
+	doy := doe - (365*yoe + yoe/4 - yoe/100)
+	mp := (5*doy + 2) / 153
+	m := mp + 3
+	if mp >= 10 {
+		m = mp - 9
+	}
+	y := int64(yoe) + era*400
+	if m <= 2 {
+		y++
+	}
+	return int(y), int(m), int(doy - (153*mp+2)/5 + 1)
+}
+
+// text is the input accepted by the parser, so buffers parse without a copy.
+type text interface {
+	~string | ~[]byte
+}
+
+// parseDigits returns the value of n ASCII digits at s[i:], or -1.
+func parseDigits[T text](s T, i, n int) int {
+	v := 0
+	for j := i; j < i+n; j++ {
+		c := s[j]
+		if c < '0' || c > '9' {
+			return -1
+		}
+		v = v*10 + int(c-'0')
+	}
+	return v
+}
+
+var fractionScale = [...]int64{100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1}
+
+// parseISO mirrors ut_internal_parse_scalar and returns a ut_error_t code.
+func parseISO[T text](s T, strict bool) (int64, int) {
+	if len(s) < 19 {
+		return 0, codeInvalidFormat
+	}
+	if s[4] != '-' || s[7] != '-' || s[10] != 'T' || s[13] != ':' || s[16] != ':' {
+		return 0, codeInvalidFormat
+	}
+
+	year := parseDigits(s, 0, 4)
+	month := parseDigits(s, 5, 2)
+	day := parseDigits(s, 8, 2)
+	hour := parseDigits(s, 11, 2)
+	minute := parseDigits(s, 14, 2)
+	second := parseDigits(s, 17, 2)
+	if year < 0 || month < 0 || day < 0 || hour < 0 || minute < 0 || second < 0 {
+		return 0, codeInvalidFormat
+	}
+	if hour > 23 || minute > 59 || second > 59 {
+		return 0, codeOutOfRange
+	}
+	if !validateDate(year, month, day) {
+		return 0, codeInvalidDate
+	}
+
+	var frac int64
+	pos := 19
+	if pos < len(s) && s[pos] == '.' {
+		pos++
+		start := pos
+		for pos < len(s) && s[pos] >= '0' && s[pos] <= '9' {
+			pos++
+		}
+		digits := pos - start
+		if digits == 0 {
+			return 0, codeInvalidFormat
+		}
+		if digits > 9 {
+			if strict {
+				return 0, codeFractionTooLong
+			}
+			digits = 9
+		}
+		frac = int64(parseDigits(s, start, digits)) * fractionScale[digits-1]
+	}
+
+	if pos < len(s) {
+		switch c := s[pos]; {
+		case c == 'Z':
+			pos++
+		case c == 'z':
+			if strict {
+				return 0, codeInvalidFormat
+			}
+			pos++
+		case c == '+' || c == '-':
+			if len(s)-pos < 6 || s[pos+3] != ':' {
+				return 0, codeInvalidFormat
+			}
+			offHour := parseDigits(s, pos+1, 2)
+			offMinute := parseDigits(s, pos+4, 2)
+			if offHour < 0 || offMinute < 0 {
+				return 0, codeInvalidFormat
+			}
+			if offHour != 0 || offMinute != 0 || strict {
+				return 0, codeUnsupportedOffset
+			}
+			pos += 6
+		default:
+			if strict {
+				return 0, codeInvalidFormat
+			}
+		}
+	} else if strict {
+		return 0, codeInvalidFormat
+	}
+	if pos != len(s) {
+		return 0, codeInvalidFormat
+	}
+
+	seconds := daysFromCivil(year, month, day)*secondsPerDay +
+		int64(hour)*3600 + int64(minute)*60 + int64(second)
+	return seconds*nanosPerSecond + frac, codeOK
+}
+
+// appendISO mirrors ut_format: "YYYY-MM-DDTHH:MM:SS[.f]Z" with trailing
+// fraction zeros trimmed.
+func appendISO(dst []byte, nanos int64, includeNanos bool) []byte {
+	secs := nanos / nanosPerSecond
+	frac := nanos % nanosPerSecond
+	if frac < 0 {
+		frac += nanosPerSecond
+		secs--
+	}
+	days := secs / secondsPerDay
+	sod := secs % secondsPerDay
+	if sod < 0 {
+		sod += secondsPerDay
+		days--
+	}
+	year, month, day := civilFromDays(days)
+	hour, minute, second := int(sod/3600), int(sod%3600/60), int(sod%60)
+
+	n := len(dst)
+	dst = append(dst, "0000-00-00T00:00:00"...)
+	b := dst[n : n+19]
+	yh, yl := year/100*2, year%100*2
+	b[0], b[1], b[2], b[3] = digitPairs[yh], digitPairs[yh+1], digitPairs[yl], digitPairs[yl+1]
+	b[5], b[6] = digitPairs[month*2], digitPairs[month*2+1]
+	b[8], b[9] = digitPairs[day*2], digitPairs[day*2+1]
+	b[11], b[12] = digitPairs[hour*2], digitPairs[hour*2+1]
+	b[14], b[15] = digitPairs[minute*2], digitPairs[minute*2+1]
+	b[17], b[18] = digitPairs[second*2], digitPairs[second*2+1]
+
+	if includeNanos && frac > 0 {
+		v := uint32(frac)
+		digits := 9
+		for v%10 == 0 {
+			v /= 10
+			digits--
+		}
+		n = len(dst) + 1
+		dst = append(dst, ".000000000"[:digits+1]...)
+		i := n + digits
+		for ; i-n >= 2; v /= 100 {
+			i -= 2
+			p := v % 100 * 2
+			dst[i], dst[i+1] = digitPairs[p], digitPairs[p+1]
+		}
+		if i > n {
+			dst[n] = byte('0' + v)
+		}
+	}
+	return append(dst, 'Z')
+}
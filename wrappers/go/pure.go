@@ -0,0 +1,143 @@
+//go:build utspure || !cgo
+
+package universal_timestamp
+
+import (
+	"bytes"
+	"sync/atomic"
+	"time"
+)
+
+// Implementation reports which backend this build uses: "pure" here, or
+// "cgo" for the default build that calls into the C library.
+const Implementation = "pure"
+
+// lastMonotonic is the most recent value handed out by NowMonotonic.
+var lastMonotonic atomic.Int64
+
+// Now returns the current UTC timestamp.
+func Now() Timestamp {
+	return Timestamp(time.Now().UnixNano())
+}
+
+// advanceMonotonic reserves count consecutive values above the last one
+// issued, starting at now when the clock has moved past it.
+func advanceMonotonic(count int64) int64 {
+	now := time.Now().UnixNano()
+	for {
+		prev := lastMonotonic.Load()
+		next := now
+		if next <= prev {
+			next = prev + 1
+		}
+		if lastMonotonic.CompareAndSwap(prev, next+count-1) {
+			return next
+		}
+	}
+}
+
+// NowMonotonic returns a timestamp strictly greater than any previously
+// returned by NowMonotonic or NowMonotonicBatch.
+func NowMonotonic() Timestamp {
+	return Timestamp(advanceMonotonic(1))
+}
+
+// NowMonotonicBatch reserves n consecutive monotonic timestamps with a
+// single atomic update.
+func NowMonotonicBatch(n int) []Timestamp {
+	if n <= 0 {
+		return nil
+	}
+	first := advanceMonotonic(int64(n))
+	out := make([]Timestamp, n)
+	for i := range out {
+		out[i] = Timestamp(first + int64(i))
+	}
+	return out
+}
+
+// NowNanos returns the current UTC timestamp as Unix nanoseconds (int64).
+func NowNanos() int64 {
+	return time.Now().UnixNano()
+}
+
+// Parse parses an ISO-8601 string into a timestamp.
+// It uses strict strict parsing by default.
+func Parse(s string) (Timestamp, error) {
+	nanos, code := parseISO(s, true)
+	if code != codeOK {
+		return 0, errInvalidTimestamp
+	}
+	return Timestamp(nanos), nil
+}
+
+// ParseLenient parses an ISO-8601 string, also accepting a missing or
+// lowercase 'Z', zero offsets and over-long fractions.
+func ParseLenient(s string) (Timestamp, error) {
+	nanos, code := parseISO(s, false)
+	if code != codeOK {
+		return 0, errInvalidTimestamp
+	}
+	return Timestamp(nanos), nil
+}
+
+// parseRecord parses one batch element, storing a ParseError on failure.
+func parseRecord[T text](s T, strict bool, ts *Timestamp, err *error) {
+	nanos, code := parseISO(s, strict)
+	if code != codeOK {
+		*ts, *err = 0, &ParseError{Code: code}
+		return
+	}
+	*ts = Timestamp(nanos)
+}
+
+// ParseBatch parses many ISO-8601 strings.
+// The i-th error is nil when ss[i] parsed successfully.
+func ParseBatch(ss []string, strict bool) ([]Timestamp, []error) {
+	if len(ss) == 0 {
+		return nil, nil
+	}
+	ts := make([]Timestamp, len(ss))
+	es := make([]error, len(ss))
+	for i, s := range ss {
+		parseRecord(s, strict, &ts[i], &es[i])
+	}
+	return ts, es
+}
+
+// ParseBuffer parses delim-separated timestamps from one buffer.
+// A trailing delimiter does not produce an extra record.
+func ParseBuffer(data []byte, delim byte, strict bool) ([]Timestamp, []error) {
+	if len(data) == 0 {
+		return nil, nil
+	}
+	n := bytes.Count(data, []byte{delim}) + 1
+	ts := make([]Timestamp, 0, n)
+	es := make([]error, 0, n)
+	for len(data) > 0 {
+		rec := data
+		if i := bytes.IndexByte(data, delim); i >= 0 {
+			rec, data = data[:i], data[i+1:]
+		} else {
+			data = nil
+		}
+		if delim == '\n' && len(rec) > 0 && rec[len(rec)-1] == '\r' {
+			rec = rec[:len(rec)-1]
+		}
+		ts, es = append(ts, 0), append(es, nil)
+		parseRecord(rec, strict, &ts[len(ts)-1], &es[len(es)-1])
+	}
+	return ts, es
+}
+
+// Format formats the timestamp as an ISO-8601 string.
+func (t Timestamp) Format() string {
+	var buf [maxStringLen]byte
+	return string(AppendFormat(buf[:0], t))
+}
+
+// AppendFormat appends the ISO-8601 form of t to dst and returns the
+// extended slice. It does not allocate when dst has room for 30 bytes.
+func AppendFormat(dst []byte, t Timestamp) []byte {
+	return appendISO(dst, int64(t), true)
+}
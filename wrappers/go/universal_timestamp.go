@@ -1,52 +1,25 @@
 package universal_timestamp
 
-/*
-#cgo CFLAGS: -I../../include
-#cgo LDFLAGS: -L../../dist -l:libuniversal_timestamp.a
-#include <stdlib.h>
-#include "universal_timestamp.h"
-*/
-import "C"
-
 import (
 	"errors"
+	"math"
 	"time"
-	"unsafe"
 )
 
 // Timestamp represents a Universal Timestamp.
 // It wraps the C ut_timestamp_t which is an int64 of nanoseconds.
 type Timestamp int64
 
-// Now returns the current UTC timestamp.
-func Now() Timestamp {
-	return Timestamp(C.ut_now().nanos)
-}
+// errInvalidTimestamp is what Parse and ParseLenient return for any rejected string.
+var errInvalidTimestamp = errors.New("invalid timestamp format")
 
-// NowNanos returns the current UTC timestamp as Unix nanoseconds (int64).
-func NowNanos() int64 {
-	return int64(C.ut_now().nanos)
+// ParseError reports why a timestamp string was rejected.
+type ParseError struct {
+	Code int
 }
 
-// Parse parses an ISO-8601 string into a timestamp.
-// It uses strict strict parsing by default.
-func Parse(s string) (Timestamp, error) {
-	cs := C.CString(s)
-	defer C.free(unsafe.Pointer(cs))
-
-	var ts C.ut_timestamp_t
-	if err := C.ut_parse_strict(cs, &ts); err != C.UT_OK {
-		return 0, errors.New("invalid timestamp format")
-	}
-	return Timestamp(ts.nanos), nil
-}
-
-// Format formats the timestamp as an ISO-8601 string.
-func (t Timestamp) Format() string {
-	var buf [64]C.char
-	cts := C.ut_timestamp_t{nanos: C.long(t)}
-	C.ut_format(cts, &buf[0], 64, true) // strict/z
-	return C.GoString(&buf[0])
+func (e *ParseError) Error() string {
+	return errorString(e.Code)
 }
 
 // ToTime converts the timestamp to a standard Go time.Time.
@@ -58,3 +31,45 @@ func (t Timestamp) ToTime() time.Time {
 func FromTime(t time.Time) Timestamp {
 	return Timestamp(t.UnixNano())
 }
+
+// Add returns t+d, saturating at the int64 range. It is plain Go
+// arithmetic and does not call into the C library.
+func (t Timestamp) Add(d time.Duration) Timestamp {
+	a, b := int64(t), int64(d)
+	if b > 0 && a > math.MaxInt64-b {
+		return math.MaxInt64
+	}
+	if b < 0 && a < math.MinInt64-b {
+		return math.MinInt64
+	}
+	return Timestamp(a + b)
+}
+
+// Sub returns the duration t-u, saturating at the int64 range.
+func (t Timestamp) Sub(u Timestamp) time.Duration {
+	a, b := int64(t), int64(u)
+	if b < 0 && a > math.MaxInt64+b {
+		return math.MaxInt64
+	}
+	if b > 0 && a < math.MinInt64+b {
+		return math.MinInt64
+	}
+	return time.Duration(a - b)
+}
+
+// Truncate rounds t down to a multiple of d, toward negative infinity,
+// matching ut_truncate. A non-positive d returns t unchanged.
+func (t Timestamp) Truncate(d time.Duration) Timestamp {
+	if d <= 0 {
+		return t
+	}
+	v, step := int64(t), int64(d)
+	rem := v % step
+	if rem < 0 {
+		if v < math.MinInt64+(step+rem) {
+			return math.MinInt64
+		}
+		rem += step
+	}
+	return Timestamp(v - rem)
+}
@@ -1,6 +1,7 @@
 package universal_timestamp
 
 import (
+	"math"
 	"testing"
 	"time"
 )
@@ -12,6 +13,25 @@ func TestNow(t *testing.T) {
 	}
 }
 
+func TestNowMonotonicBatch(t *testing.T) {
+	before := NowMonotonic()
+	ids := NowMonotonicBatch(1000)
+	if len(ids) != 1000 || ids[0] <= before {
+		t.Fatalf("NowMonotonicBatch returned %d ids starting at %d (before %d)", len(ids), ids[0], before)
+	}
+	for i := 1; i < len(ids); i++ {
+		if ids[i] != ids[i-1]+1 {
+			t.Fatalf("ids not consecutive at %d", i)
+		}
+	}
+	if NowMonotonic() <= ids[999] {
+		t.Error("NowMonotonic did not continue after the batch")
+	}
+	if NowMonotonicBatch(0) != nil {
+		t.Error("NowMonotonicBatch(0) should return nil")
+	}
+}
+
 func TestParseFormat(t *testing.T) {
 	input := "2024-12-14T12:00:00Z"
 	ts, err := Parse(input)
@@ -34,3 +54,56 @@ func TestToTime(t *testing.T) {
 		t.Errorf("Time conversion failed. Expected %v, got %v", now, goTime)
 	}
 }
+
+func TestParseBatch(t *testing.T) {
+	ts, errs := ParseBatch([]string{"2024-12-14T12:00:00Z", "garbage", "2024-12-14T12:00:00.5Z"}, true)
+	if len(ts) != 3 || len(errs) != 3 {
+		t.Fatalf("Unexpected result lengths %d, %d", len(ts), len(errs))
+	}
+	if errs[0] != nil || ts[0].Format() != "2024-12-14T12:00:00Z" {
+		t.Errorf("Element 0 mismatch: %v %v", ts[0], errs[0])
+	}
+	if errs[1] == nil {
+		t.Error("Expected error for element 1")
+	}
+	if errs[2] != nil || ts[2].Format() != "2024-12-14T12:00:00.5Z" {
+		t.Errorf("Element 2 mismatch: %v %v", ts[2], errs[2])
+	}
+}
+
+func TestParseBuffer(t *testing.T) {
+	ts, errs := ParseBuffer([]byte("2024-12-14T12:00:00Z\r\n2024-12-14T12:00:01Z\n"), '\n', true)
+	if len(ts) != 2 {
+		t.Fatalf("Expected 2 records, got %d", len(ts))
+	}
+	for i, err := range errs {
+		if err != nil {
+			t.Errorf("Record %d failed: %v", i, err)
+		}
+	}
+	if int64(ts[1]-ts[0]) != 1000000000 {
+		t.Errorf("Unexpected spacing %d", int64(ts[1]-ts[0]))
+	}
+}
+
+func TestArithmetic(t *testing.T) {
+	ts := Timestamp(1734146001123456789)
+	if got := ts.Add(time.Minute).Sub(ts); got != time.Minute {
+		t.Errorf("Add/Sub round trip = %v", got)
+	}
+	if got := Timestamp(math.MaxInt64).Add(time.Second); got != math.MaxInt64 {
+		t.Errorf("Add did not saturate: %d", got)
+	}
+	if got := Timestamp(math.MinInt64).Sub(Timestamp(math.MaxInt64)); got != math.MinInt64 {
+		t.Errorf("Sub did not saturate: %d", got)
+	}
+	if got := ts.Truncate(time.Second); got != 1734146001000000000 {
+		t.Errorf("Truncate(second) = %d", got)
+	}
+	if got := Timestamp(-1).Truncate(time.Second); got != -1000000000 {
+		t.Errorf("Truncate before epoch = %d", got)
+	}
+	if ts.Add(-time.Hour).ToTime() != ts.ToTime().Add(-time.Hour) {
+		t.Error("Add disagrees with time.Time.Add")
+	}
+}
@@ -1,7 +1,7 @@
 @echo off
 setlocal
 
-set "SRC=..\..\src\cli\uts_cli.c"
+set "SRC=..\..\src\cli\uts_cli.c ..\..\src\cli\uts_stream.c ..\..\src\cli\uts_convert.c"
 set "OUT=uts-cli.exe"
 set "INC=..\..\include"
 set "LIB=..\..\dist\universal_timestamp.lib"
@@ -12,7 +12,7 @@ REM Try MSVC
 cl >nul 2>&1
 if %ERRORLEVEL% EQU 0 (
     echo Using MSVC...
-    cl /nologo /O2 /I"%INC%" "%SRC%" "%LIB%" /Fe"%OUT%"
+    cl /nologo /O2 /I"%INC%" %SRC% "%LIB%" /Fe"%OUT%"
     if %ERRORLEVEL% EQU 0 (
         echo Build successful.
         del *.obj
@@ -20,11 +20,11 @@ if %ERRORLEVEL% EQU 0 (
     )
 )
 
-REM Try MinGW/GCC
+REM Try MinGW/GCC (static archive, so uts-cli.exe runs without universal_timestamp.dll on PATH)
 gcc --version >nul 2>&1
 if %ERRORLEVEL% EQU 0 (
     echo Using GCC...
-    gcc -O2 -I"%INC%" "%SRC%" -o "%OUT%" -L..\..\dist -l:libuniversal_timestamp.a
+    gcc -O2 -I"%INC%" %SRC% -o "%OUT%" -L..\..\dist -l:libuniversal_timestamp.a
     if %ERRORLEVEL% EQU 0 (
         echo Build successful.
         exit /b 0
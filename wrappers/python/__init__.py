@@ -8,6 +8,8 @@ from .universal_timestamp import (
     Precision,
     Calendar,
     JapaneseEra,
+    parse_batch,
+    parse_buffer,
     gregorian_to_thai,
     thai_to_gregorian,
     gregorian_to_dangi,
@@ -27,6 +29,8 @@ __all__ = [
     "Precision",
     "Calendar",
     "JapaneseEra",
+    "parse_batch",
+    "parse_buffer",
     "gregorian_to_thai",
     "thai_to_gregorian",
     "gregorian_to_dangi",
@@ -0,0 +1,99 @@
+"""Tests for the Python wrapper; run from this directory after `make shared`."""
+
+import array
+
+import universal_timestamp as u
+
+
+def test_parse_batch_matches_parse():
+    items = [
+        "2024-12-14T12:00:00Z",
+        "2024-12-14T12:00:00Z\n",
+        "2024-12-14T12:00:00Z\r\n",
+        "2024-12-14T12:00:00Z\0",
+        "garbage",
+    ]
+    nanos, errors = u.parse_batch(items)
+    for item, value, err in zip(items, nanos, errors):
+        try:
+            expected = (u.Timestamp.parse(item).nanos, u.Error.OK)
+        except u.ParseError as exc:
+            expected = (0, exc.code)
+        assert (value, err) == expected, (item, value, err, expected)
+    assert errors[0] == u.Error.OK
+    assert errors[1] != u.Error.OK
+    assert errors[3] != u.Error.OK
+
+
+def test_parse_rejects_embedded_nul():
+    try:
+        u.Timestamp.parse("2024-12-14T12:00:00Z\0junk")
+    except u.ParseError:
+        pass
+    else:
+        raise AssertionError("embedded NUL accepted")
+
+
+def test_parse_round_trip():
+    assert str(u.Timestamp.parse("2024-12-14T00:00:00Z")) == "2024-12-14T00:00:00Z"
+
+
+def _texts(formatted):
+    return [t.decode("ascii") if isinstance(t, bytes) else t for t in formatted]
+
+
+def test_format_array_matches_format():
+    values = array.array("q", [0, 1734177600123456789, 1734177600000000000, -1])
+    expected = [u.Timestamp(v).format() for v in values]
+    assert _texts(u.format_array(values)) == expected
+    assert _texts(u.format_array(memoryview(bytes(values)).cast("q"))) == expected
+    assert _texts(u.format_array(values, include_nanos=False))[1] == "2024-12-14T12:00:00Z"
+    assert len(u.format_array(array.array("q"))) == 0
+
+
+def test_format_array_rejects_other_buffers():
+    for bad in (array.array("i", [1, 2]), array.array("d", [1.0])):
+        try:
+            u.format_array(bad)
+        except TypeError:
+            pass
+        else:
+            raise AssertionError(f"accepted {bad.typecode} buffer")
+
+
+def test_parse_array_matches_parse_batch():
+    items = ["2024-12-14T12:00:00Z", b"1970-01-01T00:00:00.5Z", "garbage", "2024-12-14T12:00:00Z\n"]
+    nanos, errors = u.parse_array(items)
+    expected_nanos, expected_errors = u.parse_batch(items)
+    assert list(nanos) == expected_nanos
+    assert [u.Error(e) for e in errors] == expected_errors
+
+    out = array.array("q", [7]) * len(items)
+    same, _ = u.parse_array(items, out=out)
+    assert same is out and list(out) == expected_nanos
+
+
+def test_parse_array_round_trips_format_array():
+    values = array.array("q", [1734177600000000000 + i * 1000000007 for i in range(1000)])
+    nanos, errors = u.parse_array(_texts(u.format_array(values)))
+    assert list(nanos) == list(values) and not any(errors)
+
+
+def test_numpy_datetime64_zero_copy():
+    if u._np is None:
+        print("  (NumPy not installed; skipped)")
+        return
+    np = u._np
+    stamps = np.array(["2024-12-14T12:00:00.123456789", "1970-01-01"], dtype="datetime64[ns]")
+    assert list(u.format_array(stamps)) == [b"2024-12-14T12:00:00.123456789Z", b"1970-01-01T00:00:00Z"]
+    out = np.zeros(2, dtype="datetime64[ns]")
+    u.parse_array(["2024-12-14T12:00:00.123456789Z", "1970-01-01T00:00:00Z"], out=out)
+    assert (out == stamps).all()
+
+
+if __name__ == "__main__":
+    for name, fn in sorted(globals().items()):
+        if name.startswith("test_") and callable(fn):
+            fn()
+            print(f"PASS: {name}")
+    print("Python wrapper OK")
@@ -15,35 +15,55 @@ Example:
 
 from __future__ import annotations
 
+import array
 import ctypes
 import ctypes.util
 import os
+import sys
 from ctypes import c_int, c_int64, c_char_p, c_size_t, c_bool, POINTER, Structure
 from enum import IntEnum
 from pathlib import Path
-from typing import Optional, Callable
+from typing import Any, Optional, Callable, Sequence, Union
+
+try:
+    import numpy as _np
+except ImportError:
+    _np = None
 
 
 # --- Library Loading ---
 
+def _library_name() -> str:
+    """Platform file name of the shared library built by ``make shared``."""
+    if sys.platform == "win32":
+        return "universal_timestamp.dll"
+    if sys.platform == "darwin":
+        return "libuniversal_timestamp.dylib"
+    return "libuniversal_timestamp.so"
+
+
 def _find_library() -> ctypes.CDLL:
     """Find and load the universal_timestamp shared library."""
     
+    name = _library_name()
+    root = Path(__file__).parent.parent.parent
+    
     # Search paths in order of preference
     search_paths = [
         # Relative to this file (development)
-        Path(__file__).parent.parent.parent / "build" / "libuniversal_timestamp.so",
-        Path(__file__).parent.parent.parent / "dist" / "lib" / "libuniversal_timestamp.so",
+        root / "dist" / name,
+        root / "build" / name,
+        root / "dist" / "lib" / name,
         # System paths
-        Path("/usr/local/lib/libuniversal_timestamp.so"),
-        Path("/usr/lib/libuniversal_timestamp.so"),
+        Path("/usr/local/lib") / name,
+        Path("/usr/lib") / name,
     ]
     
-    # Try LD_LIBRARY_PATH locations
-    ld_path = os.environ.get("LD_LIBRARY_PATH", "")
-    for path_dir in ld_path.split(":"):
+    # Try LD_LIBRARY_PATH / DYLD_LIBRARY_PATH / PATH locations
+    env_var = {"win32": "PATH", "darwin": "DYLD_LIBRARY_PATH"}.get(sys.platform, "LD_LIBRARY_PATH")
+    for path_dir in os.environ.get(env_var, "").split(os.pathsep):
         if path_dir:
-            search_paths.append(Path(path_dir) / "libuniversal_timestamp.so")
+            search_paths.append(Path(path_dir) / name)
     
     # Try ctypes.util.find_library
     lib_path = ctypes.util.find_library("universal_timestamp")
@@ -59,8 +79,8 @@ def _find_library() -> ctypes.CDLL:
                 continue
     
     raise OSError(
-        "Could not find libuniversal_timestamp.so. "
-        "Please ensure the library is installed or set LD_LIBRARY_PATH."
+        f"Could not find {name}. "
+        f"Run 'make shared', install the library, or set {env_var}."
     )
 
 
@@ -78,6 +98,8 @@ def _get_lib() -> ctypes.CDLL:
 
 # --- C Types ---
 
+UT_MAX_STRING_LEN = 32
+
 class _UtTimestamp(Structure):
     """C struct ut_timestamp_t."""
     _fields_ = [("nanos", c_int64)]
@@ -93,6 +115,9 @@ class Error(IntEnum):
     FRACTION_TOO_LONG = 5
     LEAP_SECOND = 6
     NULL_POINTER = 7
+    BUFFER_TOO_SMALL = 8
+    OUT_OF_MEMORY = 9
+    UNAVAILABLE = 10
 
 
 class Precision(IntEnum):
@@ -140,6 +165,19 @@ def _setup_bindings(lib: ctypes.CDLL) -> None:
     lib.ut_format.argtypes = [_UtTimestamp, c_char_p, c_size_t, c_bool]
     lib.ut_format.restype = c_int
     
+    # ut_format_batch
+    lib.ut_format_batch.argtypes = [
+        POINTER(_UtTimestamp), c_size_t, ctypes.c_void_p, c_size_t, c_bool,
+    ]
+    lib.ut_format_batch.restype = c_int
+    
+    # ut_format_batch_packed
+    lib.ut_format_batch_packed.argtypes = [
+        POINTER(_UtTimestamp), c_size_t, ctypes.c_void_p, c_size_t, ctypes.c_char,
+        c_bool, POINTER(c_size_t), POINTER(c_size_t),
+    ]
+    lib.ut_format_batch_packed.restype = c_int
+    
     # ut_parse_strict
     lib.ut_parse_strict.argtypes = [c_char_p, POINTER(_UtTimestamp)]
     lib.ut_parse_strict.restype = c_int
@@ -148,6 +186,26 @@ def _setup_bindings(lib: ctypes.CDLL) -> None:
     lib.ut_parse_lenient.argtypes = [c_char_p, POINTER(_UtTimestamp)]
     lib.ut_parse_lenient.restype = c_int
     
+    # ut_parse_strict_n / ut_parse_lenient_n
+    lib.ut_parse_strict_n.argtypes = [c_char_p, c_size_t, POINTER(_UtTimestamp)]
+    lib.ut_parse_strict_n.restype = c_int
+    lib.ut_parse_lenient_n.argtypes = [c_char_p, c_size_t, POINTER(_UtTimestamp)]
+    lib.ut_parse_lenient_n.restype = c_int
+    
+    # ut_parse_batch
+    lib.ut_parse_batch.argtypes = [
+        POINTER(c_char_p), POINTER(c_size_t), c_size_t,
+        POINTER(_UtTimestamp), POINTER(c_int), c_bool,
+    ]
+    lib.ut_parse_batch.restype = c_int
+    
+    # ut_parse_delimited
+    lib.ut_parse_delimited.argtypes = [
+        c_char_p, c_size_t, ctypes.c_char,
+        POINTER(_UtTimestamp), POINTER(c_int), c_size_t, POINTER(c_size_t), c_bool,
+    ]
+    lib.ut_parse_delimited.restype = c_int
+    
     # ut_from_unix_nanos
     lib.ut_from_unix_nanos.argtypes = [c_int64]
     lib.ut_from_unix_nanos.restype = _UtTimestamp
@@ -190,6 +248,9 @@ def _setup_bindings(lib: ctypes.CDLL) -> None:
     lib.ut_japanese_era_name.argtypes = [c_int]
     lib.ut_japanese_era_name.restype = c_char_p
     
+    lib.ut_register_japanese_era.argtypes = [c_int, c_int, c_int, c_char_p, POINTER(c_int)]
+    lib.ut_register_japanese_era.restype = c_int
+    
     # ISO week
     lib.ut_to_iso_week.argtypes = [_UtTimestamp, POINTER(c_int), POINTER(c_int), POINTER(c_int)]
     lib.ut_to_iso_week.restype = None
@@ -273,8 +334,10 @@ class Timestamp:
         lib = _get_lib()
         ts = _UtTimestamp()
         
-        parse_fn = lib.ut_parse_lenient if lenient else lib.ut_parse_strict
-        err = parse_fn(s.encode("utf-8"), ctypes.byref(ts))
+        # The length-taking parsers see every byte, including an embedded NUL.
+        data = s.encode("utf-8")
+        parse_fn = lib.ut_parse_lenient_n if lenient else lib.ut_parse_strict_n
+        err = parse_fn(data, len(data), ctypes.byref(ts))
         
         if err != Error.OK:
             raise ParseError(Error(err))
@@ -325,12 +388,13 @@ class Timestamp:
         lib.ut_to_iso_week(self._ts, ctypes.byref(year), ctypes.byref(week), ctypes.byref(day))
         return (year.value, week.value, day.value)
     
-    def to_japanese_era(self) -> tuple[JapaneseEra, int, str]:
+    def to_japanese_era(self) -> tuple[Union[JapaneseEra, int], int, str]:
         """
         Get Japanese era representation.
         
         Returns:
-            Tuple of (era, year_in_era, era_name).
+            Tuple of (era, year_in_era, era_name). Eras added with
+            register_japanese_era() are returned as plain ints.
         
         Raises:
             TimestampError: If date is before Meiji era.
@@ -343,7 +407,7 @@ class Timestamp:
         if err != Error.OK:
             raise TimestampError(Error(err))
         
-        era_enum = JapaneseEra(era.value)
+        era_enum = JapaneseEra(era.value) if era.value <= JapaneseEra.MEIJI else era.value
         era_name = lib.ut_japanese_era_name(era.value).decode("utf-8")
         return (era_enum, year.value, era_name)
     
@@ -379,6 +443,184 @@ class Timestamp:
         return hash(self._ts.nanos)
 
 
+# --- Bulk Parsing ---
+
+def parse_batch(
+    items: Sequence[Union[str, bytes]], *, lenient: bool = False
+) -> tuple[list[int], list[Error]]:
+    """
+    Parse many timestamp strings with a single call into the C library.
+    
+    Each item is parsed exactly as Timestamp.parse() parses it; a trailing
+    newline or NUL is part of the item, not a separator.
+    
+    Args:
+        items: Timestamp strings (str or bytes).
+        lenient: If True, use lenient parsing mode.
+    
+    Returns:
+        Tuple of (nanos, errors). Failed entries have nanos 0 and a
+        non-OK error code.
+    """
+    lib = _get_lib()
+    encoded = [s.encode("utf-8") if isinstance(s, str) else bytes(s) for s in items]
+    n = len(encoded)
+    
+    strs = (c_char_p * n)(*encoded)
+    lens = (c_size_t * n)(*(len(item) for item in encoded))
+    out = (_UtTimestamp * n)()
+    errs = (c_int * n)()
+    lib.ut_parse_batch(strs, lens, n, out, errs, not lenient)
+    return [ts.nanos for ts in out], [Error(e) for e in errs]
+
+
+def parse_buffer(
+    data: bytes, delim: bytes = b"\n", *, lenient: bool = False
+) -> tuple[list[int], list[Error]]:
+    """
+    Parse delimiter-separated timestamps from one bytes buffer.
+    
+    A trailing delimiter does not produce an extra record, and CRLF line
+    endings are accepted when delim is a newline.
+    
+    Args:
+        data: Buffer holding the records.
+        delim: Single-byte record separator.
+        lenient: If True, use lenient parsing mode.
+    
+    Returns:
+        Tuple of (nanos, errors), one entry per record.
+    """
+    lib = _get_lib()
+    capacity = data.count(delim) + 1
+    out = (_UtTimestamp * capacity)()
+    errs = (c_int * capacity)()
+    count = c_size_t()
+    lib.ut_parse_delimited(
+        data, len(data), delim, out, errs, capacity, ctypes.byref(count), not lenient
+    )
+    n = count.value
+    return [out[i].nanos for i in range(n)], [Error(errs[i]) for i in range(n)]
+
+
+# --- Bulk Arrays ---
+
+def _timestamp_array(values: Any, *, writable: bool = False) -> ctypes.Array:
+    """
+    View a C-contiguous int64 or datetime64[ns] buffer as ut_timestamp_t[].
+    
+    Writable buffers are shared with the C library; read-only ones are
+    copied once, unless writable is set, in which case they are rejected.
+    """
+    dtype = getattr(values, "dtype", None)
+    if dtype is not None and dtype.kind == "M":
+        if not (dtype.isnative and dtype.str.endswith("M8[ns]")):
+            raise ValueError("datetime64 input must be native datetime64[ns]")
+        values = values.view("i8")
+    
+    view = memoryview(values)
+    fmt = view.format.lstrip("@=")
+    if sys.byteorder == "little":
+        fmt = fmt.lstrip("<")
+    if view.itemsize != 8 or fmt not in ("q", "l"):
+        raise TypeError(f"expected an int64 or datetime64[ns] buffer, got format {view.format!r}")
+    if not view.c_contiguous:
+        raise ValueError("timestamp buffer must be C-contiguous")
+    
+    n = view.nbytes // 8
+    raw = view.cast("B")
+    if not view.readonly:
+        return (_UtTimestamp * n).from_buffer(raw)
+    if writable:
+        raise ValueError("output buffer is read-only")
+    return (_UtTimestamp * n).from_buffer_copy(raw)
+
+
+def format_array(values: Any, include_nanos: bool = True) -> Any:
+    """
+    Format a whole array of Unix-nanosecond timestamps in one C call.
+    
+    Accepts any C-contiguous buffer of int64 (array.array("q"), memoryview,
+    NumPy int64) and NumPy datetime64[ns] arrays, which are read in place
+    without a copy. ctypes releases the GIL for the duration of the call.
+    
+    Args:
+        values: Timestamps as nanoseconds since the Unix epoch.
+        include_nanos: If True, include fractional seconds when non-zero.
+    
+    Returns:
+        A NumPy array of fixed-width bytes (dtype S32) when NumPy is
+        installed, otherwise a list of str.
+    """
+    lib = _get_lib()
+    src = _timestamp_array(values)
+    n = len(src)
+    
+    if _np is not None:
+        out = _np.zeros(n, dtype=f"S{UT_MAX_STRING_LEN}")
+        if n > 0:
+            dst = (ctypes.c_char * out.nbytes).from_buffer(out)
+            err = lib.ut_format_batch(src, n, dst, UT_MAX_STRING_LEN, include_nanos)
+            if err != Error.OK:
+                raise TimestampError(Error(err))
+        return out
+    
+    buf = ctypes.create_string_buffer(max(n * (UT_MAX_STRING_LEN - 1), 1))
+    length = c_size_t()
+    err = lib.ut_format_batch_packed(
+        src, n, buf, len(buf), b"\n", include_nanos, None, ctypes.byref(length)
+    )
+    if err != Error.OK:
+        raise TimestampError(Error(err))
+    text = buf.raw[:length.value].decode("ascii")
+    return text.split("\n")[:-1]
+
+
+def parse_array(
+    items: Sequence[Union[str, bytes]], *, lenient: bool = False, out: Any = None
+) -> tuple[Any, Any]:
+    """
+    Parse many timestamp strings straight into an int64 array.
+    
+    Parses exactly like parse_batch(), with one C call for the whole
+    sequence, but writes the results into a buffer instead of building
+    Python ints. ctypes releases the GIL for the duration of the call.
+    
+    Args:
+        items: Timestamp strings (str or bytes).
+        lenient: If True, use lenient parsing mode.
+        out: Optional writable int64 or datetime64[ns] buffer with one
+            element per item; results are written into it in place.
+    
+    Returns:
+        Tuple of (nanos, errors). nanos is out when given, otherwise a
+        NumPy int64 array (array.array("q") without NumPy); errors holds
+        one Error code per item in a matching int array.
+    """
+    lib = _get_lib()
+    encoded = [s.encode("utf-8") if isinstance(s, str) else bytes(s) for s in items]
+    n = len(encoded)
+    
+    if out is None:
+        out = _np.zeros(n, dtype="i8") if _np is not None else array.array("q", [0]) * n
+    if _np is not None:
+        errors = _np.zeros(n, dtype=_np.intc)
+    else:
+        errors = array.array("i", [0]) * n
+    if n == 0:
+        return out, errors
+    
+    dst = _timestamp_array(out, writable=True)
+    if len(dst) != n:
+        raise ValueError(f"out holds {len(dst)} elements, expected {n}")
+    
+    strs = (c_char_p * n)(*encoded)
+    lens = (c_size_t * n)(*(len(item) for item in encoded))
+    errs = (c_int * n).from_buffer(errors)
+    lib.ut_parse_batch(strs, lens, n, dst, errs, not lenient)
+    return out, errors
+
+
 # --- Calendar Utilities ---
 
 def gregorian_to_thai(year: int) -> int:
@@ -411,6 +653,22 @@ def minguo_to_gregorian(year: int) -> int:
     return _get_lib().ut_minguo_to_gregorian(year)
 
 
+def register_japanese_era(year: int, month: int, day: int, name: str) -> int:
+    """
+    Register a Japanese era starting at 00:00 UTC on the given date.
+    
+    The era must start after the newest known era. Returns its identifier.
+    
+    Raises:
+        TimestampError: If the date or name is rejected or the table is full.
+    """
+    era = c_int()
+    err = _get_lib().ut_register_japanese_era(year, month, day, name.encode("utf-8"), ctypes.byref(era))
+    if err != Error.OK:
+        raise TimestampError(Error(err))
+    return era.value
+
+
 def get_clock_precision() -> Precision:
     """Get the clock precision available on this hardware."""
     return Precision(_get_lib().ut_get_clock_precision())
@@ -429,6 +687,11 @@ __all__ = [
     "Precision",
     "Calendar",
     "JapaneseEra",
+    # Bulk parsing
+    "parse_batch",
+    "parse_buffer",
+    "format_array",
+    "parse_array",
     # Calendar functions
     "gregorian_to_thai",
     "thai_to_gregorian",
@@ -436,5 +699,6 @@ __all__ = [
     "dangi_to_gregorian",
     "gregorian_to_minguo",
     "minguo_to_gregorian",
+    "register_japanese_era",
     "get_clock_precision",
 ]
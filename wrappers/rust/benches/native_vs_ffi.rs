@@ -0,0 +1,41 @@
+//! Compares the native port with the FFI path. Run with
+//! `cargo bench --features native`.
+
+use std::hint::black_box;
+use std::time::Instant;
+
+use universal_timestamp::native::{self, MAX_STRING_LEN};
+use universal_timestamp::Timestamp;
+
+const ITERATIONS: u32 = 2_000_000;
+
+fn report(name: &str, f: impl Fn(u32)) {
+    for i in 0..ITERATIONS / 10 {
+        f(i);
+    }
+    let start = Instant::now();
+    for i in 0..ITERATIONS {
+        f(i);
+    }
+    let ns = start.elapsed().as_nanos() as f64 / ITERATIONS as f64;
+    println!("{:<40} {:>10.2} ns/op {:>14.0} ops/sec", name, ns, 1e9 / ns);
+}
+
+fn main() {
+    let base = 1_734_177_600_123_456_789i64;
+    let text = "2024-12-14T12:00:00.123456789Z";
+
+    report("format/ffi (String)", |i| {
+        black_box(Timestamp::from_nanos(base + i as i64 * 7919).format(true));
+    });
+    report("format/native format_into", |i| {
+        let mut buf = [0u8; MAX_STRING_LEN];
+        black_box(Timestamp::from_nanos(base + i as i64 * 7919).format_into(&mut buf).len());
+    });
+    report("parse/ffi (CString)", |_| {
+        black_box(Timestamp::parse(black_box(text)).unwrap());
+    });
+    report("parse/native", |_| {
+        black_box(native::parse(black_box(text.as_bytes())).unwrap());
+    });
+}
@@ -1,5 +1,9 @@
 fn main() {
+    // Only the ffi feature needs the C library.
+    if std::env::var_os("CARGO_FEATURE_FFI").is_none() {
+        return;
+    }
     // Look for library in dist/ locally for development/testing
     println!("cargo:rustc-link-search=native=../../dist");
-    println!("cargo:rustc-link-lib=universal_timestamp");
+    println!("cargo:rustc-link-lib=static=universal_timestamp");
 }
@@ -0,0 +1,372 @@
+//! Pure Rust port of the C library's ISO-8601 parser and renderer, and of
+//! the binary column codec (`ut_encode_column` / `ut_decode_column`).
+//!
+//! Enabled by the `native` feature. Everything here is `no_std`, takes byte
+//! slices directly and never allocates. Results match the C library exactly;
+//! `tests/test_native.rs` checks both against `test/conformance_vectors.txt`.
+
+use core::fmt;
+
+use crate::Timestamp;
+
+/// Bytes needed by [`format_into`], including the C library's terminator slot.
+pub const MAX_STRING_LEN: usize = 32;
+
+const NANOS_PER_SECOND: i64 = 1_000_000_000;
+const SECONDS_PER_DAY: i64 = 86_400;
+
+const DIGIT_PAIRS: &[u8; 200] = b"0001020304050607080910111213141516171819\
+2021222324252627282930313233343536373839\
+4041424344454647484950515253545556575859\
+6061626364656667686970717273747576777879\
+8081828384858687888990919293949596979899";
+
+const FRACTION_SCALE: [i64; 9] = [100_000_000, 10_000_000, 1_000_000, 100_000, 10_000, 1_000, 100, 10, 1];
+
+/// Why a string was rejected; the discriminants match `ut_error_t`.
+#[derive(Debug, Copy, Clone, PartialEq, Eq, Hash)]
+#[repr(i32)]
+pub enum ParseError {
+    InvalidFormat = 1,
+    InvalidDate = 2,
+    OutOfRange = 3,
+    UnsupportedOffset = 4,
+    FractionTooLong = 5,
+}
+
+impl ParseError {
+    /// The matching `ut_error_t` value.
+    #[inline]
+    pub const fn code(self) -> i32 {
+        self as i32
+    }
+
+    /// The text `ut_error_string` returns for this error.
+    pub const fn message(self) -> &'static str {
+        match self {
+            ParseError::InvalidFormat => "Invalid format",
+            ParseError::InvalidDate => "Invalid date",
+            ParseError::OutOfRange => "Value out of range",
+            ParseError::UnsupportedOffset => "Unsupported timezone offset",
+            ParseError::FractionTooLong => "Fractional seconds too long",
+        }
+    }
+}
+
+impl fmt::Display for ParseError {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.write_str(self.message())
+    }
+}
+
+#[cfg(feature = "std")]
+impl std::error::Error for ParseError {}
+
+#[inline]
+const fn is_leap_year(year: i32) -> bool {
+    (year % 4 == 0 && year % 100 != 0) || year % 400 == 0
+}
+
+#[inline]
+const fn days_in_month(year: i32, month: i32) -> i32 {
+    match month {
+        2 if is_leap_year(year) => 29,
+        2 => 28,
+        4 | 6 | 9 | 11 => 30,
+        _ => 31,
+    }
+}
+
+#[inline]
+const fn validate_date(year: i32, month: i32, day: i32) -> bool {
+    year >= 0 && year <= 9999 && month >= 1 && month <= 12 && day >= 1 && day <= days_in_month(year, month)
+}
+
+/// Mirrors `ut_internal_days_from_civil`.
+#[inline]
+const fn days_from_civil(year: i32, month: i32, day: i32) -> i64 {
+    let y = year as i64 - (month <= 2) as i64;
+    let era = (if y >= 0 { y } else { y - 399 }) / 400;
+    let yoe = y - era * 400;
+    let mp = ((month + 9) % 12) as i64;
+    let doy = (153 * mp + 2) / 5 + day as i64 - 1;
+    let doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    era * 146_097 + doe - 719_468
+}
+
+/// Mirrors `ut_internal_civil_from_days`; the day-of-era terms are unsigned.
+#[inline]
+const fn civil_from_days(days: i64) -> (i32, u32, u32) {
+    let z = days + 719_468;
+    let era = (if z >= 0 { z } else { z - 146_096 }) / 146_097;
+    let doe = (z - era * 146_097) as u32;
+    let yoe = (doe - doe / 1460 + doe / 36_524 - doe / 146_096) / 365;
+    let doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    let mp = (5 * doy + 2) / 153;
+    let m = if mp < 10 { mp + 3 } else { mp - 9 };
+    let y = yoe as i64 + era * 400 + (m <= 2) as i64;
+    (y as i32, m, doy - (153 * mp + 2) / 5 + 1)
+}
+
+/// Value of `n` ASCII digits at `s[i..]`, or -1.
+#[inline]
+fn digits(s: &[u8], i: usize, n: usize) -> i32 {
+    let mut v = 0i32;
+    for &c in &s[i..i + n] {
+        if !c.is_ascii_digit() {
+            return -1;
+        }
+        v = v * 10 + (c - b'0') as i32;
+    }
+    v
+}
+
+/// Mirrors `ut_internal_parse_scalar`.
+#[inline]
+fn parse_with(s: &[u8], strict: bool) -> Result<Timestamp, ParseError> {
+    use ParseError::*;
+
+    if s.len() < 19 {
+        return Err(InvalidFormat);
+    }
+    if s[4] != b'-' || s[7] != b'-' || s[10] != b'T' || s[13] != b':' || s[16] != b':' {
+        return Err(InvalidFormat);
+    }
+
+    let year = digits(s, 0, 4);
+    let month = digits(s, 5, 2);
+    let day = digits(s, 8, 2);
+    let hour = digits(s, 11, 2);
+    let minute = digits(s, 14, 2);
+    let second = digits(s, 17, 2);
+    if year < 0 || month < 0 || day < 0 || hour < 0 || minute < 0 || second < 0 {
+        return Err(InvalidFormat);
+    }
+    if hour > 23 || minute > 59 || second > 59 {
+        return Err(OutOfRange);
+    }
+    if !validate_date(year, month, day) {
+        return Err(InvalidDate);
+    }
+
+    let mut frac = 0i64;
+    let mut pos = 19;
+    if pos < s.len() && s[pos] == b'.' {
+        pos += 1;
+        let start = pos;
+        while pos < s.len() && s[pos].is_ascii_digit() {
+            pos += 1;
+        }
+        let mut n = pos - start;
+        if n == 0 {
+            return Err(InvalidFormat);
+        }
+        if n > 9 {
+            if strict {
+                return Err(FractionTooLong);
+            }
+            n = 9;
+        }
+        frac = digits(s, start, n) as i64 * FRACTION_SCALE[n - 1];
+    }
+
+    match s.get(pos) {
+        Some(b'Z') => pos += 1,
+        Some(b'z') if !strict => pos += 1,
+        Some(b'+') | Some(b'-') => {
+            if s.len() - pos < 6 || s[pos + 3] != b':' {
+                return Err(InvalidFormat);
+            }
+            let off_hour = digits(s, pos + 1, 2);
+            let off_minute = digits(s, pos + 4, 2);
+            if off_hour < 0 || off_minute < 0 {
+                return Err(InvalidFormat);
+            }
+            if off_hour != 0 || off_minute != 0 || strict {
+                return Err(UnsupportedOffset);
+            }
+            pos += 6;
+        }
+        _ if strict => return Err(InvalidFormat),
+        _ => {}
+    }
+    if pos != s.len() {
+        return Err(InvalidFormat);
+    }
+
+    let seconds = days_from_civil(year, month, day) * SECONDS_PER_DAY
+        + hour as i64 * 3600
+        + minute as i64 * 60
+        + second as i64;
+    Ok(Timestamp::from_nanos(seconds.wrapping_mul(NANOS_PER_SECOND).wrapping_add(frac)))
+}
+
+/// Parse an ISO-8601 timestamp with the strict rules of `ut_parse_strict`.
+#[inline]
+pub fn parse(s: &[u8]) -> Result<Timestamp, ParseError> {
+    parse_with(s, true)
+}
+
+/// Parse an ISO-8601 timestamp with the lenient rules of `ut_parse_lenient`.
+#[inline]
+pub fn parse_lenient(s: &[u8]) -> Result<Timestamp, ParseError> {
+    parse_with(s, false)
+}
+
+#[inline]
+fn put2(buf: &mut [u8], i: usize, v: u32) {
+    let p = v as usize * 2;
+    buf[i] = DIGIT_PAIRS[p];
+    buf[i + 1] = DIGIT_PAIRS[p + 1];
+}
+
+/// Render `ts` into `buf` exactly as `ut_format` does and return the text.
+#[inline]
+pub fn format_into(ts: Timestamp, buf: &mut [u8; MAX_STRING_LEN], include_nanos: bool) -> &str {
+    let nanos = ts.as_nanos();
+    let secs = nanos.div_euclid(NANOS_PER_SECOND);
+    let frac = nanos.rem_euclid(NANOS_PER_SECOND) as u32;
+    let days = secs.div_euclid(SECONDS_PER_DAY);
+    let sod = secs.rem_euclid(SECONDS_PER_DAY) as u32;
+    let (year, month, day) = civil_from_days(days);
+    let year = year as u32;
+
+    put2(buf, 0, year / 100);
+    put2(buf, 2, year % 100);
+    buf[4] = b'-';
+    put2(buf, 5, month);
+    buf[7] = b'-';
+    put2(buf, 8, day);
+    buf[10] = b'T';
+    put2(buf, 11, sod / 3600);
+    buf[13] = b':';
+    put2(buf, 14, sod % 3600 / 60);
+    buf[16] = b':';
+    put2(buf, 17, sod % 60);
+    let mut len = 19;
+
+    if include_nanos && frac > 0 {
+        let mut v = frac;
+        let mut n = 9;
+        while v % 10 == 0 {
+            v /= 10;
+            n -= 1;
+        }
+        buf[len] = b'.';
+        let start = len + 1;
+        let mut i = start + n;
+        len = i;
+        while i - start >= 2 {
+            i -= 2;
+            put2(buf, i, v % 100);
+            v /= 100;
+        }
+        if i > start {
+            buf[start] = b'0' + v as u8;
+        }
+    }
+    buf[len] = b'Z';
+
+    // SAFETY: every byte written above is ASCII.
+    unsafe { core::str::from_utf8_unchecked(&buf[..len + 1]) }
+}
+
+impl Timestamp {
+    /// Render as ISO-8601 with nanoseconds into `buf`, without allocating.
+    #[inline]
+    pub fn format_into<'a>(&self, buf: &'a mut [u8; MAX_STRING_LEN]) -> &'a str {
+        format_into(*self, buf, true)
+    }
+
+    /// Parse ISO-8601 bytes (strict) without copying or allocating.
+    #[inline]
+    pub fn parse_bytes(s: &[u8]) -> Result<Self, ParseError> {
+        parse(s)
+    }
+}
+
+impl fmt::Display for Timestamp {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        let mut buf = [0u8; MAX_STRING_LEN];
+        f.write_str(self.format_into(&mut buf))
+    }
+}
+
+/// Version written to, and accepted from, the binary column header.
+pub const COLUMN_VERSION: u8 = 1;
+
+/// Bytes in the binary column header.
+pub const COLUMN_HEADER_LEN: usize = 4;
+
+/// Worst-case encoded size of a column of `n` timestamps.
+pub const fn column_max_encoded_len(n: usize) -> usize {
+    COLUMN_HEADER_LEN + n * 10
+}
+
+/// Encode `ts` as a binary column into `out`, as `ut_encode_column` does.
+///
+/// Returns the number of bytes written, or `None` if `out` is too small.
+pub fn encode_column_into(ts: &[Timestamp], out: &mut [u8]) -> Option<usize> {
+    let mut pos = COLUMN_HEADER_LEN;
+    out.get_mut(..pos)?.copy_from_slice(&[b'U', b'T', COLUMN_VERSION, 0]);
+
+    let mut prev = 0u64;
+    for t in ts {
+        let value = t.as_nanos() as u64;
+        let d = value.wrapping_sub(prev);
+        let mut u = (d << 1) ^ 0u64.wrapping_sub(d >> 63);
+        while u >= 0x80 {
+            *out.get_mut(pos)? = u as u8 | 0x80;
+            pos += 1;
+            u >>= 7;
+        }
+        *out.get_mut(pos)? = u as u8;
+        pos += 1;
+        prev = value;
+    }
+    Some(pos)
+}
+
+/// Iterator over the timestamps of a binary column; see [`decode_column`].
+#[derive(Debug, Clone)]
+pub struct ColumnIter<'a> {
+    rest: &'a [u8],
+    prev: u64,
+}
+
+impl Iterator for ColumnIter<'_> {
+    type Item = Result<Timestamp, ParseError>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        if self.rest.is_empty() {
+            return None;
+        }
+        let mut u = 0u64;
+        let mut shift = 0u32;
+        for (i, &c) in self.rest.iter().enumerate() {
+            if shift > 63 || (shift == 63 && c > 1) {
+                break;
+            }
+            u |= u64::from(c & 0x7f) << shift;
+            if c < 0x80 {
+                self.rest = &self.rest[i + 1..];
+                self.prev = self.prev.wrapping_add((u >> 1) ^ 0u64.wrapping_sub(u & 1));
+                return Some(Ok(Timestamp::from_nanos(self.prev as i64)));
+            }
+            shift += 7;
+        }
+        self.rest = &[];
+        Some(Err(ParseError::InvalidFormat))
+    }
+}
+
+/// Decode a column written by `ut_encode_column` or [`encode_column_into`].
+///
+/// Checks the header and returns an iterator that yields each timestamp,
+/// then an `InvalidFormat` error if the data ends inside a malformed value.
+pub fn decode_column(b: &[u8]) -> Result<ColumnIter<'_>, ParseError> {
+    match b {
+        [b'U', b'T', COLUMN_VERSION, 0, rest @ ..] => Ok(ColumnIter { rest, prev: 0 }),
+        _ => Err(ParseError::InvalidFormat),
+    }
+}
@@ -0,0 +1,124 @@
+use universal_timestamp::native::{self, ParseError, MAX_STRING_LEN};
+use universal_timestamp::Timestamp;
+
+const VECTORS: &str = include_str!("../../../test/conformance_vectors.txt");
+
+fn vector_error(name: &str) -> Option<ParseError> {
+    match name {
+        "INVALID_FORMAT" => Some(ParseError::InvalidFormat),
+        "INVALID_DATE" => Some(ParseError::InvalidDate),
+        "OUT_OF_RANGE" => Some(ParseError::OutOfRange),
+        "UNSUPPORTED_OFFSET" => Some(ParseError::UnsupportedOffset),
+        "FRACTION_TOO_LONG" => Some(ParseError::FractionTooLong),
+        _ => None,
+    }
+}
+
+fn vector_nanos(list: &str) -> Vec<Timestamp> {
+    if list == "-" {
+        return Vec::new();
+    }
+    list.split(',').map(|v| Timestamp::from_nanos(v.parse().unwrap())).collect()
+}
+
+fn hex(bytes: &[u8]) -> String {
+    bytes.iter().map(|b| format!("{:02x}", b)).collect()
+}
+
+fn unhex(s: &str) -> Vec<u8> {
+    (0..s.len()).step_by(2).map(|i| u8::from_str_radix(&s[i..i + 2], 16).unwrap()).collect()
+}
+
+fn decode(bytes: &[u8]) -> Result<Vec<Timestamp>, ParseError> {
+    native::decode_column(bytes)?.collect()
+}
+
+#[test]
+fn test_conformance_vectors() {
+    let mut cases = 0;
+    for line in VECTORS.lines().filter(|l| !l.is_empty() && !l.starts_with('#')) {
+        let mut fields = line.splitn(3, '\t');
+        let (op, input, expected) = (fields.next().unwrap(), fields.next().unwrap(), fields.next().unwrap());
+        cases += 1;
+
+        match op {
+            "strict" | "lenient" => {
+                let got = if op == "strict" {
+                    native::parse(input.as_bytes())
+                } else {
+                    native::parse_lenient(input.as_bytes())
+                };
+                match vector_error(expected) {
+                    Some(err) => assert_eq!(got, Err(err), "{} {:?}", op, input),
+                    None => assert_eq!(got.map(|t| t.as_nanos()), Ok(expected.parse().unwrap()), "{} {:?}", op, input),
+                }
+            }
+            "format" | "format_short" => {
+                let mut buf = [0u8; MAX_STRING_LEN];
+                let ts = Timestamp::from_nanos(input.parse().unwrap());
+                assert_eq!(native::format_into(ts, &mut buf, op == "format"), expected, "{} {}", op, input);
+            }
+            "column" => {
+                let values = vector_nanos(input);
+                let mut buf = [0u8; 256];
+                let len = native::encode_column_into(&values, &mut buf).unwrap();
+                assert_eq!(hex(&buf[..len]), expected, "column {}", input);
+                assert_eq!(decode(&unhex(expected)), Ok(values), "column {}", input);
+            }
+            "column_decode" => match vector_error(expected) {
+                Some(err) => assert_eq!(decode(&unhex(input)), Err(err), "column_decode {}", input),
+                None => assert_eq!(decode(&unhex(input)), Ok(vector_nanos(expected)), "column_decode {}", input),
+            },
+            _ => panic!("unknown vector op {:?}", op),
+        }
+    }
+    assert!(cases > 0);
+}
+
+#[test]
+fn test_column_too_small() {
+    let values = [Timestamp::from_nanos(1_734_177_600_000_000_000)];
+    let mut buf = [0u8; native::column_max_encoded_len(1)];
+    let len = native::encode_column_into(&values, &mut buf).unwrap();
+    assert_eq!(native::encode_column_into(&values, &mut buf[..len - 1]), None);
+    assert_eq!(native::encode_column_into(&[], &mut buf[..3]), None);
+}
+
+#[test]
+fn test_format_into_method() {
+    let mut buf = [0u8; MAX_STRING_LEN];
+    let ts = Timestamp::parse_bytes(b"2024-12-14T12:00:00.5Z").unwrap();
+    assert_eq!(ts.format_into(&mut buf), "2024-12-14T12:00:00.5Z");
+    assert_eq!(ts.to_string(), "2024-12-14T12:00:00.5Z");
+    assert_eq!(ParseError::InvalidDate.to_string(), "Invalid date");
+}
+
+/// Cross-checks the port against the C library on pseudo-random values.
+#[cfg(feature = "ffi")]
+#[test]
+fn test_native_matches_ffi() {
+    let mut state = 0x9E37_79B9_7F4A_7C15u64;
+    let mut next = || {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        state
+    };
+
+    for _ in 0..20_000 {
+        let ts = Timestamp::from_nanos(next() as i64);
+        let mut buf = [0u8; MAX_STRING_LEN];
+        let text = ts.format(true);
+        assert_eq!(ts.format_into(&mut buf), text);
+        assert_eq!(native::format_into(ts, &mut buf, false), ts.format(false));
+
+        let mut bytes = text.into_bytes();
+        if next() % 2 == 0 {
+            let i = (next() % bytes.len() as u64) as usize;
+            bytes[i] = b"0123456789-:TZz.+ "[(next() % 18) as usize];
+        }
+        let s = std::str::from_utf8(&bytes).unwrap();
+        assert_eq!(native::parse(&bytes).ok(), Timestamp::parse(s).ok(), "{:?}", s);
+        assert_eq!(native::parse_lenient(&bytes).ok(), Timestamp::parse_lenient(s).ok(), "{:?}", s);
+    }
+}
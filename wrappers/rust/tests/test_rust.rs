@@ -21,8 +21,37 @@ fn test_integration_monotonic() {
     assert!(t2 > t1);
 }
 
+#[test]
+fn test_integration_monotonic_batch() {
+    let before = Timestamp::now_monotonic();
+    let ids = Timestamp::now_monotonic_batch(1000);
+    assert_eq!(ids.len(), 1000);
+    assert!(ids[0] > before);
+    assert!(ids.windows(2).all(|w| w[1].as_nanos() == w[0].as_nanos() + 1));
+    assert!(Timestamp::now_monotonic() > ids[999]);
+    assert!(Timestamp::now_monotonic_batch(0).is_empty());
+}
+
 #[test]
 fn test_calendar() {
     let thai_year = universal_timestamp::calendar::gregorian_to_thai(2024);
     assert_eq!(thai_year, 2567);
 }
+
+#[test]
+fn test_parse_batch() {
+    let results = Timestamp::parse_batch(&["2024-12-14T12:00:00Z", "nope", "2024-12-14T12:00:00.5Z"], true);
+    assert_eq!(results.len(), 3);
+    assert_eq!(results[0].as_ref().unwrap().format(false), "2024-12-14T12:00:00Z");
+    assert!(results[1].is_err());
+    assert_eq!(results[2].as_ref().unwrap().as_nanos() % 1_000_000_000, 500_000_000);
+}
+
+#[test]
+fn test_parse_buffer() {
+    let results = Timestamp::parse_buffer(b"2024-12-14T12:00:00Z\n2024-12-14T12:00:01Z\n", b'\n', true);
+    assert_eq!(results.len(), 2);
+    let a = results[0].as_ref().unwrap().as_nanos();
+    let b = results[1].as_ref().unwrap().as_nanos();
+    assert_eq!(b - a, 1_000_000_000);
+}